@@ -219,6 +219,18 @@
       ]
     },
 
+# PERF-URITEMPLATE
+    {
+      'target_name': 'perf-uritemplate',
+      'type': 'executable',
+      'sources': [
+        'ext/snowcrash/test/performance/perf-uritemplate.cc'
+      ],
+      'dependencies': [
+        'libsnowcrash',
+      ]
+    },
+
 # LIBSOS
     {
       'target_name': 'libsos',
@@ -277,6 +289,12 @@
         "src/RefractElementFactory.cc",
         "src/ConversionContext.cc",
         "src/ConversionContext.h",
+        "src/WorkerPool.cc",
+        "src/WorkerPool.h",
+        "src/IncrementalParser.cc",
+        "src/IncrementalParser.h",
+        "src/RefractDiff.cc",
+        "src/RefractDiff.h",
 
         # librefract parts - will be separated into other project
         "src/refract/Element.h",
@@ -317,6 +335,16 @@
         "src/refract/Query.h",
         "src/refract/Query.cc",
         "src/refract/Iterate.h",
+        "src/refract/StructuralHash.h",
+        "src/refract/StructuralHash.cc",
+        "src/refract/PathQuery.h",
+        "src/refract/PathQuery.cc",
+        "src/refract/ElementName.h",
+        "src/refract/ElementName.cc",
+        "src/refract/Allocator.h",
+        "src/refract/Allocator.cc",
+        "src/refract/Budget.h",
+        "src/refract/Budget.cc",
       ],
       "dependencies": [
         "libsos",
@@ -348,6 +376,15 @@
         "test/test-OneOfTest.cc",
         "test/test-SyntaxIssuesTest.cc",
         "test/test-ElementDataTest.cc",
+        "test/test-WorkerPoolTest.cc",
+        "test/test-StructuralHashTest.cc",
+        "test/test-RefractDiffTest.cc",
+        "test/test-PathQueryTest.cc",
+        "test/test-IncrementalParserTest.cc",
+        "test/test-ElementNameTest.cc",
+        "test/test-RegistryTest.cc",
+        "test/test-AllocatorTest.cc",
+        "test/test-BudgetTest.cc",
       ],
       'dependencies': [
         "libdrafter",
@@ -370,6 +407,14 @@
         "src/config.h",
         "src/reporting.cc",
         "src/reporting.h",
+        "src/ResultCache.cc",
+        "src/ResultCache.h",
+        "src/Processor.cc",
+        "src/Processor.h",
+        "src/Server.cc",
+        "src/Server.h",
+        "src/Batch.cc",
+        "src/Batch.h",
       ],
       "include_dirs": [
         "ext/cmdline",
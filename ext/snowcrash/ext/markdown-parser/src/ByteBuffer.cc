@@ -8,6 +8,8 @@
 
 #include "ByteBuffer.h"
 
+#include <algorithm>
+
 using namespace mdp;
 
 /* Byte lenght of an UTF8 character (based on first byte) */
@@ -133,28 +135,130 @@ CharactersRangeSet mdp::BytesRangeSetToCharactersRangeSet(
     return characterMap;
 }
 
+/* Range clamped to the byte buffer as in BytesRangeToCharactersRange() */
+static BytesRange ClampBytesRange(const BytesRange& bytesRange, size_t size)
+{
+    BytesRange workRange = bytesRange;
+    if (bytesRange.location + bytesRange.length > size) {
+        workRange.length -= bytesRange.location + bytesRange.length - size;
+    }
+
+    return workRange;
+}
+
+/* Character position of a byte offset, `offsets` are sorted and `characters` are their positions */
+static size_t CharacterAt(size_t offset, const std::vector<size_t>& offsets, const std::vector<size_t>& characters)
+{
+    return characters[std::lower_bound(offsets.begin(), offsets.end(), offset) - offsets.begin()];
+}
+
+std::vector<CharactersRangeSet> mdp::BytesRangeSetsToCharactersRangeSets(
+    const std::vector<const BytesRangeSet*>& rangeSets, const ByteBuffer& byteBuffer)
+{
+    const size_t size = byteBuffer.length();
+
+    // byte offsets the character index would be looked up at
+    std::vector<size_t> offsets;
+
+    for (std::vector<const BytesRangeSet*>::const_iterator set = rangeSets.begin(); set != rangeSets.end(); ++set) {
+        for (BytesRangeSet::const_iterator it = (*set)->begin(); it != (*set)->end() && size; ++it) {
+            BytesRange workRange = ClampBytesRange(*it, size);
+
+            if (workRange.location > 0)
+                offsets.push_back(workRange.location);
+
+            if (workRange.length > 0)
+                offsets.push_back(std::min(workRange.location + workRange.length, size - 1));
+        }
+    }
+
+    std::sort(offsets.begin(), offsets.end());
+    offsets.erase(std::unique(offsets.begin(), offsets.end()), offsets.end());
+
+    // walk the buffer as BuildCharacterIndex() does, stopping at the last offset
+    std::vector<size_t> characters(offsets.size(), 0);
+    const char* source = byteBuffer.c_str();
+    size_t pos = 0;
+    size_t charPos = 0;
+    size_t i = 0;
+
+    while (i < offsets.size() && pos < size && source[pos]) {
+        pos += UTF8_CHAR_LEN(source[pos]);
+
+        for (; i < offsets.size() && offsets[i] < pos; ++i)
+            characters[i] = charPos;
+
+        charPos++;
+    }
+
+    // offsets past the end of the buffer are the end of the last character
+    for (; i < offsets.size() && offsets[i] >= size; ++i)
+        characters[i] = charPos;
+
+    std::vector<CharactersRangeSet> characterMaps(rangeSets.size());
+
+    for (size_t set = 0; set < rangeSets.size(); ++set) {
+        for (BytesRangeSet::const_iterator it = rangeSets[set]->begin(); it != rangeSets[set]->end(); ++it) {
+            if (!size) {
+                characterMaps[set].push_back(CharactersRange());
+                continue;
+            }
+
+            BytesRange workRange = ClampBytesRange(*it, size);
+
+            size_t charLocation = 0;
+            if (workRange.location > 0)
+                charLocation = CharacterAt(workRange.location, offsets, characters);
+
+            size_t charLength = 0;
+            if (workRange.length > 0) {
+                size_t end = workRange.location + workRange.length;
+                if (end >= size) {
+                    // the same as with the index, compatible with strlen_utf8()
+                    charLength = CharacterAt(size - 1, offsets, characters);
+                    charLength -= charLocation - 1;
+                } else {
+                    charLength = CharacterAt(end, offsets, characters);
+                    charLength -= charLocation;
+                }
+            }
+
+            characterMaps[set].push_back(CharactersRange(charLocation, charLength));
+        }
+    }
+
+    return characterMaps;
+}
+
 ByteBuffer mdp::MapBytesRangeSet(const BytesRangeSet& rangeSet, const ByteBuffer& byteBuffer)
+{
+    ByteBuffer mapped;
+    AppendBytesRangeSet(rangeSet, byteBuffer, mapped);
+    return mapped;
+}
+
+void mdp::AppendBytesRangeSet(const BytesRangeSet& rangeSet, const ByteBuffer& byteBuffer, ByteBuffer& out)
 {
     if (byteBuffer.empty())
-        return ByteBuffer();
+        return;
 
+    const size_t begin = out.length();
     size_t length = byteBuffer.length();
-    ByteBufferStream s;
+
     for (BytesRangeSet::const_iterator it = rangeSet.begin(); it != rangeSet.end(); ++it) {
 
         if (it->location + it->length > length) {
             // Sundown adds an extra newline on the source input if needed.
             if (it->location + it->length - length == 1) {
-                s << byteBuffer.substr(it->location, length - it->location);
-                return s.str();
+                out.append(byteBuffer, it->location, length - it->location);
             } else {
                 // Wrong map
-                return ByteBuffer();
+                out.erase(begin);
             }
+
+            return;
         }
 
-        s << byteBuffer.substr(it->location, it->length);
+        out.append(byteBuffer, it->location, it->length);
     }
-
-    return s.str();
 }
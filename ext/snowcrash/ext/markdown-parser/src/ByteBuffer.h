@@ -81,8 +81,21 @@ namespace mdp
     CharactersRangeSet BytesRangeSetToCharactersRangeSet(
         const BytesRangeSet& rangeSet, const ByteBufferCharacterIndex& index);
 
+    /**
+     *  \brief Convert ranges of bytes of many range sets to ranges of characters
+     *
+     *  The same as BytesRangeSetToCharactersRangeSet() with a character
+     *  index, by a single pass over the byte buffer without building the index.
+     *  Character ranges are returned in the order of the byte range sets.
+     */
+    std::vector<CharactersRangeSet> BytesRangeSetsToCharactersRangeSets(
+        const std::vector<const BytesRangeSet*>& rangeSets, const ByteBuffer& byteBuffer);
+
     /** Maps bytes range set to byte buffer */
     ByteBuffer MapBytesRangeSet(const BytesRangeSet& rangeSet, const ByteBuffer& byteBuffer);
+
+    /** Appends bytes of a range set of byte buffer to `out`, the same as MapBytesRangeSet() without a copy */
+    void AppendBytesRangeSet(const BytesRangeSet& rangeSet, const ByteBuffer& byteBuffer, ByteBuffer& out);
 }
 
 #endif
@@ -21,17 +21,39 @@ const int MarkdownParser::ParserExtensions
 #define WORKING_NODE_MISMATCH_ERR std::logic_error("working node mismatch")
 
 /**
- *  \brief  Create a byte buffer from a sundown buffer
+ *  \brief  Assign a sundown buffer to a byte buffer
  */
-static ByteBuffer ByteBufferFromSundown(const struct buf* text)
+static void AssignSundown(ByteBuffer& buffer, const struct buf* text)
 {
-    if (!text || !text->data || !text->size)
-        return ByteBuffer();
+    if (!text || !text->data || !text->size) {
+        buffer.clear();
+        return;
+    }
+
+    buffer.assign(reinterpret_cast<const char*>(text->data), text->size);
+}
 
-    return ByteBuffer(reinterpret_cast<char*>(text->data), text->size);
+MarkdownParser::MarkdownParser()
+    : m_workingNode(NULL), m_listBlockContext(false), m_source(NULL), m_sourceLength(0), m_sundown(NULL), m_output(NULL)
+{
 }
 
-MarkdownParser::MarkdownParser() : m_workingNode(NULL), m_listBlockContext(false), m_source(NULL), m_sourceLength(0) {}
+MarkdownParser::~MarkdownParser()
+{
+    release();
+}
+
+void MarkdownParser::release()
+{
+    if (m_output)
+        ::bufrelease(m_output);
+
+    if (m_sundown)
+        ::sd_markdown_free(m_sundown);
+
+    m_output = NULL;
+    m_sundown = NULL;
+}
 
 void MarkdownParser::parse(const ByteBuffer& source, MarkdownNode& ast)
 {
@@ -43,15 +65,28 @@ void MarkdownParser::parse(const ByteBuffer& source, MarkdownNode& ast)
     m_sourceLength = source.length();
     m_listBlockContext = false;
 
-    RenderCallbacks callbacks = renderCallbacks();
+    if (!m_sundown) {
+        RenderCallbacks callbacks = renderCallbacks();
+
+        m_sundown = ::sd_markdown_new(ParserExtensions, MaxNesting, &callbacks, renderCallbackData());
+        m_output = ::bufnew(OutputUnitSize);
+    }
 
-    ::sd_markdown* sundown = ::sd_markdown_new(ParserExtensions, MaxNesting, &callbacks, renderCallbackData());
-    ::buf* output = ::bufnew(OutputUnitSize);
+    // Nothing is rendered to the output, it is only reset
+    m_output->size = 0;
 
-    ::sd_markdown_render(output, reinterpret_cast<const uint8_t*>(source.c_str()), source.length(), sundown);
+    try {
+        ::sd_markdown_render(m_output, reinterpret_cast<const uint8_t*>(source.c_str()), source.length(), m_sundown);
+    } catch (...) {
+        // Sundown has not finished the render, its state can not be reused
+        release();
 
-    ::bufrelease(output);
-    ::sd_markdown_free(sundown);
+        m_workingNode = NULL;
+        m_source = NULL;
+        m_sourceLength = 0;
+        m_listBlockContext = false;
+        throw;
+    }
 
     m_workingNode = NULL;
     m_source = NULL;
@@ -101,16 +136,12 @@ void MarkdownParser::renderHeader(struct buf* ob, const struct buf* text, int le
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderHeader(ByteBufferFromSundown(text), level);
+    p->renderHeader(text, level);
 }
 
-void MarkdownParser::renderHeader(const ByteBuffer& text, int level)
+void MarkdownParser::renderHeader(const struct buf* text, int level)
 {
-    if (!m_workingNode)
-        throw NO_WORKING_NODE_ERR;
-
-    MarkdownNode node(HeaderMarkdownNodeType, m_workingNode, text, level);
-    m_workingNode->children().push_back(node);
+    appendNode(HeaderMarkdownNodeType, text, level);
 }
 
 void MarkdownParser::beginList(int flags, void* opaque)
@@ -134,10 +165,10 @@ void MarkdownParser::renderList(struct buf* ob, const struct buf* text, int flag
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderList(ByteBufferFromSundown(text), flags);
+    p->renderList(text, flags);
 }
 
-void MarkdownParser::renderList(const ByteBuffer& text, int flags)
+void MarkdownParser::renderList(const struct buf* text, int flags)
 {
     m_listBlockContext = true;
 }
@@ -156,11 +187,8 @@ void MarkdownParser::beginListItem(int flags)
     if (!m_workingNode)
         throw NO_WORKING_NODE_ERR;
 
-    MarkdownNode node(ListItemMarkdownNodeType, m_workingNode, ByteBuffer(), flags);
-    m_workingNode->children().push_back(node);
-
     // Push context
-    m_workingNode = &m_workingNode->children().back();
+    m_workingNode = &appendNode(ListItemMarkdownNodeType, NULL, flags);
 }
 
 void MarkdownParser::renderListItem(struct buf* ob, const struct buf* text, int flags, void* opaque)
@@ -169,10 +197,10 @@ void MarkdownParser::renderListItem(struct buf* ob, const struct buf* text, int
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderListItem(ByteBufferFromSundown(text), flags);
+    p->renderListItem(text, flags);
 }
 
-void MarkdownParser::renderListItem(const ByteBuffer& text, int flags)
+void MarkdownParser::renderListItem(const struct buf* text, int flags)
 {
     if (!m_workingNode)
         throw NO_WORKING_NODE_ERR;
@@ -184,8 +212,8 @@ void MarkdownParser::renderListItem(const ByteBuffer& text, int flags)
     // Instead of storing the text on the list item
     // create the artificial paragraph node to store the text.
     if (m_workingNode->children().empty() || m_workingNode->children().front().type != ParagraphMarkdownNodeType) {
-        MarkdownNode textNode(ParagraphMarkdownNodeType, m_workingNode, text);
-        m_workingNode->children().push_front(textNode);
+        m_workingNode->children().emplace_front(ParagraphMarkdownNodeType, m_workingNode);
+        AssignSundown(m_workingNode->children().front().text, text);
     }
 
     m_workingNode->data = flags;
@@ -200,16 +228,12 @@ void MarkdownParser::renderBlockCode(struct buf* ob, const struct buf* text, con
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderBlockCode(ByteBufferFromSundown(text), ByteBufferFromSundown(lang));
+    p->renderBlockCode(text, lang);
 }
 
-void MarkdownParser::renderBlockCode(const ByteBuffer& text, const ByteBuffer& language)
+void MarkdownParser::renderBlockCode(const struct buf* text, const struct buf* language)
 {
-    if (!m_workingNode)
-        throw NO_WORKING_NODE_ERR;
-
-    MarkdownNode node(CodeMarkdownNodeType, m_workingNode, text);
-    m_workingNode->children().push_back(node);
+    appendNode(CodeMarkdownNodeType, text);
 }
 
 void MarkdownParser::renderParagraph(struct buf* ob, const struct buf* text, void* opaque)
@@ -218,16 +242,12 @@ void MarkdownParser::renderParagraph(struct buf* ob, const struct buf* text, voi
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderParagraph(ByteBufferFromSundown(text));
+    p->renderParagraph(text);
 }
 
-void MarkdownParser::renderParagraph(const ByteBuffer& text)
+void MarkdownParser::renderParagraph(const struct buf* text)
 {
-    if (!m_workingNode)
-        throw NO_WORKING_NODE_ERR;
-
-    MarkdownNode node(ParagraphMarkdownNodeType, m_workingNode, text);
-    m_workingNode->children().push_back(node);
+    appendNode(ParagraphMarkdownNodeType, text);
 }
 
 void MarkdownParser::renderHorizontalRule(struct buf* ob, void* opaque)
@@ -241,11 +261,7 @@ void MarkdownParser::renderHorizontalRule(struct buf* ob, void* opaque)
 
 void MarkdownParser::renderHorizontalRule()
 {
-    if (!m_workingNode)
-        throw NO_WORKING_NODE_ERR;
-
-    MarkdownNode node(HRuleMarkdownNodeType, m_workingNode, ByteBuffer(), MarkdownNode::Data());
-    m_workingNode->children().push_back(node);
+    appendNode(HRuleMarkdownNodeType);
 }
 
 void MarkdownParser::renderHTML(struct buf* ob, const struct buf* text, void* opaque)
@@ -254,16 +270,12 @@ void MarkdownParser::renderHTML(struct buf* ob, const struct buf* text, void* op
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderHTML(ByteBufferFromSundown(text));
+    p->renderHTML(text);
 }
 
-void MarkdownParser::renderHTML(const ByteBuffer& text)
+void MarkdownParser::renderHTML(const struct buf* text)
 {
-    if (!m_workingNode)
-        throw NO_WORKING_NODE_ERR;
-
-    MarkdownNode node(HTMLMarkdownNodeType, m_workingNode, text);
-    m_workingNode->children().push_back(node);
+    appendNode(HTMLMarkdownNodeType, text);
 }
 
 void MarkdownParser::beginQuote(void* opaque)
@@ -280,11 +292,8 @@ void MarkdownParser::beginQuote()
     if (!m_workingNode)
         throw NO_WORKING_NODE_ERR;
 
-    MarkdownNode node(QuoteMarkdownNodeType, m_workingNode);
-    m_workingNode->children().push_back(node);
-
     // Push context
-    m_workingNode = &m_workingNode->children().back();
+    m_workingNode = &appendNode(QuoteMarkdownNodeType);
 }
 
 void MarkdownParser::renderQuote(struct buf* ob, const struct buf* text, void* opaque)
@@ -293,10 +302,10 @@ void MarkdownParser::renderQuote(struct buf* ob, const struct buf* text, void* o
         return;
 
     MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
-    p->renderQuote(ByteBufferFromSundown(text));
+    p->renderQuote(text);
 }
 
-void MarkdownParser::renderQuote(const ByteBuffer& text)
+void MarkdownParser::renderQuote(const struct buf* text)
 {
     if (!m_workingNode)
         throw NO_WORKING_NODE_ERR;
@@ -304,7 +313,7 @@ void MarkdownParser::renderQuote(const ByteBuffer& text)
     if (m_workingNode->type != QuoteMarkdownNodeType)
         throw WORKING_NODE_MISMATCH_ERR;
 
-    m_workingNode->text = text;
+    AssignSundown(m_workingNode->text, text);
 
     // Pop context
     m_workingNode = &m_workingNode->parent();
@@ -315,13 +324,16 @@ void MarkdownParser::blockDidParse(const src_map* map, const uint8_t* txt_data,
     if (!opaque || !map)
         return;
 
-    BytesRangeSet sourceMap;
+    MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
+
+    BytesRangeSet& sourceMap = p->m_blockSourceMap;
+    sourceMap.clear();
+
     for (size_t i = 0; i < map->size; ++i) {
         BytesRange byteRange(((range*)map->item[i])->loc, ((range*)map->item[i])->len);
         sourceMap.push_back(byteRange);
     }
 
-    MarkdownParser* p = static_cast<MarkdownParser*>(opaque);
     p->blockDidParse(sourceMap);
 }
 
@@ -365,7 +377,9 @@ void MarkdownParser::blockDidParse(const BytesRangeSet& sourceMap)
         && lMarkdownNode.children().front().sourceMap.empty()) {
 
         ByteBuffer& buffer = lMarkdownNode.children().front().text;
-        ByteBuffer mapped = MapBytesRangeSet(sourceMap, *m_source);
+        ByteBuffer& mapped = m_listItemSource;
+        mapped.clear();
+        AppendBytesRangeSet(sourceMap, *m_source, mapped);
         size_t pos = mapped.find(buffer);
 
         if (pos != mapped.npos) {
@@ -380,3 +394,16 @@ void MarkdownParser::blockDidParse(const BytesRangeSet& sourceMap)
         }
     }
 }
+
+MarkdownNode& MarkdownParser::appendNode(MarkdownNodeType type, const struct buf* text, MarkdownNode::Data data)
+{
+    if (!m_workingNode)
+        throw NO_WORKING_NODE_ERR;
+
+    m_workingNode->children().emplace_back(type, m_workingNode, ByteBuffer(), data);
+
+    MarkdownNode& node = m_workingNode->children().back();
+    AssignSundown(node.text, text);
+
+    return node;
+}
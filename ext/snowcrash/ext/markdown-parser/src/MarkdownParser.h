@@ -32,23 +32,46 @@ namespace mdp
     {
     public:
         MarkdownParser();
-        MarkdownParser(const MarkdownParser&);
-        MarkdownParser& operator=(const MarkdownParser&);
+        ~MarkdownParser();
 
         /**
          *  \brief Parse source buffer
          *
+         *  Sundown parser and its buffers are created by the first parse
+         *  and reused by the following ones. A parser must not be used
+         *  by more threads at once.
+         *
          *  \param source   Markdown source data to be parsed
          *  \param ast      Parsed AST (root node)
          */
         void parse(const ByteBuffer& source, MarkdownNode& ast);
 
     private:
+        // Sundown keeps a pointer to the parser, so it can not be copied
+        MarkdownParser(const MarkdownParser&);
+        MarkdownParser& operator=(const MarkdownParser&);
+
         MarkdownNode* m_workingNode;
         bool m_listBlockContext;
         const ByteBuffer* m_source;
         size_t m_sourceLength;
 
+        ::sd_markdown* m_sundown;
+        ::buf* m_output;
+
+        /** Source map of the last parsed block, reused by blocks */
+        BytesRangeSet m_blockSourceMap;
+
+        /** Source of the last parsed list item, reused by list items */
+        ByteBuffer m_listItemSource;
+
+        /** Release sundown parser and its buffers */
+        void release();
+
+        /** Append a node to the working node, its text is copied from sundown directly */
+        MarkdownNode& appendNode(
+            MarkdownNodeType type, const struct buf* text = NULL, MarkdownNode::Data data = MarkdownNode::Data());
+
         static const size_t OutputUnitSize;
         static const size_t MaxNesting;
         static const int ParserExtensions;
@@ -61,29 +84,29 @@ namespace mdp
 
         // Header
         static void renderHeader(struct buf* ob, const struct buf* text, int level, void* opaque);
-        void renderHeader(const ByteBuffer& text, int level);
+        void renderHeader(const struct buf* text, int level);
 
         // List
         static void beginList(int flags, void* opaque);
         void beginList(int flags);
 
         static void renderList(struct buf* ob, const struct buf* text, int flags, void* opaque);
-        void renderList(const ByteBuffer& text, int flags);
+        void renderList(const struct buf* text, int flags);
 
         // List item
         static void beginListItem(int flags, void* opaque);
         void beginListItem(int flags);
 
         static void renderListItem(struct buf* ob, const struct buf* text, int flags, void* opaque);
-        void renderListItem(const ByteBuffer& text, int flags);
+        void renderListItem(const struct buf* text, int flags);
 
         // Code block
         static void renderBlockCode(struct buf* ob, const struct buf* text, const struct buf* lang, void* opaque);
-        void renderBlockCode(const ByteBuffer& text, const ByteBuffer& language);
+        void renderBlockCode(const struct buf* text, const struct buf* language);
 
         // Paragraph
         static void renderParagraph(struct buf* ob, const struct buf* text, void* opaque);
-        void renderParagraph(const ByteBuffer& text);
+        void renderParagraph(const struct buf* text);
 
         // Horizontal Rule
         static void renderHorizontalRule(struct buf* ob, void* opaque);
@@ -91,14 +114,14 @@ namespace mdp
 
         // HTML
         static void renderHTML(struct buf* ob, const struct buf* text, void* opaque);
-        void renderHTML(const ByteBuffer& text);
+        void renderHTML(const struct buf* text);
 
         // Quote
         static void beginQuote(void* opaque);
         void beginQuote();
 
         static void renderQuote(struct buf* ob, const struct buf* text, void* opaque);
-        void renderQuote(const std::string& text);
+        void renderQuote(const struct buf* text);
 
         // Source maps
         static void blockDidParse(const src_map* map, const uint8_t* txt_data, size_t size, void* opaque);
@@ -180,3 +180,26 @@ TEST_CASE("Byte buffer and Index should return equal char ranges", "[bytebuffer]
     REQUIRE(charMap[4].location == indexMap[4].location);
     REQUIRE(charMap[4].length == indexMap[4].length);
 }
+
+TEST_CASE("Append mapped bytes of range set", "[bytebuffer][sourcemap]")
+{
+    ByteBuffer src = "0123456789";
+
+    BytesRangeSet byteMap;
+    byteMap.push_back(Range(1, 2));
+    byteMap.push_back(Range(7, 4)); // sundown extra newline
+
+    ByteBuffer out = "x";
+    AppendBytesRangeSet(byteMap, src, out);
+
+    REQUIRE(out == "x12789");
+    REQUIRE(out.substr(1) == MapBytesRangeSet(byteMap, src));
+
+    // wrong map appends nothing
+    byteMap.back() = Range(7, 5);
+    out = "x";
+    AppendBytesRangeSet(byteMap, src, out);
+
+    REQUIRE(out == "x");
+    REQUIRE(MapBytesRangeSet(byteMap, src).empty());
+}
@@ -753,3 +753,30 @@ TEST_CASE("Empty quota in listitem", "[parser]")
     REQUIRE(list.children()[1].children()[0].children()[0].sourceMap[0].location == 25);
     REQUIRE(list.children()[1].children()[0].children()[0].sourceMap[0].length == 3);
 }
+
+TEST_CASE("Parser is reused for more documents", "[parser]")
+{
+    MarkdownParser parser;
+    MarkdownNode ast;
+
+    parser.parse("- A\n\n    C\n    D\n\n    E\n", ast);
+
+    REQUIRE(ast.children().size() == 1);
+    REQUIRE(ast.sourceMap[0].length == 24);
+    REQUIRE(ast.children()[0].type == ListItemMarkdownNodeType);
+    REQUIRE(ast.children()[0].children().size() == 3);
+    REQUIRE(ast.children()[0].children()[0].text == "A");
+
+    parser.parse("Hello World!\n", ast);
+
+    REQUIRE(ast.children().size() == 1);
+    REQUIRE(ast.sourceMap.size() == 1);
+    REQUIRE(ast.sourceMap[0].length == 13);
+
+    MarkdownNode& node = ast.children().front();
+    REQUIRE(node.type == ParagraphMarkdownNodeType);
+    REQUIRE(node.text == "Hello World!");
+    REQUIRE(node.sourceMap.size() == 1);
+    REQUIRE(node.sourceMap[0].location == 0);
+    REQUIRE(node.sourceMap[0].length == 13);
+}
@@ -98,8 +98,7 @@ namespace snowcrash
             MarkdownNodeIterator cur = node;
             std::stringstream ss;
 
-            mdp::CharactersRangeSet sourceMap
-                = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+            const mdp::BytesRangeSet& sourceMap = node->sourceMap;
 
             switch (sectionType) {
                 case RelationSectionType: {
@@ -207,10 +206,10 @@ namespace snowcrash
                 && !out.node.examples.empty()
                 && !out.node.examples.back().responses.empty()) {
 
-                mdp::ByteBuffer content = CodeBlockUtility::addDanglingAsset(
+                CodeBlockUtility::addDanglingAsset(
                     node, pd, sectionType, out.report, out.node.examples.back().responses.back().body);
 
-                if (pd.exportSourceMap() && !content.empty()) {
+                if (pd.exportSourceMap()) {
                     out.sourceMap.examples.collection.back().responses.collection.back().body.sourceMap.append(
                         node->sourceMap);
                 }
@@ -223,10 +222,10 @@ namespace snowcrash
                 && !out.node.examples.empty()
                 && !out.node.examples.back().requests.empty()) {
 
-                mdp::ByteBuffer content = CodeBlockUtility::addDanglingAsset(
+                CodeBlockUtility::addDanglingAsset(
                     node, pd, sectionType, out.report, out.node.examples.back().requests.back().body);
 
-                if (pd.exportSourceMap() && !content.empty()) {
+                if (pd.exportSourceMap()) {
                     out.sourceMap.examples.collection.back().requests.collection.back().body.sourceMap.append(
                         node->sourceMap);
                 }
@@ -240,8 +239,7 @@ namespace snowcrash
 
                 // WARN: Ignoring section
                 std::stringstream ss;
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
 
                 ss << "Ignoring " << SectionName(assetType) << " list item, ";
                 ss << SectionName(assetType) << " list item is expected to be indented by 4 spaces or 1 tab";
@@ -340,8 +338,7 @@ namespace snowcrash
             if (out.node.examples.empty()) {
 
                 // WARN: No response for action
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(
                     Warning("action is missing a response", EmptyDefinitionWarning, sourceMap));
             } else if (!out.node.examples.empty() && !out.node.examples.back().requests.empty()
@@ -357,8 +354,7 @@ namespace snowcrash
                     ss << "the '" << out.node.examples.back().requests.back().name << "' request";
                 }
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), EmptyDefinitionWarning, sourceMap));
             }
         }
@@ -372,7 +368,7 @@ namespace snowcrash
          *  \param  report      Parser report.
          */
         static void checkPayload(SectionType sectionType,
-            const mdp::CharactersRangeSet sourceMap,
+            const mdp::BytesRangeSet sourceMap,
             const Payload& payload,
             const ParseResultRef<Action>& out)
         {
@@ -456,8 +452,7 @@ namespace snowcrash
             ss << "the 'headers' section at this level is deprecated and will be removed in a future, use respective "
                   "payload header section(s) instead";
 
-            mdp::CharactersRangeSet sourceMap
-                = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+            const mdp::BytesRangeSet& sourceMap = node->sourceMap;
             out.report.warnings.push_back(Warning(ss.str(), DeprecatedWarning, sourceMap));
 
             return cur;
@@ -538,8 +533,7 @@ namespace snowcrash
 
             if (RegexMatch(node->text, NamedActionNonAbsoluteURIRegex)) {
                 std::stringstream ss;
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
 
                 ss << "URI path in '" << node->text << "' is not absolute, it should have a leading forward slash";
 
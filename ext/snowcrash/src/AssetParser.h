@@ -63,12 +63,10 @@ namespace snowcrash
             const ParseResultRef<Asset>& out)
         {
 
-            mdp::ByteBuffer content;
-            CodeBlockUtility::contentAsCodeBlock(node, pd, out.report, content);
+            const size_t length = out.node.length();
+            CodeBlockUtility::contentAsCodeBlock(node, pd, out.report, out.node);
 
-            out.node += content;
-
-            if (pd.exportSourceMap() && !content.empty()) {
+            if (pd.exportSourceMap() && out.node.length() != length) {
                 out.sourceMap.sourceMap.append(node->sourceMap);
             }
 
@@ -11,6 +11,9 @@
 
 #include <iterator>
 #include <algorithm>
+#include <memory>
+#include <set>
+#include <thread>
 #include "ResourceParser.h"
 #include "ResourceGroupParser.h"
 #include "DataStructureGroupParser.h"
@@ -26,6 +29,144 @@ namespace snowcrash
     /** Internal type alias for Collection iterator of Metadata */
     typedef Collection<Metadata>::iterator MetadataCollectionIterator;
 
+    /** Marks a named type not visited yet while resolving named type dependencies */
+    const size_t UnvisitedNamedType = static_cast<size_t>(-1);
+
+    /** Internal type alias for direct dependencies of interned named types */
+    typedef std::vector<std::vector<mson::NamedTypeId> > NamedTypeDependencyGraph;
+
+    /**
+     * \brief Strongly connected components of a named type dependency graph (Tarjan)
+     *
+     * Components are discovered in topological order of the dependencies,
+     * i.e. a component is discovered after every component it depends on.
+     */
+    struct NamedTypeDependencyComponents {
+
+        /** Component index of every named type */
+        std::vector<size_t> component;
+
+        /** Named types of every component */
+        std::vector<std::vector<mson::NamedTypeId> > members;
+
+        explicit NamedTypeDependencyComponents(const NamedTypeDependencyGraph& graph)
+            : component(graph.size(), UnvisitedNamedType), m_graph(graph), m_index(graph.size(), UnvisitedNamedType),
+              m_lowlink(graph.size(), 0), m_onStack(graph.size(), false), m_counter(0)
+        {
+            for (mson::NamedTypeId id = 0; id < graph.size(); ++id) {
+                if (m_index[id] == UnvisitedNamedType)
+                    visit(id);
+            }
+        }
+
+    private:
+        const NamedTypeDependencyGraph& m_graph;
+        std::vector<size_t> m_index;
+        std::vector<size_t> m_lowlink;
+        std::vector<bool> m_onStack;
+        std::vector<mson::NamedTypeId> m_stack;
+        size_t m_counter;
+
+        /** Named type being visited and position of its next dependency to visit */
+        typedef std::pair<mson::NamedTypeId, size_t> Frame;
+
+        void enter(mson::NamedTypeId id, std::vector<Frame>& frames)
+        {
+            m_index[id] = m_lowlink[id] = m_counter++;
+            m_stack.push_back(id);
+            m_onStack[id] = true;
+
+            frames.push_back(Frame(id, 0));
+        }
+
+        /**
+         * Depth-first walk by an explicit stack of frames rather than by recursion,
+         * so a long chain of named types does not exhaust the stack of a parsing thread.
+         */
+        void visit(mson::NamedTypeId root)
+        {
+            std::vector<Frame> frames;
+            enter(root, frames);
+
+            while (!frames.empty()) {
+                const mson::NamedTypeId id = frames.back().first;
+                const std::vector<mson::NamedTypeId>& dependencies = m_graph[id];
+
+                if (frames.back().second < dependencies.size()) {
+                    const mson::NamedTypeId dependency = dependencies[frames.back().second++];
+
+                    if (m_index[dependency] == UnvisitedNamedType) {
+                        enter(dependency, frames);
+                    } else if (m_onStack[dependency]) {
+                        m_lowlink[id] = std::min(m_lowlink[id], m_index[dependency]);
+                    }
+
+                    continue;
+                }
+
+                // all dependencies of `id` visited, return to its dependent
+                frames.pop_back();
+
+                if (!frames.empty()) {
+                    const mson::NamedTypeId dependent = frames.back().first;
+                    m_lowlink[dependent] = std::min(m_lowlink[dependent], m_lowlink[id]);
+                }
+
+                if (m_lowlink[id] != m_index[id])
+                    continue;
+
+                // `id` is the root of a component, pop its members
+                members.push_back(std::vector<mson::NamedTypeId>());
+                mson::NamedTypeId member;
+
+                do {
+                    member = m_stack.back();
+                    m_stack.pop_back();
+                    m_onStack[member] = false;
+
+                    component[member] = members.size() - 1;
+                    members.back().push_back(member);
+                } while (member != id);
+            }
+        }
+    };
+
+    /**
+     * \brief Consecutive top-level sections parsed concurrently with other slices
+     *
+     * Every slice has its own parser data, AST and report. Slices are merged
+     * into the blueprint in document order once all of them are parsed.
+     */
+    struct BlueprintSlice {
+
+        /** First node of the slice */
+        MarkdownNodeIterator begin;
+
+        /** First node of the next slice */
+        MarkdownNodes::const_iterator end;
+
+        /** First node not parsed by the slice */
+        MarkdownNodeIterator cur;
+
+        /** Parser data of the slice */
+        std::unique_ptr<SectionParserData> pd;
+
+        /** Parsed top-level sections */
+        Blueprint node;
+        SourceMap<Blueprint> sourceMap;
+        Report report;
+
+        /** Set if parsing the slice has thrown */
+        bool failed;
+
+        BlueprintSlice(const MarkdownNodeIterator& begin_, const MarkdownNodes::const_iterator& end_)
+            : begin(begin_), end(end_), cur(begin_), failed(false)
+        {
+        }
+    };
+
+    typedef std::vector<BlueprintSlice> BlueprintSlices;
+
     /**
      * Blueprint processor
      */
@@ -119,8 +260,7 @@ namespace snowcrash
 
                     ss << " is already defined";
 
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                     out.report.warnings.push_back(Warning(ss.str(), DuplicateWarning, sourceMap));
                 }
 
@@ -221,6 +361,299 @@ namespace snowcrash
             resolveNamedTypeTables(pd, out.report);
         }
 
+        /**
+         * \brief Parse the top-level groups in slices by concurrent tasks of the runner
+         *
+         * Slices do not see the groups, models and named type dependencies of
+         * each other. Such duplicates and references are detected when merging
+         * the slices, in which case the result is discarded and nothing is merged.
+         *
+         * \param node First nested section
+         * \param siblings Siblings of the nested sections
+         * \param pd Section parser data
+         * \param out Processed output
+         * \param cur First unparsed node
+         * \return True if the slices were merged into the output
+         */
+        static bool parseNestedSectionsConcurrently(const MarkdownNodeIterator& node,
+            const MarkdownNodes& siblings,
+            SectionParserData& pd,
+            const ParseResultRef<Blueprint>& out,
+            MarkdownNodeIterator& cur)
+        {
+
+            BlueprintSlices slices;
+            splitIntoSlices(node, siblings, slices);
+
+            if (slices.size() < 2) {
+                return false;
+            }
+
+            pd.runner->run(
+                slices.size(), [&slices, &siblings, &pd](size_t i) { parseSlice(slices[i], siblings, pd); });
+
+            if (!mergeSlices(slices, pd, out)) {
+                return false;
+            }
+
+            cur = slices.back().cur;
+            return true;
+        }
+
+        /** \return True if a top-level group starts at the node */
+        static bool isSliceBoundary(const MarkdownNodeIterator& node)
+        {
+
+            SectionType nestedType = nestedSectionType(node);
+            return nestedType == ResourceGroupSectionType || nestedType == DataStructureGroupSectionType;
+        }
+
+        /** Split nested sections at group boundaries into slices of similar size, one per hardware thread */
+        static void splitIntoSlices(
+            const MarkdownNodeIterator& node, const MarkdownNodes& siblings, BlueprintSlices& slices)
+        {
+
+            std::vector<std::pair<size_t, MarkdownNodeIterator> > boundaries;
+            size_t size = 0;
+
+            for (MarkdownNodeIterator it = node; it != siblings.end(); ++it, ++size) {
+                if (it != node && isSliceBoundary(it)) {
+                    boundaries.push_back(std::make_pair(size, it));
+                }
+            }
+
+            // Parallel parsing has been asked for, so use at least two threads
+            size_t count = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+            count = std::min(count, boundaries.size() + 1);
+
+            MarkdownNodeIterator begin = node;
+
+            for (std::vector<std::pair<size_t, MarkdownNodeIterator> >::iterator it = boundaries.begin();
+                 it != boundaries.end() && slices.size() + 1 < count;
+                 ++it) {
+
+                if (it->first * count >= (slices.size() + 1) * size) {
+                    slices.push_back(BlueprintSlice(begin, it->second));
+                    begin = it->second;
+                }
+            }
+
+            slices.push_back(BlueprintSlice(begin, siblings.end()));
+        }
+
+        /** Parse a slice with its own parser data */
+        static void parseSlice(BlueprintSlice& slice, const MarkdownNodes& siblings, const SectionParserData& pd)
+        {
+
+            try {
+                slice.pd.reset(new SectionParserData(pd, slice.node));
+
+                ParseResultRef<Blueprint> out(slice.report, slice.node, slice.sourceMap);
+                slice.cur = SectionParser<Blueprint, BlueprintSectionAdapter>::parseNestedSectionRange(
+                    slice.begin, slice.end, siblings, *slice.pd, out);
+            } catch (...) {
+                slice.failed = true;
+            }
+        }
+
+        /**
+         * \brief Merge parsed slices into the output in document order
+         *
+         * \return False, with nothing merged, if the slices would not be parsed
+         *         the same way one after another
+         */
+        static bool mergeSlices(BlueprintSlices& slices, SectionParserData& pd, const ParseResultRef<Blueprint>& out)
+        {
+
+            std::set<mdp::ByteBuffer> groupNames;
+            std::set<URITemplate> uriTemplates;
+            std::set<mson::Literal> namedTypes;
+            std::set<Identifier> models;
+
+            for (ModelTable::const_iterator it = pd.modelTable.begin(); it != pd.modelTable.end(); ++it) {
+                models.insert(it->first);
+            }
+
+            for (BlueprintSlices::iterator it = slices.begin(); it != slices.end(); ++it) {
+
+                // Errors are reported by the parser running through all the slices
+                if (it->failed || it->report.error.code != Error::OK) {
+                    return false;
+                }
+
+                // A section overlapping the next slice
+                if (it + 1 != slices.end() && it->cur != it->end) {
+                    return false;
+                }
+
+                if (!isSliceIndependent(*it, groupNames, uriTemplates, namedTypes, models)) {
+                    return false;
+                }
+            }
+
+            if (!addDeferredDependencies(slices, pd)) {
+                return false;
+            }
+
+            for (BlueprintSlices::iterator it = slices.begin(); it != slices.end(); ++it) {
+
+                Elements& elements = it->node.content.elements();
+                out.node.content.elements().insert(out.node.content.elements().end(), elements.begin(), elements.end());
+
+                if (pd.exportSourceMap()) {
+                    Collection<SourceMap<Element> >::type& elementsSM = it->sourceMap.content.elements().collection;
+                    out.sourceMap.content.elements().collection.insert(
+                        out.sourceMap.content.elements().collection.end(), elementsSM.begin(), elementsSM.end());
+                }
+
+                out.report.warnings.insert(
+                    out.report.warnings.end(), it->report.warnings.begin(), it->report.warnings.end());
+
+                pd.modelTable.insert(it->pd->modelTable.begin(), it->pd->modelTable.end());
+                pd.modelSourceMapTable.insert(it->pd->modelSourceMapTable.begin(), it->pd->modelSourceMapTable.end());
+            }
+
+            return true;
+        }
+
+        /**
+         * \brief Check a slice does not duplicate or reference anything parsed by the preceding slices
+         *
+         * Names of the slice are added to the sets afterwards.
+         */
+        static bool isSliceIndependent(const BlueprintSlice& slice,
+            std::set<mdp::ByteBuffer>& groupNames,
+            std::set<URITemplate>& uriTemplates,
+            std::set<mson::Literal>& namedTypes,
+            std::set<Identifier>& models)
+        {
+
+            const Elements& elements = slice.node.content.elements();
+
+            for (Elements::const_iterator it = elements.begin(); it != elements.end(); ++it) {
+
+                if (it->element != Element::CategoryElement) {
+                    continue;
+                }
+
+                if (it->category == Element::ResourceGroupCategory
+                    && groupNames.find(it->attributes.name) != groupNames.end()) {
+                    return false;
+                }
+
+                for (Elements::const_iterator subIt = it->content.elements().begin();
+                     subIt != it->content.elements().end();
+                     ++subIt) {
+
+                    if (subIt->element == Element::ResourceElement) {
+
+                        const Resource& resource = subIt->content.resource;
+
+                        if (uriTemplates.find(resource.uriTemplate) != uriTemplates.end()
+                            || isNamedTypeInSet(resource.attributes.name.symbol.literal, namedTypes)) {
+                            return false;
+                        }
+                    }
+
+                    if (subIt->element == Element::DataStructureElement
+                        && isNamedTypeInSet(subIt->content.dataStructure.name.symbol.literal, namedTypes)) {
+                        return false;
+                    }
+                }
+            }
+
+            for (ModelTable::const_iterator it = slice.pd->modelTable.begin(); it != slice.pd->modelTable.end();
+                 ++it) {
+
+                if (models.find(it->first) != models.end()) {
+                    return false;
+                }
+            }
+
+            for (std::vector<Identifier>::const_iterator it = slice.pd->pendingModelReferences.begin();
+                 it != slice.pd->pendingModelReferences.end();
+                 ++it) {
+
+                if (models.find(*it) != models.end()) {
+                    return false;
+                }
+            }
+
+            for (Elements::const_iterator it = elements.begin(); it != elements.end(); ++it) {
+
+                if (it->element != Element::CategoryElement) {
+                    continue;
+                }
+
+                if (it->category == Element::ResourceGroupCategory) {
+                    groupNames.insert(it->attributes.name);
+                }
+
+                for (Elements::const_iterator subIt = it->content.elements().begin();
+                     subIt != it->content.elements().end();
+                     ++subIt) {
+
+                    if (subIt->element == Element::ResourceElement) {
+                        uriTemplates.insert(subIt->content.resource.uriTemplate);
+                        namedTypes.insert(subIt->content.resource.attributes.name.symbol.literal);
+                    } else if (subIt->element == Element::DataStructureElement) {
+                        namedTypes.insert(subIt->content.dataStructure.name.symbol.literal);
+                    }
+                }
+            }
+
+            for (ModelTable::const_iterator it = slice.pd->modelTable.begin(); it != slice.pd->modelTable.end();
+                 ++it) {
+
+                models.insert(it->first);
+            }
+
+            return true;
+        }
+
+        /** \return True if a non-empty named type name is in the set */
+        static bool isNamedTypeInSet(const mson::Literal& name, const std::set<mson::Literal>& namedTypes)
+        {
+
+            return !name.empty() && namedTypes.find(name) != namedTypes.end();
+        }
+
+        /**
+         * \brief Add the named type dependencies deferred by the slices in document order
+         *
+         * \return False, with the dependency table left untouched, if adding them reports an error
+         */
+        static bool addDeferredDependencies(const BlueprintSlices& slices, SectionParserData& pd)
+        {
+
+            mson::NamedTypeDependencyTable table;
+            Report report;
+            bool deferred = false;
+
+            for (BlueprintSlices::const_iterator it = slices.begin(); it != slices.end(); ++it) {
+
+                for (DeferredDependencies::const_iterator depIt = it->pd->deferredDependencies.begin();
+                     depIt != it->pd->deferredDependencies.end();
+                     ++depIt) {
+
+                    if (!deferred) {
+                        table = pd.namedTypeDependencyTable;
+                        deferred = true;
+                    }
+
+                    mson::addDependency(
+                        depIt->node, pd, depIt->dependency, depIt->dependent, report, depIt->circularCheck);
+                }
+            }
+
+            if (report.error.code != Error::OK) {
+                pd.namedTypeDependencyTable.swap(table);
+                return false;
+            }
+
+            return true;
+        }
+
         static void checkForPossibleSectionMistakes(
             const MarkdownNodeIterator& node, SectionParserData& pd, Report& report)
         {
@@ -280,15 +713,13 @@ namespace snowcrash
             if (pd.options & RequireBlueprintNameOption) {
 
                 // ERR: No API name specified
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.error = Error(ExpectedAPINameMessage, BusinessError, sourceMap);
 
             } else if (!out.node.description.empty()) {
 
                 // WARN: No API name specified
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ExpectedAPINameMessage, APINameWarning, sourceMap));
             }
         }
@@ -346,8 +777,7 @@ namespace snowcrash
                 std::stringstream ss;
                 ss << "named type '" << identifier << "' is defined more than once";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 report.error = Error(ss.str(), MSONError, sourceMap);
                 return;
             }
@@ -397,18 +827,31 @@ namespace snowcrash
         static void resolveNamedTypeTables(SectionParserData& pd, Report& report)
         {
 
-            mson::NamedTypeInheritanceTable::iterator it;
-            mson::NamedTypeDependencyTable::iterator depIt;
+            mson::NamedTypeSymbols symbols;
+            std::vector<bool> circular;
 
             // First resolve dependency tables
-            for (depIt = pd.namedTypeDependencyTable.begin(); depIt != pd.namedTypeDependencyTable.end(); depIt++) {
+            resolveNamedTypeDependencyTable(pd, symbols, circular);
+
+            // Resolve in the order of sub type names, so the reported error does not depend on hashing
+            std::vector<mson::NamedTypeInheritanceTable::const_iterator> entries;
+            entries.reserve(pd.namedTypeInheritanceTable.size());
+
+            for (mson::NamedTypeInheritanceTable::const_iterator it = pd.namedTypeInheritanceTable.begin();
+                 it != pd.namedTypeInheritanceTable.end();
+                 ++it) {
 
-                resolveNamedTypeDependencyTableEntry(pd, depIt->first, report);
+                entries.push_back(it);
             }
 
-            for (it = pd.namedTypeInheritanceTable.begin(); it != pd.namedTypeInheritanceTable.end(); it++) {
+            std::sort(entries.begin(), entries.end(), inheritanceEntryLess);
 
-                resolveNamedTypeBaseTableEntry(pd, it->first, it->second.first, it->second.second, report);
+            for (std::vector<mson::NamedTypeInheritanceTable::const_iterator>::iterator it = entries.begin();
+                 it != entries.end();
+                 ++it) {
+
+                resolveNamedTypeBaseTableEntry(
+                    pd, symbols, circular, (*it)->first, (*it)->second.first, (*it)->second.second, report);
 
                 if (report.error.code != Error::OK) {
                     return;
@@ -416,50 +859,130 @@ namespace snowcrash
             }
         }
 
+        static bool inheritanceEntryLess(const mson::NamedTypeInheritanceTable::const_iterator& lhs,
+            const mson::NamedTypeInheritanceTable::const_iterator& rhs)
+        {
+            return lhs->first < rhs->first;
+        }
+
         /**
-         * \brief Resolve the inheritance dependencies of the current named type
+         * \brief Transitively close the inheritance dependencies of all named types
          *        (Does not include mixin or member dependencies)
          *
+         * Named types are interned and visited by components of mutually dependent types, each
+         * component after the ones it depends on, so every dependency list is assembled once from
+         * already resolved lists. Named types referenced but not defined get an empty entry.
+         *
          * \param pd Section parser data
-         * \param identifier The named type whose dependents need to be resolved
-         * \param report Parse report
+         * \param symbols Interned named types
+         * \param circular Set for every interned named type which depends on itself
          */
-        static void resolveNamedTypeDependencyTableEntry(
-            SectionParserData& pd, const mson::Literal& identifier, Report& report)
+        static void resolveNamedTypeDependencyTable(
+            SectionParserData& pd, mson::NamedTypeSymbols& symbols, std::vector<bool>& circular)
         {
 
-            std::set<mson::Literal> diffDeps, finalDeps, initialDeps;
+            mson::NamedTypeDependencyTable& table = pd.namedTypeDependencyTable;
+
+            for (mson::NamedTypeDependencyTable::iterator it = table.begin(); it != table.end(); ++it) {
 
-            do {
-                initialDeps = pd.namedTypeDependencyTable[identifier];
-                diffDeps.clear();
+                symbols.intern(it->first);
 
-                for (std::set<mson::Literal>::iterator it = initialDeps.begin(); it != initialDeps.end(); it++) {
+                for (std::set<mson::Literal>::const_iterator depIt = it->second.begin(); depIt != it->second.end();
+                     ++depIt) {
 
-                    std::set<mson::Literal> superTypeDeps = pd.namedTypeDependencyTable[*it];
-                    pd.namedTypeDependencyTable[identifier].insert(superTypeDeps.begin(), superTypeDeps.end());
+                    symbols.intern(*depIt);
                 }
+            }
+
+            NamedTypeDependencyGraph graph(symbols.size());
+
+            for (mson::NamedTypeDependencyTable::iterator it = table.begin(); it != table.end(); ++it) {
+
+                std::vector<mson::NamedTypeId>& dependencies = graph[symbols.find(it->first)];
+
+                for (std::set<mson::Literal>::const_iterator depIt = it->second.begin(); depIt != it->second.end();
+                     ++depIt) {
+
+                    dependencies.push_back(symbols.find(*depIt));
+                }
+            }
+
+            NamedTypeDependencyComponents components(graph);
+            std::vector<std::vector<mson::NamedTypeId> > resolved(components.members.size());
+            std::vector<size_t> addedTo(symbols.size(), UnvisitedNamedType);
+
+            circular.assign(symbols.size(), false);
+
+            for (size_t c = 0; c < components.members.size(); ++c) {
 
-                // Check if the list of dependents has grown
-                finalDeps = pd.namedTypeDependencyTable[identifier];
-                std::set_difference(finalDeps.begin(),
-                    finalDeps.end(),
-                    initialDeps.begin(),
-                    initialDeps.end(),
-                    std::inserter(diffDeps, diffDeps.end()));
+                const std::vector<mson::NamedTypeId>& members = components.members[c];
+                std::vector<mson::NamedTypeId>& dependencies = resolved[c];
 
-            } while (!diffDeps.empty());
-        };
+                for (std::vector<mson::NamedTypeId>::const_iterator it = members.begin(); it != members.end(); ++it) {
+
+                    for (std::vector<mson::NamedTypeId>::const_iterator depIt = graph[*it].begin();
+                         depIt != graph[*it].end();
+                         ++depIt) {
+
+                        appendDependency(*depIt, c, addedTo, dependencies);
+
+                        // Dependencies of a component discovered before are already resolved
+                        const size_t depComponent = components.component[*depIt];
+
+                        if (depComponent == c)
+                            continue;
+
+                        for (std::vector<mson::NamedTypeId>::const_iterator inhIt = resolved[depComponent].begin();
+                             inhIt != resolved[depComponent].end();
+                             ++inhIt) {
+
+                            appendDependency(*inhIt, c, addedTo, dependencies);
+                        }
+                    }
+                }
+
+                for (std::vector<mson::NamedTypeId>::const_iterator it = members.begin(); it != members.end(); ++it) {
+
+                    std::set<mson::Literal>& entry = table[symbols.literal(*it)];
+                    entry.clear();
+
+                    for (std::vector<mson::NamedTypeId>::const_iterator depIt = dependencies.begin();
+                         depIt != dependencies.end();
+                         ++depIt) {
+
+                        entry.insert(symbols.literal(*depIt));
+                    }
+
+                    circular[*it] = (addedTo[*it] == c);
+                }
+            }
+        }
+
+        /** Append a dependency to the list of component `c` unless it is already there */
+        static void appendDependency(mson::NamedTypeId dependency,
+            size_t c,
+            std::vector<size_t>& addedTo,
+            std::vector<mson::NamedTypeId>& dependencies)
+        {
+            if (addedTo[dependency] != c) {
+                addedTo[dependency] = c;
+                dependencies.push_back(dependency);
+            }
+        }
 
         /**
          * \brief For each entry in the named type inheritance table, resolve the sub-type's base type recursively
          *
          * \param pd Section parser data
+         * \param symbols Interned named types
+         * \param circular Circular flags of the interned named types
          * \param subType The sub named type between the two
          * \param superType The super named type between the two
          * \param report Parse report
          */
         static void resolveNamedTypeBaseTableEntry(SectionParserData& pd,
+            const mson::NamedTypeSymbols& symbols,
+            const std::vector<bool>& circular,
             const mson::Literal& subType,
             const mson::Literal& superType,
             const mdp::BytesRangeSet& nodeSourceMap,
@@ -475,16 +998,15 @@ namespace snowcrash
             }
 
             // Check for circular references
-            std::set<mson::Literal> deps = pd.namedTypeDependencyTable[subType];
+            mson::NamedTypeId subTypeId = symbols.find(subType);
 
-            if (deps.find(subType) != deps.end()) {
+            if (subTypeId != mson::NamedTypeSymbols::npos && circular[subTypeId]) {
 
                 // ERR: A named type is circularly referenced
                 std::stringstream ss;
                 ss << "base type '" << subType << "' circularly referencing itself";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(nodeSourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = nodeSourceMap;
                 report.error = Error(ss.str(), MSONError, sourceMap);
                 return;
             }
@@ -506,14 +1028,14 @@ namespace snowcrash
                     std::stringstream ss;
                     ss << "base type '" << superType << "' is not defined in the document";
 
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(nodeSourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = nodeSourceMap;
                     report.error = Error(ss.str(), MSONError, sourceMap);
                     return;
                 }
 
                 // Recursively, try to get a base type for the current super type
-                resolveNamedTypeBaseTableEntry(pd, superType, inhIt->second.first, inhIt->second.second, report);
+                resolveNamedTypeBaseTableEntry(
+                    pd, symbols, circular, superType, inhIt->second.first, inhIt->second.second, report);
 
                 if (report.error.code != Error::OK) {
                     return;
@@ -574,16 +1096,14 @@ namespace snowcrash
                         std::stringstream ss;
                         ss << "duplicate definition of '" << it->first << "'";
 
-                        mdp::CharactersRangeSet sourceMap
-                            = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                        const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                         out.report.warnings.push_back(Warning(ss.str(), DuplicateWarning, sourceMap));
                     }
                 }
             } else if (!out.node.empty()) {
 
                 // WARN: malformed metadata block
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(
                     Warning("ignoring possible metadata, expected '<key> : <value>', one one per line",
                         FormattingWarning,
@@ -819,8 +1339,7 @@ namespace snowcrash
                 std::stringstream ss;
                 ss << "Undefined resource model " << out.node.reference.id;
 
-                mdp::CharactersRangeSet sourceMap = mdp::BytesRangeSetToCharactersRangeSet(
-                    out.node.reference.meta.node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = out.node.reference.meta.node->sourceMap;
                 out.report.error = Error(ss.str(), ModelError, sourceMap);
 
                 out.node.reference.meta.state = Reference::StateUnresolved;
@@ -834,6 +1353,27 @@ namespace snowcrash
 
     /** Blueprint Parser */
     typedef SectionParser<Blueprint, BlueprintSectionAdapter> BlueprintParser;
+
+    /** Parse nested sections of blueprint, concurrently if asked for */
+    template <>
+    inline MarkdownNodeIterator SectionParser<Blueprint, BlueprintSectionAdapter>::parseNestedSections(
+        const MarkdownNodeIterator& node,
+        const MarkdownNodes& collection,
+        SectionParserData& pd,
+        const ParseResultRef<Blueprint>& out)
+    {
+
+        SectionProcessor<Blueprint>::preprocessNestedSections(node, collection, pd, out);
+
+        MarkdownNodeIterator cur = node;
+
+        if ((pd.options & ParallelParseOption) && pd.runner
+            && SectionProcessor<Blueprint>::parseNestedSectionsConcurrently(node, collection, pd, out, cur)) {
+            return cur;
+        }
+
+        return parseNestedSectionRange(node, collection.end(), collection, pd, out);
+    }
 }
 
 #endif
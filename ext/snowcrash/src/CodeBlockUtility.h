@@ -45,24 +45,36 @@ namespace snowcrash
          *  \brief  Retrieve the textual content of a Markdown node as if it was a code block.
          *  \param  pd      Parser status
          *  \param  report  Report log
-         *  \param  conten  The content retrieved
+         *  \param  conten  The content retrieved, appended to without an intermediate copy
          */
         static void contentAsCodeBlock(
             const MarkdownNodeIterator& node, const SectionParserData& pd, Report& report, mdp::ByteBuffer& content)
         {
 
-            checkPossibleReference(node, pd, report);
-
             if (node->type == mdp::CodeMarkdownNodeType) {
                 content += node->text;
+            } else {
+                mdp::AppendBytesRangeSet(node->sourceMap, pd.sourceData, content);
+            }
+
+            checkCodeBlock(node, pd, report);
+        }
+
+        /**
+         *  \brief  Check a Markdown node retrieved as if it was a code block, without retrieving its content.
+         *  \param  pd      Parser status
+         *  \param  report  Report log
+         */
+        static void checkCodeBlock(const MarkdownNodeIterator& node, const SectionParserData& pd, Report& report)
+        {
+
+            checkPossibleReference(node, pd, report);
 
+            if (node->type == mdp::CodeMarkdownNodeType) {
                 checkExcessiveIndentation(node, pd, report);
                 return;
             }
 
-            // Other blocks, process & warn
-            content += mdp::MapBytesRangeSet(node->sourceMap, pd.sourceData);
-
             // WARN: Not a preformatted code block
             size_t level = codeBlockIndentationLevel(pd.parentSectionContext());
             std::stringstream ss;
@@ -75,8 +87,7 @@ namespace snowcrash
             ss << " is expected to be a pre-formatted code block, every of its line indented by exactly ";
             ss << level * 4 << " spaces or " << level << " tabs";
 
-            mdp::CharactersRangeSet sourceMap
-                = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+            const mdp::BytesRangeSet& sourceMap = node->sourceMap;
             report.warnings.push_back(Warning(ss.str(), IndentationWarning, sourceMap));
         }
 
@@ -108,8 +119,7 @@ namespace snowcrash
             ss << "indent every of its line by ";
             ss << level * 4 << " spaces or " << level << " tabs";
 
-            mdp::CharactersRangeSet sourceMap
-                = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+            const mdp::BytesRangeSet& sourceMap = node->sourceMap;
             report.warnings.push_back(Warning(ss.str(), IndentationWarning, sourceMap));
         }
 
@@ -157,8 +167,7 @@ namespace snowcrash
                     ss << "section is not expected to be indented";
                 }
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 report.warnings.push_back(Warning(ss.str(), IndentationWarning, sourceMap));
             }
 
@@ -188,26 +197,30 @@ namespace snowcrash
         /**
          *  \brief Add dangling message body asset to the given string
          *  \param  out  The string to which the dangling asset should be added
-         *  \param  outSM The source map to which source map should be added
-         *  \return asset The value of the asset
          */
-        static mdp::ByteBuffer addDanglingAsset(const MarkdownNodeIterator& node,
+        static void addDanglingAsset(const MarkdownNodeIterator& node,
             SectionParserData& pd,
             SectionType& sectionType,
             Report& report,
             mdp::ByteBuffer& out)
         {
 
-            mdp::ByteBuffer asset;
+            const mdp::ByteBuffer::size_type begin = out.size();
 
             if (node->type == mdp::CodeMarkdownNodeType) {
-                asset = node->text;
+                out += node->text;
             } else {
-                asset = mdp::MapBytesRangeSet(node->sourceMap, pd.sourceData);
+                mdp::AppendBytesRangeSet(node->sourceMap, pd.sourceData, out);
             }
 
-            TwoNewLines(asset);
-            out += asset;
+            // The asset ends with two new lines
+            if (out.size() == begin || out[out.size() - 1] != '\n') {
+                out += "\n";
+            }
+
+            if (out.size() - begin < 2 || out[out.size() - 2] != '\n') {
+                out += "\n";
+            }
 
             size_t level = CodeBlockUtility::codeBlockIndentationLevel(sectionType);
 
@@ -222,12 +235,9 @@ namespace snowcrash
                 ss << "dangling message-body asset, expected a pre-formatted code block, ";
                 ss << "indent every of it's line by " << level * 4 << " spaces or " << level << " tabs";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 report.warnings.push_back(Warning(ss.str(), IndentationWarning, sourceMap));
             }
-
-            return asset;
         }
 
         /**
@@ -238,10 +248,19 @@ namespace snowcrash
             const MarkdownNodeIterator& node, const SectionParserData& pd, Report& report)
         {
 
-            mdp::ByteBuffer source = node->text;
-            Identifier symbol;
+            // A reference is `[symbol][]`, do not copy and match the text unless it may be one
+            const mdp::ByteBuffer& text = node->text;
+            TrimRange trim = GetTrimInfo(text.begin(), text.end());
+
+            const size_t first = std::get<0>(trim);
+            const size_t length = std::get<1>(trim);
+
+            if (length < 5 || text[first] != '[' || text.compare(first + length - 3, 3, "][]") != 0) {
+                return false;
+            }
 
-            TrimString(source);
+            mdp::ByteBuffer source = text.substr(first, length);
+            Identifier symbol;
 
             if (GetModelReference(source, symbol)) {
 
@@ -250,8 +269,7 @@ namespace snowcrash
                 ss << "a reference must be directly in the " << SectionName(pd.sectionContext())
                    << " section, indented by 4 spaces or 1 tab, without any additional sections";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 report.warnings.push_back(Warning(ss.str(), IgnoringWarning, sourceMap));
 
                 return true;
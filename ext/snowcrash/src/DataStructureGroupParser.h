@@ -46,8 +46,7 @@ namespace snowcrash
                     std::stringstream ss;
                     ss << "named type with name '" << namedType.node.name.symbol.literal << "' already exists";
 
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                     out.report.warnings.push_back(Warning(ss.str(), DuplicateWarning, sourceMap));
                     return cur;
                 }
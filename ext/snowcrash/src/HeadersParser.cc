@@ -2,12 +2,39 @@
 
 using namespace snowcrash;
 
-/** Finds a header in its containment group by its key (first) */
-static HeaderIterator findHeader(const Headers& headers, const Header& header)
+bool snowcrash::ScanHeaderLine(const mdp::ByteBuffer& line, HeaderLineSpans& spans)
 {
+    // keep behavior of former regex evaluation on c-string
+    const size_t length = std::min(line.length(), ::strlen(line.c_str()));
+    size_t i = 0;
 
-    return std::find_if(
-        headers.begin(), headers.end(), std::bind2nd(MatchFirsts<Header, IEqual<Header::first_type> >(), header));
+    while (i < length && line[i] == ' ')
+        ++i;
+
+    spans.nameBegin = i;
+
+    while (i < length && line[i] != ':' && line[i] != ' ' && line[i] != '\t')
+        ++i;
+
+    spans.nameLength = i - spans.nameBegin;
+
+    if (!spans.nameLength)
+        return false;
+
+    while (i < length && line[i] == ' ')
+        ++i;
+
+    spans.colon = (i < length && line[i] == ':');
+
+    if (spans.colon)
+        ++i;
+
+    while (i < length && line[i] == ' ')
+        ++i;
+
+    spans.valueBegin = i;
+
+    return true;
 }
 
 typedef std::vector<std::string> HeadersKeyCollection;
@@ -37,11 +64,32 @@ static bool isAllowedMultipleDefinition(const Header& header)
         != keys.end();
 }
 
+namespace
+{
+    /** Lookup table of characters allowed in token \see http://tools.ietf.org/html/rfc7230#section-3.2.6 */
+    struct TokenCharTable {
+        bool valid[256];
+
+        TokenCharTable()
+        {
+            static const char* const validChars = "-#$%&'*+.^_`|~";
+
+            for (int c = 0; c < 256; ++c) {
+                valid[c] = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+            }
+
+            for (const char* c = validChars; *c; ++c) {
+                valid[static_cast<unsigned char>(*c)] = true;
+            }
+        }
+    };
+}
+
 static bool isNotValidTokenChar(const std::string::value_type& c)
 {
-    static const std::string validChars("-#$%&'*+.^_`|~");
+    static const TokenCharTable table;
 
-    return !(std::isalnum(c) || (validChars.find(c) != std::string::npos));
+    return !table.valid[static_cast<unsigned char>(c)];
 }
 
 static std::string::const_iterator findNonValidCharInHeaderName(const std::string& token)
@@ -70,14 +118,14 @@ std::string HeaderNameTokenChecker::getMessage() const
 bool ColonPresentedChecker::operator()() const
 {
 
-    return captures[3].size() >= 1 && (captures[3].find(':') != std::string::npos);
+    return colon;
 }
 
 std::string ColonPresentedChecker::getMessage() const
 {
 
     std::stringstream ss;
-    ss << "missing colon after header name '" << captures[1] << "'";
+    ss << "missing colon after header name '" << headerName << "'";
 
     return ss.str();
 }
@@ -85,7 +133,7 @@ std::string ColonPresentedChecker::getMessage() const
 bool HeadersDuplicateChecker::operator()() const
 {
 
-    return findHeader(headers, header) == headers.end() || isAllowedMultipleDefinition(header);
+    return names.find(header.first) == names.end() || isAllowedMultipleDefinition(header);
 }
 
 std::string HeadersDuplicateChecker::getMessage() const
@@ -17,6 +17,7 @@
 #include "RegexMatch.h"
 
 #include <string.h>
+#include <unordered_set>
 
 namespace snowcrash
 {
@@ -27,6 +28,37 @@ namespace snowcrash
     /** Header Iterator in its containment group */
     typedef Collection<Header>::const_iterator HeaderIterator;
 
+    /** Set of already defined header names, names are compared case insensitive */
+    typedef std::unordered_set<std::string, IHash, IEqual<std::string> > HeaderNames;
+
+    /** Spans of individual parts of header line, \see ScanHeaderLine() */
+    struct HeaderLineSpans {
+
+        /** Header name */
+        size_t nameBegin;
+        size_t nameLength;
+
+        /** Header value (not trimmed) */
+        size_t valueBegin;
+
+        /** true if colon separates name and value */
+        bool colon;
+
+        HeaderLineSpans() : nameBegin(0), nameLength(0), valueBegin(0), colon(false)
+        {
+        }
+    };
+
+    /**
+     *  \brief Split header line into name and value in single pass
+     *
+     *  Accepts `<spaces><name><spaces>[:]<spaces><value>`, where name is non-empty
+     *  sequence of characters except colon and blanks
+     *
+     *  \return false if line does not contain header name
+     */
+    bool ScanHeaderLine(const mdp::ByteBuffer& line, HeaderLineSpans& spans);
+
     /** Base class for functor to check validity of parsed header */
     struct ValidateFunctorBase {
 
@@ -59,9 +91,11 @@ namespace snowcrash
     /** Functor implementation for check header contains colon character between name and value */
     struct ColonPresentedChecker : public ValidateFunctorBase {
 
-        const CaptureGroups& captures;
+        const std::string& headerName;
+        const bool colon;
 
-        explicit ColonPresentedChecker(const CaptureGroups& captures) : captures(captures)
+        explicit ColonPresentedChecker(const std::string& headerName, bool colon)
+            : headerName(headerName), colon(colon)
         {
         }
 
@@ -73,10 +107,10 @@ namespace snowcrash
     struct HeadersDuplicateChecker : public ValidateFunctorBase {
 
         const Header& header;
-        const Headers& headers;
+        const HeaderNames& names;
 
-        explicit HeadersDuplicateChecker(const Header& header, const Headers& headers)
-            : header(header), headers(headers)
+        explicit HeadersDuplicateChecker(const Header& header, const HeaderNames& names)
+            : header(header), names(names)
         {
         }
 
@@ -101,9 +135,9 @@ namespace snowcrash
     struct HeaderParserValidator {
 
         const ParseResultRef<Headers>& out;
-        mdp::CharactersRangeSet sourceMap;
+        mdp::BytesRangeSet sourceMap;
 
-        HeaderParserValidator(const ParseResultRef<Headers>& out, mdp::CharactersRangeSet sourceMap)
+        HeaderParserValidator(const ParseResultRef<Headers>& out, mdp::BytesRangeSet sourceMap)
             : out(out), sourceMap(sourceMap)
         {
         }
@@ -145,8 +179,7 @@ namespace snowcrash
             const ParseResultRef<Headers>& out)
         {
 
-            mdp::ByteBuffer content;
-            CodeBlockUtility::contentAsCodeBlock(node, pd, out.report, content);
+            CodeBlockUtility::checkCodeBlock(node, pd, out.report);
 
             headersFromContent(node, node->sourceMap.begin(), node->sourceMap.end(), pd, out);
 
@@ -185,8 +218,7 @@ namespace snowcrash
             if (out.node.empty()) {
 
                 // WARN: No valid headers defined
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning("no valid headers specified", FormattingWarning, sourceMap));
             }
         }
@@ -199,21 +231,20 @@ namespace snowcrash
          *
          * \param line - contains individual line with header definition
          * \param header - is filled by name and value if definition is valid
+         * \param names - names of headers already defined in section
          * \param out - "report" member can receive warning while checking validity
          * \param sourceMap - just contain source mapping for warning report
          */
         static bool parseHeaderLine(const mdp::ByteBuffer& line,
             Header& header,
+            const HeaderNames& names,
             const ParseResultRef<Headers>& out,
-            const mdp::CharactersRangeSet sourceMap)
+            const mdp::BytesRangeSet sourceMap)
         {
 
-            std::string re = "^ *([^:[:blank:]]+)(( *:? *)(.*)?)$";
-
-            CaptureGroups parts;
-            bool matched = RegexCapture(line, re, parts, 5);
+            HeaderLineSpans spans;
 
-            if (!matched) {
+            if (!ScanHeaderLine(line, spans)) {
                 // WARN: unable to parse header
                 out.report.warnings.push_back(Warning(
                     "unable to parse HTTP header, expected '<header name> : <header value>', one header per line",
@@ -222,7 +253,8 @@ namespace snowcrash
                 return false;
             }
 
-            header = std::make_pair(parts[1], parts[4]);
+            header.first.assign(line, spans.nameBegin, spans.nameLength);
+            header.second.assign(line, spans.valueBegin, mdp::ByteBuffer::npos);
             TrimString(header.second);
 
             HeaderParserValidator validate(out, sourceMap);
@@ -231,8 +263,8 @@ namespace snowcrash
                 return false;
             }
 
-            validate(ColonPresentedChecker(parts));
-            validate(HeadersDuplicateChecker(header, out.node));
+            validate(ColonPresentedChecker(header.first, spans.colon));
+            validate(HeadersDuplicateChecker(header, names));
             validate(HeaderValuePresentedChecker(header));
 
             return !header.first.empty();
@@ -275,6 +307,12 @@ namespace snowcrash
 
             bool inCodeFence = false;
 
+            // section can be composed from more blocks, take in account headers parsed so far
+            HeaderNames names;
+            for (HeaderIterator it = out.node.begin(); it != out.node.end(); ++it) {
+                names.insert(it->first);
+            }
+
             for (mdp::BytesRangeSet::const_iterator it = from; it != to; it++) {
 
                 mdp::BytesRange map(*it);
@@ -296,10 +334,10 @@ namespace snowcrash
 
                 mdp::BytesRangeSet byteMap;
                 byteMap.push_back(map);
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(byteMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = byteMap;
 
-                if (parseHeaderLine(line, header, out, sourceMap)) {
+                if (parseHeaderLine(line, header, names, out, sourceMap)) {
+                    names.insert(header.first);
                     out.node.push_back(header);
 
                     if (pd.exportSourceMap()) {
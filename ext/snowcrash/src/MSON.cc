@@ -10,6 +10,27 @@
 
 using namespace mson;
 
+const NamedTypeId NamedTypeSymbols::npos = static_cast<NamedTypeId>(-1);
+
+NamedTypeId NamedTypeSymbols::intern(const Literal& literal)
+{
+    Indexes::iterator it = m_indexes.find(literal);
+
+    if (it != m_indexes.end())
+        return it->second;
+
+    it = m_indexes.insert(Indexes::value_type(literal, m_literals.size())).first;
+    m_literals.push_back(&it->first);
+
+    return it->second;
+}
+
+NamedTypeId NamedTypeSymbols::find(const Literal& literal) const
+{
+    Indexes::const_iterator it = m_indexes.find(literal);
+    return (it == m_indexes.end()) ? npos : it->second;
+}
+
 bool Value::empty() const
 {
     return (this->literal.empty() && this->variable == false);
@@ -13,6 +13,7 @@
 #include <string>
 #include <set>
 #include <map>
+#include <unordered_map>
 #include <stdexcept>
 
 #include "Platform.h"
@@ -54,13 +55,53 @@ namespace mson
     };
 
     /** Named Types base type table */
-    typedef std::map<Literal, BaseType> NamedTypeBaseTable;
+    typedef std::unordered_map<Literal, BaseType> NamedTypeBaseTable;
 
     /** Named Types inheritance table */
-    typedef std::map<Literal, std::pair<Literal, mdp::BytesRangeSet> > NamedTypeInheritanceTable;
+    typedef std::unordered_map<Literal, std::pair<Literal, mdp::BytesRangeSet> > NamedTypeInheritanceTable;
 
     /** Named Types dependency table */
-    typedef std::map<Literal, std::set<Literal> > NamedTypeDependencyTable;
+    typedef std::unordered_map<Literal, std::set<Literal> > NamedTypeDependencyTable;
+
+    /** Index of an interned named type literal */
+    typedef size_t NamedTypeId;
+
+    /**
+     * Named Type Symbols
+     *
+     * Interns named type literals into dense indexes so that
+     * named type graphs can be kept in flat arrays
+     */
+    class NamedTypeSymbols
+    {
+    public:
+        /** Index returned for a literal which is not interned */
+        static const NamedTypeId npos;
+
+        /** \return Index of the literal, interning it first if needed */
+        NamedTypeId intern(const Literal& literal);
+
+        /** \return Index of the literal or `npos` if it is not interned */
+        NamedTypeId find(const Literal& literal) const;
+
+        /** \return Literal of an interned index */
+        const Literal& literal(NamedTypeId id) const
+        {
+            return *m_literals[id];
+        }
+
+        /** \return Number of interned literals */
+        size_t size() const
+        {
+            return m_literals.size();
+        }
+
+    private:
+        typedef std::unordered_map<Literal, NamedTypeId> Indexes;
+
+        Indexes m_indexes;
+        std::vector<const Literal*> m_literals; // keys of `m_indexes`
+    };
 
     /** A simple or actual value */
     struct Value {
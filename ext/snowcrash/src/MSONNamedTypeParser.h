@@ -48,8 +48,7 @@ namespace snowcrash
             if (subject[0] != '`' && RegexMatch(out.node.name.symbol.literal, MSONReservedCharsRegex)) {
 
                 // WARN: named type name should not contain reserved characters
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(
                     Warning("please escape the name of the data structure using backticks since it contains MSON "
                             "reserved characters",
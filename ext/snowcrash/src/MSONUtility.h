@@ -307,6 +307,13 @@ namespace mson
         bool circularCheck = false)
     {
 
+        // Slices parsed concurrently add their dependencies once merged
+        if (pd.concurrent) {
+            snowcrash::DeferredDependency deferred = { node, dependency, dependent, circularCheck };
+            pd.deferredDependencies.push_back(deferred);
+            return;
+        }
+
         // First, check if the type exists
         if (pd.namedTypeDependencyTable.find(dependency) == pd.namedTypeDependencyTable.end()) {
 
@@ -314,8 +321,7 @@ namespace mson
             std::stringstream ss;
             ss << "base type '" << dependency << "' is not defined in the document";
 
-            mdp::CharactersRangeSet sourceMap
-                = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+            const mdp::BytesRangeSet& sourceMap = node->sourceMap;
             report.error = snowcrash::Error(ss.str(), snowcrash::MSONError, sourceMap);
             return;
         }
@@ -329,8 +335,7 @@ namespace mson
             std::stringstream ss;
             ss << "base type '" << dependent << "' circularly referencing itself";
 
-            mdp::CharactersRangeSet sourceMap
-                = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+            const mdp::BytesRangeSet& sourceMap = node->sourceMap;
             report.error = snowcrash::Error(ss.str(), snowcrash::MSONError, sourceMap);
             return;
         }
@@ -380,8 +385,7 @@ namespace mson
                 if (foundTypeSpecification) {
 
                     // WARN: Ignoring unrecognized type attribute
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                     report.warnings.push_back(snowcrash::Warning(
                         "ignoring unrecognized type attribute", snowcrash::IgnoringWarning, sourceMap));
                 } else {
@@ -412,8 +416,7 @@ namespace mson
             && !typeDefinition.typeSpecification.nestedTypes.empty()) {
 
             // WARN: Nested types for non (array or enum) structure base type
-            mdp::CharactersRangeSet sourceMap
-                = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+            const mdp::BytesRangeSet& sourceMap = node->sourceMap;
             report.warnings.push_back(
                 snowcrash::Warning("nested types should be present only for types which are sub typed from either "
                                    "array or enum structure type",
@@ -94,8 +94,7 @@ namespace snowcrash
             if (!isSameBaseType(baseType, mixin.node.baseType)) {
 
                 // WARN: Mixin base type should be compatible with the parent base type
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 sections.report.warnings.push_back(
                     Warning("mixin base type should be the same as parent base type. objects should contain object "
                             "mixins. arrays should contain array mixins",
@@ -113,8 +112,7 @@ namespace snowcrash
             if (baseType != mson::ObjectBaseType && baseType != mson::ImplicitObjectBaseType) {
 
                 // WARN: One of can not be a nested member for a non object structure type
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 sections.report.warnings.push_back(Warning(
                     "one of may be a nested member of a object sub-types only", LogicalErrorWarning, sourceMap));
 
@@ -146,8 +144,7 @@ namespace snowcrash
                     // e.g
                     // - a (array)
                     //   - key (object)
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                     sections.report.warnings.push_back(
                         Warning("array member definition of type 'object' contains value. You should use type "
                                 "definition without value eg. '- (object)'",
@@ -172,8 +169,7 @@ namespace snowcrash
                     // WARN: object definition contain value
                     // e.g
                     // - key: value (object)
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                     sections.report.warnings.push_back(
                         Warning("'object' with value definition. You should use type definition without value eg. '- "
                                 "key (object)'",
@@ -187,15 +183,13 @@ namespace snowcrash
             } else if (baseType == mson::PrimitiveBaseType || baseType == mson::ImplicitPrimitiveBaseType) {
 
                 // WARN: Primitive type members should not have nested members
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 sections.report.warnings.push_back(Warning(
                     "sub-types of primitive types should not have nested members", LogicalErrorWarning, sourceMap));
             } else {
 
                 // WARN: Ignoring unrecognized block in mson nested members
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 sections.report.warnings.push_back(Warning("ignoring unrecognized block", IgnoringWarning, sourceMap));
 
                 cur = ++MarkdownNodeIterator(node);
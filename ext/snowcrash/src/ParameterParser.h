@@ -145,8 +145,7 @@ namespace snowcrash
                 ss << "overshadowing previous 'values' definition";
                 ss << " for parameter '" << out.node.name << "'";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), RedefinitionWarning, sourceMap));
             }
 
@@ -165,8 +164,7 @@ namespace snowcrash
                 std::stringstream ss;
                 ss << "no possible values specified for parameter '" << out.node.name << "'";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), EmptyDefinitionWarning, sourceMap));
             }
 
@@ -307,8 +305,7 @@ namespace snowcrash
             ss << "unable to parse additional parameter traits";
             ss << (oldSyntax ? OldSyntaxAdditionalTraitsWarning : NewSyntaxAdditionalTraitsWarning);
 
-            mdp::CharactersRangeSet sourceMap
-                = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+            const mdp::BytesRangeSet& sourceMap = node->sourceMap;
             out.report.warnings.push_back(Warning(ss.str(), FormattingWarning, sourceMap));
 
             out.node.type.clear();
@@ -343,8 +340,7 @@ namespace snowcrash
                    << "' as required supersedes its default value"
                       ", declare the parameter as 'optional' to specify its default value";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), LogicalErrorWarning, sourceMap));
             }
         }
@@ -393,8 +389,7 @@ namespace snowcrash
             }
 
             if (printWarning) {
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), LogicalErrorWarning, sourceMap));
             }
         }
@@ -53,8 +53,7 @@ namespace snowcrash
                 ss << "ignoring additional content after 'parameters' keyword,";
                 ss << " expected a nested list of parameters, one parameter per list item";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), IgnoringWarning, sourceMap));
             }
 
@@ -96,8 +95,7 @@ namespace snowcrash
                     std::stringstream ss;
                     ss << "overshadowing previous parameter '" << parameter.node.name << "' definition";
 
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                     out.report.warnings.push_back(Warning(ss.str(), RedefinitionWarning, sourceMap));
                 }
             }
@@ -142,8 +140,7 @@ namespace snowcrash
             if (out.node.empty()) {
 
                 // WARN: No parameters defined
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(NoParametersMessage, FormattingWarning, sourceMap));
             }
         }
@@ -217,8 +214,7 @@ namespace snowcrash
                     ss << " for '" << out.node.name << "' ";
                 }
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), LogicalErrorWarning, sourceMap));
             }
         }
@@ -69,8 +69,7 @@ namespace snowcrash
             if (out.node.name.empty()
                 && (pd.sectionContext() == ResponseSectionType || pd.sectionContext() == ResponseBodySectionType)) {
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(
                     "missing response HTTP status code, assuming 'Response 200'", EmptyDefinitionWarning, sourceMap));
                 out.node.name = "200";
@@ -111,8 +110,6 @@ namespace snowcrash
             const ParseResultRef<Payload>& out)
         {
 
-            mdp::ByteBuffer content;
-
             if (!out.node.reference.id.empty()) {
                 // WARN: ignoring extraneous content after model reference
                 std::stringstream ss;
@@ -120,8 +117,7 @@ namespace snowcrash
                 ss << "ignoring extraneous content after model reference";
                 ss << ", expected model reference only e.g. '[" << out.node.reference.id << "][]'";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), IgnoringWarning, sourceMap));
             } else {
 
@@ -131,12 +127,11 @@ namespace snowcrash
                     // NOTE: NOT THE CORRECT WAY TO DO THIS
                     // https://github.com/apiaryio/snowcrash/commit/a7c5868e62df0048a85e2f9aeeb42c3b3e0a2f07#commitcomment-7322085
                     pd.sectionsContext.push_back(BodySectionType);
-                    CodeBlockUtility::contentAsCodeBlock(node, pd, out.report, content);
+                    const size_t length = out.node.body.length();
+                    CodeBlockUtility::contentAsCodeBlock(node, pd, out.report, out.node.body);
                     pd.sectionsContext.pop_back();
 
-                    out.node.body += content;
-
-                    if (pd.exportSourceMap() && !content.empty()) {
+                    if (pd.exportSourceMap() && out.node.body.length() != length) {
                         out.sourceMap.body.sourceMap.append(node->sourceMap);
                     }
                 }
@@ -165,8 +160,7 @@ namespace snowcrash
                 case ParametersSectionType: {
                     if (pd.parentSectionContext() != RequestSectionType) {
                         // WARN: Only request section can have parameters section
-                        mdp::CharactersRangeSet sourceMap
-                            = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                        const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                         out.report.warnings.push_back(
                             Warning("ignoring parameters section in a non request payload section",
                                 IgnoringWarning,
@@ -182,8 +176,7 @@ namespace snowcrash
                 case BodySectionType: {
                     if (!out.node.body.empty()) {
                         // WARN: Multiple body section
-                        mdp::CharactersRangeSet sourceMap
-                            = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                        const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                         out.report.warnings.push_back(
                             Warning("ignoring additional 'body' content, it is already defined",
                                 RedefinitionWarning,
@@ -197,8 +190,7 @@ namespace snowcrash
                 case SchemaSectionType: {
                     if (!out.node.schema.empty()) {
                         // WARN: Multiple schema section
-                        mdp::CharactersRangeSet sourceMap
-                            = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                        const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                         out.report.warnings.push_back(
                             Warning("ignoring additional 'schema' content, it is already defined",
                                 RedefinitionWarning,
@@ -226,10 +218,9 @@ namespace snowcrash
             if ((node->type == mdp::ParagraphMarkdownNodeType || node->type == mdp::CodeMarkdownNodeType)
                 && sectionType == BodySectionType) {
 
-                mdp::ByteBuffer content
-                    = CodeBlockUtility::addDanglingAsset(node, pd, sectionType, out.report, out.node.body);
+                CodeBlockUtility::addDanglingAsset(node, pd, sectionType, out.report, out.node.body);
 
-                if (pd.exportSourceMap() && !content.empty()) {
+                if (pd.exportSourceMap()) {
                     out.sourceMap.body.sourceMap.append(node->sourceMap);
                 }
 
@@ -459,8 +450,7 @@ namespace snowcrash
                             return false;
                     }
 
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                     out.report.warnings.push_back(Warning(ss.str(), FormattingWarning, sourceMap));
 
                     return false;
@@ -531,6 +521,11 @@ namespace snowcrash
 
                     out.node.reference.meta.state = Reference::StatePending;
 
+                    // The model may be defined by a slice parsed concurrently
+                    if (pd.concurrent) {
+                        pd.pendingModelReferences.push_back(symbol);
+                    }
+
                     return true;
                 }
 
@@ -573,8 +568,7 @@ namespace snowcrash
                 ss << "ignoring additional " << SectionName(pd.sectionContext()) << " header(s), ";
                 ss << "specify this header(s) in the referenced model definition instead";
 
-                mdp::CharactersRangeSet sourceMap = mdp::BytesRangeSetToCharactersRangeSet(
-                    out.node.reference.meta.node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = out.node.reference.meta.node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), IgnoringWarning, sourceMap));
             }
 
@@ -656,8 +650,7 @@ namespace snowcrash
                            << "' Transfer-Encoding";
                     }
 
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                     out.report.warnings.push_back(Warning(ss.str(), EmptyDefinitionWarning, sourceMap));
                 }
             }
@@ -688,8 +681,7 @@ namespace snowcrash
                 std::stringstream ss;
                 ss << "the " << code << " response MUST NOT include a " << SectionName(BodySectionType);
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), EmptyDefinitionWarning, sourceMap));
             }
         }
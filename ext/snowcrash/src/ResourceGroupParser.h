@@ -121,8 +121,7 @@ namespace snowcrash
                 if (duplicate || globalDuplicate) {
 
                     // WARN: Duplicate resource
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                     out.report.warnings.push_back(
                         Warning("the resource '" + resource.node.uriTemplate + "' is already defined",
                             DuplicateWarning,
@@ -159,8 +158,7 @@ namespace snowcrash
                 mdp::ByteBuffer method, name, uriTemplate;
 
                 SectionProcessor<Action>::actionHTTPMethodAndName(node, method, name, uriTemplate);
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
 
                 // WARN: Unexpected action
                 std::stringstream ss;
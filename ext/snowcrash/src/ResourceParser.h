@@ -123,8 +123,7 @@ namespace snowcrash
                             std::stringstream ss;
                             ss << "named type with name '" << out.node.name << "' already exists";
 
-                            mdp::CharactersRangeSet sourceMap
-                                = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                            const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                             out.report.warnings.push_back(Warning(ss.str(), DuplicateWarning, sourceMap));
 
                             // Remove the attributes data from the AST since we are ignoring this
@@ -160,10 +159,9 @@ namespace snowcrash
             if ((node->type == mdp::ParagraphMarkdownNodeType || node->type == mdp::CodeMarkdownNodeType)
                 && (sectionType == ModelBodySectionType || sectionType == ModelSectionType)) {
 
-                mdp::ByteBuffer content
-                    = CodeBlockUtility::addDanglingAsset(node, pd, sectionType, out.report, out.node.model.body);
+                CodeBlockUtility::addDanglingAsset(node, pd, sectionType, out.report, out.node.model.body);
 
-                if (pd.exportSourceMap() && !content.empty()) {
+                if (pd.exportSourceMap()) {
                     out.sourceMap.model.body.sourceMap.append(node->sourceMap);
                 }
 
@@ -276,8 +274,7 @@ namespace snowcrash
 
                 URITemplateParser uriTemplateParser;
                 ParsedURITemplate parsedResult;
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
 
                 uriTemplateParser.parse(out.node.uriTemplate, sourceMap, parsedResult);
 
@@ -368,8 +365,7 @@ namespace snowcrash
                 ss << "action with method '" << action.node.method << "' already defined for resource '";
                 ss << out.node.uriTemplate << "'";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), DuplicateWarning, sourceMap));
             }
 
@@ -383,8 +379,7 @@ namespace snowcrash
                 ss << "relation identifier '" << action.node.relation.str << "' already defined for resource '"
                    << out.node.uriTemplate << "'";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), DuplicateWarning, sourceMap));
             }
 
@@ -453,8 +448,7 @@ namespace snowcrash
 
                 ss << "' resource, a resource can be represented by a single model only";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.warnings.push_back(Warning(ss.str(), DuplicateWarning, sourceMap));
             }
 
@@ -473,8 +467,7 @@ namespace snowcrash
                     ss << "resource model can be specified only for a named resource";
                     ss << ", name your resource, e.g. '# <resource name> [" << out.node.uriTemplate << "]'";
 
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                     out.report.error = Error(ss.str(), ModelError, sourceMap);
                 }
             }
@@ -494,8 +487,7 @@ namespace snowcrash
                 std::stringstream ss;
                 ss << "symbol '" << model.node.name << "' already defined";
 
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                 out.report.error = Error(ss.str(), ModelError, sourceMap);
             }
 
@@ -99,15 +99,29 @@ namespace snowcrash
             const ParseResultRef<T>& out)
         {
 
+            SectionProcessor<T>::preprocessNestedSections(node, collection, pd, out);
+
+            return parseNestedSectionRange(node, collection.end(), collection, pd, out);
+        }
+
+        /** Parse nested sections preceding `end` */
+        static MarkdownNodeIterator parseNestedSectionRange(const MarkdownNodeIterator& node,
+            const MarkdownNodes::const_iterator& end,
+            const MarkdownNodes& collection,
+            SectionParserData& pd,
+            const ParseResultRef<T>& out)
+        {
+
             MarkdownNodeIterator cur = node;
             MarkdownNodeIterator lastCur = cur;
 
             SectionType lastSectionType = UndefinedSectionType;
 
-            SectionProcessor<T>::preprocessNestedSections(node, collection, pd, out);
-
             // Nested sections
-            while (cur != collection.end()) {
+            while (cur != end && cur != collection.end()) {
+
+                if (pd.monitor)
+                    pd.monitor->check(cur, collection);
 
                 lastCur = cur;
                 SectionType nestedType = SectionProcessor<T>::nestedSectionType(cur);
@@ -147,8 +161,7 @@ namespace snowcrash
         {
             if (seed->type != mdp::HeaderMarkdownNodeType) {
                 // ERR: Expected header
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(seed->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = seed->sourceMap;
                 throw Error("expected header block, e.g. '# <text>'", BusinessError, sourceMap);
             }
 
@@ -187,8 +200,7 @@ namespace snowcrash
         {
             if (seed->type != mdp::ListItemMarkdownNodeType) {
                 // ERR: Expected list item
-                mdp::CharactersRangeSet sourceMap
-                    = mdp::BytesRangeSetToCharactersRangeSet(seed->sourceMap, pd.sourceCharacterIndex);
+                const mdp::BytesRangeSet& sourceMap = seed->sourceMap;
                 throw Error("expected list item block, e.g. '+ <text>'", BusinessError, sourceMap);
             }
 
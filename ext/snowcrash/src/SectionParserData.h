@@ -9,6 +9,8 @@
 #ifndef SNOWCRASH_SECTIONPARSERDATA_H
 #define SNOWCRASH_SECTIONPARSERDATA_H
 
+#include <functional>
+
 #include "ModelTable.h"
 #include "BlueprintSourcemap.h"
 #include "Section.h"
@@ -25,11 +27,66 @@ namespace snowcrash
     {
         RenderDescriptionsOption = (1 << 0),   /// < Render Markdown in description.
         RequireBlueprintNameOption = (1 << 1), /// < Treat missing blueprint name as error
-        ExportSourcemapOption = (1 << 2)       /// < Export source maps AST
+        ExportSourcemapOption = (1 << 2),      /// < Export source maps AST
+        ParallelParseOption = (1 << 3)         /// < Parse top-level groups concurrently, \see TaskRunner
     };
 
     typedef unsigned int BlueprintParserOptions;
 
+    /**
+     *  \brief Named type dependency to be added later
+     *
+     *  Slices of top-level groups parsed concurrently do not touch the shared
+     *  dependency table, they record the dependencies in document order instead.
+     */
+    struct DeferredDependency {
+        mdp::MarkdownNodeIterator node;
+        mson::Literal dependency;
+        mson::Literal dependent;
+        bool circularCheck;
+    };
+
+    typedef std::vector<DeferredDependency> DeferredDependencies;
+
+    /**
+     *  \brief Monitor of a running parse
+     *
+     *  Checked before every nested section `node` of `collection`, also by
+     *  parsers of top-level groups running concurrently. Top-level sections
+     *  are the nodes without a grandparent. Throws snowcrash::Error to stop
+     *  the parse.
+     */
+    class ParseMonitor
+    {
+    public:
+        virtual void check(const mdp::MarkdownNodeIterator& node, const mdp::MarkdownNodes& collection) const = 0;
+
+    protected:
+        ~ParseMonitor()
+        {
+        }
+    };
+
+    /**
+     *  \brief Runner of concurrent tasks of a parse
+     *
+     *  Supplied by the application, so that the parser shares its threads.
+     *  Without a runner top-level groups are parsed serially.
+     */
+    class TaskRunner
+    {
+    public:
+        typedef std::function<void(size_t)> Task;
+
+        /** Run `task(i)` for every `i` in `[0, count)` and wait for all of them, tasks do not throw */
+        virtual void run(size_t count, const Task& task) const = 0;
+
+    protected:
+        ~TaskRunner()
+        {
+        }
+    };
+
     /**
      *  \brief Section Parser Data
      *
@@ -37,13 +94,43 @@ namespace snowcrash
      */
     struct SectionParserData {
         SectionParserData(BlueprintParserOptions opts, const mdp::ByteBuffer& src, const Blueprint& bp)
-            : options(opts), sourceData(src), blueprint(bp)
+            : options(opts),
+              monitor(NULL),
+              runner(NULL),
+              concurrent(false),
+              sourceData(src),
+              blueprint(bp)
+        {
+        }
+
+        /**
+         *  \brief Parser data of a slice of top-level groups parsed concurrently
+         *
+         *  Shares the source with `pd` and copies its named type tables,
+         *  except for the dependency table as dependencies are deferred.
+         */
+        SectionParserData(const SectionParserData& pd, const Blueprint& bp)
+            : options(pd.options),
+              monitor(pd.monitor),
+              runner(NULL),
+              namedTypeBaseTable(pd.namedTypeBaseTable),
+              namedTypeInheritanceTable(pd.namedTypeInheritanceTable),
+              concurrent(true),
+              sourceData(pd.sourceData),
+              blueprint(bp),
+              sectionsContext(pd.sectionsContext)
         {
         }
 
         /** Parser Options */
         BlueprintParserOptions options;
 
+        /** Monitor of the parse, if any */
+        const ParseMonitor* monitor;
+
+        /** Runner of concurrent tasks, if any */
+        const TaskRunner* runner;
+
         /** Named Types */
         std::vector<mson::NamedType> msonTypesTable;
 
@@ -59,6 +146,15 @@ namespace snowcrash
         /** Variable to store the current named type */
         mson::Literal namedTypeContext;
 
+        /** Parsing a slice of top-level groups concurrently with other slices */
+        bool concurrent;
+
+        /** Named type dependencies deferred while parsing concurrently */
+        DeferredDependencies deferredDependencies;
+
+        /** Model references left pending while parsing concurrently */
+        std::vector<Identifier> pendingModelReferences;
+
         /** Model Table */
         ModelTable modelTable;
 
@@ -68,9 +164,6 @@ namespace snowcrash
         /** Source Data */
         const mdp::ByteBuffer& sourceData;
 
-        /** Source - map of bytes to character position - performance optimization */
-        mdp::ByteBufferCharacterIndex sourceCharacterIndex;
-
         /** AST being parsed **/
         const Blueprint& blueprint;
 
@@ -221,8 +221,7 @@ namespace snowcrash
 
             // WARN: Ignoring unexpected node
             std::stringstream ss;
-            mdp::CharactersRangeSet sourceMap
-                = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+            const mdp::BytesRangeSet& sourceMap = node->sourceMap;
 
             if (node->type == mdp::HeaderMarkdownNodeType) {
                 ss << "unexpected header block, expected a group, resource or an action definition";
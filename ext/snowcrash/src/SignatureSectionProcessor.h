@@ -94,8 +94,7 @@ namespace scpl
                 if (signature.identifier.empty()) {
 
                     // WARN: Empty identifier
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                     report.warnings.push_back(
                         snowcrash::Warning("no identifier specified", snowcrash::EmptyDefinitionWarning, sourceMap));
                 }
@@ -116,8 +115,7 @@ namespace scpl
                     if (signature.values.empty()) {
 
                         // WARN: Empty values
-                        mdp::CharactersRangeSet sourceMap
-                            = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                        const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                         report.warnings.push_back(
                             snowcrash::Warning("no value(s) specified", snowcrash::EmptyDefinitionWarning, sourceMap));
                     }
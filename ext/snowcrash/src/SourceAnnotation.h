@@ -58,7 +58,7 @@ namespace snowcrash
          */
         SourceAnnotation(const std::string& message,
             int code = OK,
-            const mdp::CharactersRangeSet& location = mdp::CharactersRangeSet())
+            const mdp::BytesRangeSet& location = mdp::BytesRangeSet())
         {
 
             this->message = message;
@@ -86,8 +86,12 @@ namespace snowcrash
             return *this;
         }
 
-        /** The location of this annotation within the source data buffer. */
-        mdp::CharactersRangeSet location;
+        /**
+         *  The location of this annotation within the source data buffer.
+         *
+         *  Byte ranges, \see snowcrash::locateAnnotations() for character ranges.
+         */
+        mdp::BytesRangeSet location;
 
         /** An annotation code. */
         int code;
@@ -110,7 +114,9 @@ namespace snowcrash
         ApplicationError = 1,
         BusinessError = 2,
         ModelError = 3,
-        MSONError = 4
+        MSONError = 4,
+        LimitError = 5,    /// < A resource limit of the parse has been exceeded
+        CancelledError = 6 /// < The parse has been cancelled
     };
 
     /**
@@ -217,6 +217,30 @@ namespace snowcrash
         }
     };
 
+    /**
+     *  \brief  hash string case insensitive - counterpart of IEqual<std::string>
+     *          for use in hashed containers
+     */
+    struct IHash {
+        size_t operator()(const std::string& s) const
+        {
+            // FNV-1a over ASCII lowercased characters
+            size_t hash = 2166136261u;
+
+            for (std::string::const_iterator it = s.begin(); it != s.end(); ++it) {
+                unsigned char c = static_cast<unsigned char>(*it);
+
+                if (c >= 'A' && c <= 'Z') {
+                    c += 'a' - 'A';
+                }
+
+                hash = (hash ^ c) * 16777619u;
+            }
+
+            return hash;
+        }
+    };
+
     /**
      * \brief Retrieve the string enclosed by the given matching escaping characters
      *
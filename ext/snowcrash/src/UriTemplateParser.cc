@@ -5,211 +5,292 @@
 //  Created by Carl Griffiths on 24/02/14.
 //  Copyright (c) 2014 Apiary Inc. All rights reserved.
 //
-#include <iomanip>
+#include <cstring>
+#include <sstream>
 #include "UriTemplateParser.h"
-#include "RegexMatch.h"
 
 using namespace snowcrash;
 
-static bool HasMismatchedCurlyBrackets(const URITemplate& uriTemplate)
+namespace
 {
-    int openCount = 0;
-    int closeCount = 0;
-
-    for (unsigned int i = 0; i < uriTemplate.length(); i++) {
-        if (uriTemplate[i] == '{')
-            openCount++;
-        if (uriTemplate[i] == '}')
-            closeCount++;
+    // The first matching scheme wins, as it did with the former `(http|https|ftp|file)` regex. Note `https` is
+    // shadowed by `http` so an `https://` prefix leaves `s:` as the host and the actual host in the path.
+    const char* const SupportedSchemes[] = { "http", "https", "ftp", "file" };
+
+    const char* const SchemeSeparator = "://";
+
+    /**
+    *  \brief Span of an expression within the URI template path.
+    */
+    struct ExpressionSpan {
+        size_t begin;
+        size_t length;
+    };
+
+    typedef std::vector<ExpressionSpan> ExpressionSpans;
+
+    /** \return Length of the supported scheme prefix of `uri` */
+    size_t SchemeLength(const char* uri, size_t length)
+    {
+        for (size_t i = 0; i < sizeof(SupportedSchemes) / sizeof(SupportedSchemes[0]); ++i) {
+            size_t schemeLength = ::strlen(SupportedSchemes[i]);
+            if (schemeLength <= length && ::strncmp(uri, SupportedSchemes[i], schemeLength) == 0)
+                return schemeLength;
+        }
+
+        return 0;
     }
-    return openCount != closeCount;
-}
 
-static bool HasNestedCurlyBrackets(const URITemplate& uriTemplate)
-{
-    char lastBracket = ' ';
-    bool result = false;
+    /** \return True if `c` may be a part of a variable name */
+    bool IsVariableNameChar(char c)
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == ','
+            || c == '.' || c == '|';
+    }
 
-    for (unsigned int i = 0; i < uriTemplate.length(); i++) {
-        if (uriTemplate[i] == '{') {
-            if (lastBracket == '{') {
-                result = true;
-                break;
-            }
-            lastBracket = '{';
-        }
-        if (uriTemplate[i] == '}') {
-            if (lastBracket == '}') {
-                result = true;
-                break;
-            }
-            lastBracket = '}';
+    /** \return True if `c` may be a part of a percent encoded triplet */
+    bool IsPercentEncodedChar(char c)
+    {
+        return (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f') || (c >= '0' && c <= '9') || c == '|';
+    }
+
+    /** \return True if `c` is an operator allowed to prefix a valid expression name */
+    bool IsNamePrefixOperator(char c)
+    {
+        return c == '?' || c == '#' || c == '+' || c == '&' || c == '|';
+    }
+
+    ExpressionType ExpressionTypeForOperator(const char* expression, size_t length)
+    {
+        if (length == 0)
+            return VariableExpressionType;
+
+        switch (expression[0]) {
+            case '?':
+                return QueryStringExpressionType;
+            case '#':
+                return FragmentExpressionType;
+            case '+':
+                return ReservedExpansionExpressionType;
+            case '.':
+                return LabelExpansionExpressionType;
+            case '/':
+                return PathSegmentExpansionExpressionType;
+            case ';':
+                return PathStyleParameterExpansionExpressionType;
+            case '&':
+                return FormStyleQueryContinuationExpressionType;
+            case '|':
+                return UndefinedExpressionType;
+            default:
+                return VariableExpressionType;
         }
     }
-    return result;
+
+    void AppendExpressionWarning(const char* expression,
+        size_t length,
+        const char* issue,
+        const mdp::BytesRangeSet& sourceBlock,
+        Report& report)
+    {
+        std::stringstream ss;
+        ss << "URI template expression \"";
+        ss.write(expression, length);
+        ss << "\" contains " << issue
+           << ". Allowed characters for expressions are A-Z a-z 0-9 _ and percent encoded characters";
+        report.warnings.push_back(Warning(ss.str(), URIWarning, sourceBlock));
+    }
 }
 
-static bool PathContainsSquareBrackets(const URITemplate& uriTemplate)
+bool ClassifiedExpression::IsSupportedExpressionType() const
 {
-    return (uriTemplate.find('[') != std::string::npos || uriTemplate.find(']') != std::string::npos);
+    switch (type) {
+        case VariableExpressionType:
+        case QueryStringExpressionType:
+        case FragmentExpressionType:
+        case ReservedExpansionExpressionType:
+        case FormStyleQueryContinuationExpressionType:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+const char* ClassifiedExpression::UnsupportedWarningText() const
+{
+    switch (type) {
+        case LabelExpansionExpressionType:
+            return "URI template label expansion is not supported";
+
+        // Path style parameter expansion has always been reported as path segment expansion
+        case PathSegmentExpansionExpressionType:
+        case PathStyleParameterExpansionExpressionType:
+            return "URI template path segment expansion is not supported";
+
+        case UndefinedExpressionType:
+            return "Unidentified expression";
+
+        default:
+            return "";
+    }
 }
 
-static Expressions GetUriTemplateExpressions(const URITemplate& uriTemplate)
+void snowcrash::ClassifyExpression(const char* expression, size_t length, ClassifiedExpression& result)
 {
-    Expressions expressions;
-    size_t expressionStartPos = 0;
-    size_t expressionEndPos = 0;
-
-    while (expressionStartPos != std::string::npos && expressionEndPos != std::string::npos
-        && expressionStartPos < uriTemplate.length()) {
-        expressionStartPos = uriTemplate.find("{", expressionStartPos);
-        expressionEndPos = uriTemplate.find("}", expressionStartPos);
-        if (expressionStartPos != std::string::npos && expressionEndPos > expressionStartPos) {
-            expressions.push_back(
-                uriTemplate.substr(expressionStartPos + 1, (expressionEndPos - expressionStartPos) - 1));
+    result.type = ExpressionTypeForOperator(expression, length);
+    result.flags = 0;
+
+    // A valid name is `[?#+&|]? ( [A-Za-z0-9_,.|] | %[A-Fa-f0-9|]{2} )* \*?` without `..`
+    bool validName = length > 0;
+    size_t percentEncodedRemaining = 0;
+
+    for (size_t i = 0; i < length; ++i) {
+        const char c = expression[i];
+
+        if (c == ' ')
+            result.flags |= ClassifiedExpression::SpacesFlag;
+        else if (c == '-')
+            result.flags |= ClassifiedExpression::HyphensFlag;
+        else if (c == '=')
+            result.flags |= ClassifiedExpression::AssignmentFlag;
+
+        if (!validName)
+            continue;
+
+        if (percentEncodedRemaining > 0) {
+            if (IsPercentEncodedChar(c))
+                --percentEncodedRemaining;
+            else
+                validName = false;
+        } else if (i == 0 && IsNamePrefixOperator(c)) {
+            continue;
+        } else if (c == '%') {
+            percentEncodedRemaining = 2;
+        } else if (c == '.' && i > 0 && expression[i - 1] == '.') {
+            validName = false;
+        } else if (!IsVariableNameChar(c) && !(c == '*' && i == length - 1)) {
+            validName = false;
         }
-        expressionStartPos++;
     }
-    return expressions;
+
+    if (!validName || percentEncodedRemaining > 0)
+        result.flags |= ClassifiedExpression::InvalidNameFlag;
 }
 
-static ClassifiedExpression ClassifyExpression(const Expression& expression)
+void URITemplateParser::parse(
+    const URITemplate& uri, const mdp::BytesRangeSet& sourceBlock, ParsedURITemplate& result)
 {
+    if (uri.empty())
+        return;
 
-    VariableExpression variableExpression(expression);
+    // Anything following an embedded NUL is not a part of the template
+    const char* begin = uri.c_str();
+    const size_t length = ::strlen(begin);
 
-    if (variableExpression.IsExpressionType()) {
-        return variableExpression;
-    }
+    // Split into scheme, host and path
+    size_t pos = SchemeLength(begin, length);
+    result.scheme.assign(begin, pos);
 
-    QueryStringExpression queryStringExpression(expression);
-    if (queryStringExpression.IsExpressionType()) {
-        return queryStringExpression;
-    }
+    if (length - pos >= 3 && ::strncmp(begin + pos, SchemeSeparator, 3) == 0)
+        pos += 3;
 
-    FragmentExpression fragmentExpression(expression);
-    if (fragmentExpression.IsExpressionType()) {
-        return fragmentExpression;
-    }
+    const char* slash = static_cast<const char*>(::memchr(begin + pos, '/', length - pos));
+    const size_t hostEnd = slash ? slash - begin : length;
 
-    ReservedExpansionExpression reservedExpansionExpression(expression);
-    if (reservedExpansionExpression.IsExpressionType()) {
-        return reservedExpansionExpression;
-    }
+    result.host.assign(begin + pos, hostEnd - pos);
+    result.path.assign(begin + hostEnd, length - hostEnd);
 
-    LabelExpansionExpression labelExpansionExpression(expression);
-    if (labelExpansionExpression.IsExpressionType()) {
-        return labelExpansionExpression;
-    }
+    // Scan the path for brackets and expressions
+    const std::string& path = result.path;
+    ExpressionSpans expressions;
 
-    PathSegmentExpansionExpression pathSegmentExpansionExpression(expression);
-    if (pathSegmentExpansionExpression.IsExpressionType()) {
-        return pathSegmentExpansionExpression;
-    }
+    size_t openCount = 0;
+    size_t closeCount = 0;
+    char lastBracket = ' ';
+    bool nested = false;
+    bool squareBrackets = false;
+    size_t expressionBegin = std::string::npos;
+
+    for (size_t i = 0; i < path.length(); ++i) {
+        const char c = path[i];
+
+        if (c == '[' || c == ']') {
+            squareBrackets = true;
+            continue;
+        }
+
+        if (c != '{' && c != '}')
+            continue;
 
-    PathStyleParameterExpansionExpression pathStyleParameterExpansionExpression(expression);
-    if (pathStyleParameterExpansionExpression.IsExpressionType()) {
-        return pathSegmentExpansionExpression;
+        nested = nested || lastBracket == c;
+        lastBracket = c;
+
+        if (c == '{') {
+            ++openCount;
+            expressionBegin = i + 1;
+        } else {
+            ++closeCount;
+
+            if (expressionBegin != std::string::npos) {
+                ExpressionSpan span = { expressionBegin, i - expressionBegin };
+                expressions.push_back(span);
+                expressionBegin = std::string::npos;
+            }
+        }
     }
 
-    FormStyleQueryContinuationExpression formStyleQueryContinuationExpression(expression);
-    if (formStyleQueryContinuationExpression.IsExpressionType()) {
-        return formStyleQueryContinuationExpression;
+    if (openCount != closeCount) {
+        result.report.warnings.push_back(
+            Warning("The URI template contains mismatched expression brackets", URIWarning, sourceBlock));
+        return;
     }
 
-    UndefinedExpression undefinedExpression(expression);
+    if (nested) {
+        result.report.warnings.push_back(
+            Warning("The URI template contains nested expression brackets", URIWarning, sourceBlock));
+        return;
+    }
 
-    return undefinedExpression;
-}
+    if (squareBrackets) {
+        result.report.warnings.push_back(Warning(
+            "The URI template contains square brackets, please percent encode square brackets as %5B and %5D",
+            URIWarning,
+            sourceBlock));
+    }
 
-void URITemplateParser::parse(
-    const URITemplate& uri, const mdp::CharactersRangeSet& sourceBlock, ParsedURITemplate& result)
-{
-    CaptureGroups groups;
-    Expressions expressions;
-    size_t gSize = 5;
+    // An expression opened by the last bracket of `}...{` runs to the end of the path
+    if (expressionBegin != std::string::npos) {
+        ExpressionSpan span = { expressionBegin, path.length() - expressionBegin };
+        expressions.push_back(span);
+    }
 
-    if (uri.empty())
-        return;
+    for (ExpressionSpans::const_iterator it = expressions.begin(); it != expressions.end(); ++it) {
 
-    if (RegexCapture(uri, URI_REGEX, groups, gSize)) {
-        result.scheme = groups[1];
-        result.host = groups[3];
-        result.path = groups[4];
+        const char* expression = path.data() + it->begin;
+        ClassifiedExpression classifiedExpression;
+        ClassifyExpression(expression, it->length, classifiedExpression);
 
-        if (HasMismatchedCurlyBrackets(result.path)) {
+        if (!classifiedExpression.IsSupportedExpressionType()) {
             result.report.warnings.push_back(
-                Warning("The URI template contains mismatched expression brackets", URIWarning, sourceBlock));
-            return;
+                Warning(classifiedExpression.UnsupportedWarningText(), URIWarning, sourceBlock));
+            continue;
         }
 
-        if (HasNestedCurlyBrackets(result.path)) {
-            result.report.warnings.push_back(
-                Warning("The URI template contains nested expression brackets", URIWarning, sourceBlock));
-            return;
-        }
+        if (classifiedExpression.flags & ClassifiedExpression::SpacesFlag)
+            AppendExpressionWarning(expression, it->length, "spaces", sourceBlock, result.report);
 
-        if (PathContainsSquareBrackets(result.path)) {
-            result.report.warnings.push_back(Warning(
-                "The URI template contains square brackets, please percent encode square brackets as %5B and %5D",
-                URIWarning,
-                sourceBlock));
-        }
+        if (classifiedExpression.flags & ClassifiedExpression::HyphensFlag)
+            AppendExpressionWarning(expression, it->length, "hyphens", sourceBlock, result.report);
 
-        expressions = GetUriTemplateExpressions(result.path);
-
-        ExpressionIterator currentExpression = expressions.begin();
-
-        while (currentExpression != expressions.end()) {
-
-            ClassifiedExpression classifiedExpression = ClassifyExpression(*currentExpression);
-
-            if (classifiedExpression.IsSupportedExpressionType()) {
-                bool hasIllegalCharacters = false;
-
-                if (classifiedExpression.ContainsSpaces()) {
-                    std::stringstream ss;
-                    ss << "URI template expression \"" << classifiedExpression.innerExpression
-                       << "\" contains spaces. Allowed characters for expressions are A-Z a-z 0-9 _ and percent "
-                          "encoded characters";
-                    result.report.warnings.push_back(Warning(ss.str(), URIWarning, sourceBlock));
-                    hasIllegalCharacters = true;
-                }
-
-                if (classifiedExpression.ContainsHyphens()) {
-                    std::stringstream ss;
-                    ss << "URI template expression \"" << classifiedExpression.innerExpression
-                       << "\" contains hyphens. Allowed characters for expressions are A-Z a-z 0-9 _ and percent "
-                          "encoded characters";
-                    result.report.warnings.push_back(Warning(ss.str(), URIWarning, sourceBlock));
-                    hasIllegalCharacters = true;
-                }
-
-                if (classifiedExpression.ContainsAssignment()) {
-                    std::stringstream ss;
-                    ss << "URI template expression \"" << classifiedExpression.innerExpression
-                       << "\" contains assignment. Allowed characters for expressions are A-Z a-z 0-9 _ and percent "
-                          "encoded characters";
-                    result.report.warnings.push_back(Warning(ss.str(), URIWarning, sourceBlock));
-                    hasIllegalCharacters = true;
-                }
-
-                if (!hasIllegalCharacters) {
-                    if (classifiedExpression.IsInvalidExpressionName()) {
-                        std::stringstream ss;
-                        ss << "URI template expression \"" << classifiedExpression.innerExpression
-                           << "\" contains invalid characters. Allowed characters for expressions are A-Z a-z 0-9 _ "
-                              "and percent encoded characters";
-                        result.report.warnings.push_back(Warning(ss.str(), URIWarning, sourceBlock));
-                    }
-                }
-            } else {
-                result.report.warnings.push_back(
-                    Warning(classifiedExpression.unsupportedWarningText, URIWarning, sourceBlock));
-            }
-            currentExpression++;
-        }
-    } else {
-        result.report.error = Error("Failed to parse URI Template", ApplicationError);
+        if (classifiedExpression.flags & ClassifiedExpression::AssignmentFlag)
+            AppendExpressionWarning(expression, it->length, "assignment", sourceBlock, result.report);
+
+        const unsigned int illegalCharacters = ClassifiedExpression::SpacesFlag | ClassifiedExpression::HyphensFlag
+            | ClassifiedExpression::AssignmentFlag;
+
+        if (!(classifiedExpression.flags & illegalCharacters)
+            && (classifiedExpression.flags & ClassifiedExpression::InvalidNameFlag))
+            AppendExpressionWarning(expression, it->length, "invalid characters", sourceBlock, result.report);
     }
 }
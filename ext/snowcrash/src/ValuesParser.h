@@ -57,8 +57,7 @@ namespace snowcrash
                     ss << "ignoring the '" << content << "' element";
                     ss << ", expected '`" << content << "`'";
 
-                    mdp::CharactersRangeSet sourceMap
-                        = mdp::BytesRangeSetToCharactersRangeSet(node->sourceMap, pd.sourceCharacterIndex);
+                    const mdp::BytesRangeSet& sourceMap = node->sourceMap;
                     out.report.warnings.push_back(Warning(ss.str(), IgnoringWarning, sourceMap));
                 }
 
@@ -13,6 +13,18 @@ const int snowcrash::SourceAnnotation::OK = 0;
 
 using namespace snowcrash;
 
+/**
+ *  \brief  Markdown parser of the calling thread
+ *
+ *  Sundown state and buffers of the parser are reused by all parses done
+ *  by the thread.
+ */
+static mdp::MarkdownParser& ThreadMarkdownParser()
+{
+    static thread_local mdp::MarkdownParser markdownParser;
+    return markdownParser;
+}
+
 /**
  *  \brief  Check source for unsupported character \t & \r
  *  \return True if passed (not found), false otherwise
@@ -28,7 +40,7 @@ static bool CheckSource(const mdp::ByteBuffer& source, Report& report)
         rangeSet.push_back(mdp::BytesRange(pos, 1));
         report.error = Error("the use of tab(s) '\\t' in source data isn't currently supported, please contact makers",
             BusinessError,
-            mdp::BytesRangeSetToCharactersRangeSet(rangeSet, source));
+            rangeSet);
         return false;
     }
 
@@ -41,37 +53,68 @@ static bool CheckSource(const mdp::ByteBuffer& source, Report& report)
         report.error = Error(
             "the use of carriage return(s) '\\r' in source data isn't currently supported, please contact makers",
             BusinessError,
-            mdp::BytesRangeSetToCharactersRangeSet(rangeSet, source));
+            rangeSet);
         return false;
     }
 
     return true;
 }
 
-int snowcrash::parse(
-    const mdp::ByteBuffer& source, BlueprintParserOptions options, const ParseResultRef<Blueprint>& out)
+/**
+ *  \brief Split top-level nodes of a parsed markdown into top-level sections
+ *  \see splitTopLevelSections()
+ */
+static void SplitMarkdownIntoSections(MarkdownNodes& nodes, size_t size, TopLevelSections& sections)
 {
-    try {
+    sections.clear();
+
+    TopLevelSection leading;
+    leading.range = mdp::BytesRange(0, size);
+    leading.type = UndefinedSectionType;
+    sections.push_back(leading);
+
+    for (MarkdownNodeIterator it = nodes.begin(); it != nodes.end(); ++it) {
+
+        if (it->sourceMap.empty() || !SectionProcessor<Blueprint>::isSliceBoundary(it))
+            continue;
+
+        size_t location = it->sourceMap.front().location;
+        mdp::BytesRange& previous = sections.back().range;
+
+        TopLevelSection group;
+        group.range = mdp::BytesRange(location, previous.location + previous.length - location);
+        group.type = SectionProcessor<Blueprint>::nestedSectionType(it);
+
+        previous.length = location - previous.location;
+        sections.push_back(group);
+    }
+}
+
+int snowcrash::parse(const mdp::ByteBuffer& source,
+    BlueprintParserOptions options,
+    const ParseResultRef<Blueprint>& out,
+    TopLevelSections* sections,
+    const ParseMonitor* monitor,
+    const TaskRunner* runner)
+{
+    mdp::MarkdownNode markdownAST;
 
-        // Sanity Check
-        if (!CheckSource(source, out.report))
-            return out.report.error.code;
+    try {
 
-        // Do nothing if blueprint is empty
-        if (source.empty())
-            return out.report.error.code;
+        // Sanity Check, do nothing if blueprint is empty
+        if (CheckSource(source, out.report) && !source.empty()) {
 
-        // Parse Markdown
-        mdp::MarkdownParser markdownParser;
-        mdp::MarkdownNode markdownAST;
-        markdownParser.parse(source, markdownAST);
+            // Parse Markdown
+            ThreadMarkdownParser().parse(source, markdownAST);
 
-        // Build SectionParserData
-        SectionParserData pd(options, source, out.node);
-        mdp::BuildCharacterIndex(pd.sourceCharacterIndex, source);
+            // Build SectionParserData
+            SectionParserData pd(options, source, out.node);
+            pd.monitor = monitor;
+            pd.runner = runner;
 
-        // Parse Blueprint
-        BlueprintParser::parse(markdownAST.children().begin(), markdownAST.children(), pd, out);
+            // Parse Blueprint
+            BlueprintParser::parse(markdownAST.children().begin(), markdownAST.children(), pd, out);
+        }
     } catch (const Error& e) {
         out.report.error = e;
     } catch (const std::exception& e) {
@@ -83,5 +126,34 @@ int snowcrash::parse(
         out.report.error = Error("parser exception has occurred", ApplicationError);
     }
 
+    if (sections) {
+        SplitMarkdownIntoSections(markdownAST.children(), source.size(), *sections);
+    }
+
     return out.report.error.code;
 }
+
+std::vector<mdp::CharactersRangeSet> snowcrash::locateAnnotations(const Report& report, const mdp::ByteBuffer& source)
+{
+    std::vector<const mdp::BytesRangeSet*> locations;
+    locations.reserve(report.warnings.size() + 1);
+
+    locations.push_back(&report.error.location);
+
+    for (Warnings::const_iterator it = report.warnings.begin(); it != report.warnings.end(); ++it) {
+        locations.push_back(&it->location);
+    }
+
+    return mdp::BytesRangeSetsToCharactersRangeSets(locations, source);
+}
+
+void snowcrash::splitTopLevelSections(const mdp::ByteBuffer& source, TopLevelSections& sections)
+{
+    mdp::MarkdownNode markdownAST;
+
+    if (!source.empty()) {
+        ThreadMarkdownParser().parse(source, markdownAST);
+    }
+
+    SplitMarkdownIntoSections(markdownAST.children(), source.size(), sections);
+}
@@ -29,15 +29,69 @@
 namespace snowcrash
 {
 
+    /**
+     *  \brief Top-level section of a blueprint
+     *
+     *  Either a resource group, a data structure group or the content
+     *  preceding the first group.
+     */
+    struct TopLevelSection {
+
+        /** Byte range of the section in the source data */
+        mdp::BytesRange range;
+
+        /** Group section type or UndefinedSectionType for the leading content */
+        SectionType type;
+    };
+
+    /** Top-level sections in document order */
+    typedef std::vector<TopLevelSection> TopLevelSections;
+
     /**
      *  \brief Parse the source data into a blueprint abstract source tree (AST).
      *
+     *  Annotations of the report are located by byte ranges,
+     *  \see locateAnnotations() to convert them to character ranges.
+     *
      *  \param source       A textual source data to be parsed.
      *  \param options      Parser options. Use 0 for no additional options.
      *  \param out          Output buffer to store parsing result into.
+     *  \param sections     Optional output buffer to store top-level sections of the source into,
+     *                      split by the same markdown parse, \see splitTopLevelSections().
+     *  \param monitor      Optional monitor checked while parsing, \see ParseMonitor.
+     *  \param runner       Optional runner of concurrent tasks of ParallelParseOption, \see TaskRunner.
      *  \return Error status code. Zero represents success, non-zero a failure.
      */
-    int parse(const mdp::ByteBuffer& source, BlueprintParserOptions options, const ParseResultRef<Blueprint>& out);
+    int parse(const mdp::ByteBuffer& source,
+        BlueprintParserOptions options,
+        const ParseResultRef<Blueprint>& out,
+        TopLevelSections* sections = NULL,
+        const ParseMonitor* monitor = NULL,
+        const TaskRunner* runner = NULL);
+
+    /**
+     *  \brief Locate annotations of a report by characters.
+     *
+     *  Parsers locate annotations by byte ranges, converting them is
+     *  deferred until the annotations are serialized or printed. All the
+     *  locations are then converted by a single pass over the source.
+     *
+     *  \param report       Report with annotations located by bytes.
+     *  \param source       Source data the report belongs to.
+     *  \return Character ranges of the error followed by those of each warning.
+     */
+    std::vector<mdp::CharactersRangeSet> locateAnnotations(const Report& report, const mdp::ByteBuffer& source);
+
+    /**
+     *  \brief Split the source data into top-level sections.
+     *
+     *  Sections cover the whole source data, the first one is the content
+     *  preceding the first group and it is empty if there is no such content.
+     *
+     *  \param source       A textual source data to be split.
+     *  \param sections     Output buffer to store the sections into.
+     */
+    void splitTopLevelSections(const mdp::ByteBuffer& source, TopLevelSections& sections);
 }
 
 #endif
@@ -0,0 +1,98 @@
+//
+//  perf-uritemplate.cc
+//  snowcrash
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include "UriTemplateParser.h"
+
+static const int TestRunCount = 100;
+static const int TemplateCount = 5000;
+
+/**
+ *  \brief  Build a set of URI templates covering all expression types
+ *  \param  templates   Generated URI templates.
+ */
+static void buildTemplates(std::vector<snowcrash::URITemplate>& templates)
+{
+    const char* const expressions[] = { "{id}",
+        "{?page,per_page}",
+        "{#section}",
+        "{+path}",
+        "{&filter*}",
+        "{.format}",
+        "{/segment}",
+        "{;matrix}",
+        "{?query%20string}",
+        "{var-name}",
+        "{a..b}" };
+    const size_t expressionCount = sizeof(expressions) / sizeof(expressions[0]);
+
+    for (int i = 0; i < TemplateCount; ++i) {
+        std::stringstream ss;
+
+        if (i % 3 == 0)
+            ss << "http://api.example.com";
+
+        ss << "/resources" << i % 17 << "/" << expressions[i % expressionCount] << "/items"
+           << expressions[(i / expressionCount) % expressionCount];
+
+        templates.push_back(ss.str());
+    }
+}
+
+/**
+ *  \brief  Parse all templates @TestRunCount -times
+ *  \param  templates   URI templates to parse.
+ *  \param  total       Total time spent parsing (s).
+ *  \param  mean        Mean time spent parsing all templates (s).
+ *  \param  stddev      Standard deviation.
+ *  \return Total number of warnings of a single run.
+ */
+static size_t testfunc(const std::vector<snowcrash::URITemplate>& templates, double& total, double& mean, double& stddev)
+{
+    double sum = 0, sum2 = 0;
+    size_t warnings = 0;
+    mdp::BytesRangeSet sourceBlock;
+
+    for (int i = 0; i < TestRunCount; ++i) {
+        warnings = 0;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (std::vector<snowcrash::URITemplate>::const_iterator it = templates.begin(); it != templates.end(); ++it) {
+            snowcrash::ParsedURITemplate result;
+            snowcrash::URITemplateParser::parse(*it, sourceBlock, result);
+            warnings += result.report.warnings.size();
+        }
+
+        double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        sum += t;
+        sum2 += t * t;
+    }
+
+    total = sum;
+    mean = sum / TestRunCount;
+    stddev = std::sqrt((sum2 / TestRunCount) - (mean * mean));
+    return warnings;
+}
+
+int main()
+{
+    std::vector<snowcrash::URITemplate> templates;
+    buildTemplates(templates);
+
+    std::cout << "running URI template parser performance test...\n";
+
+    double mean = 0, total = 0, stddev = 0;
+    size_t warnings = testfunc(templates, total, mean, stddev);
+
+    std::cout << "parsing " << templates.size() << " URI templates " << TestRunCount << "-times (" << warnings
+              << " warnings):\n";
+    std::cout << "total: " << total << "s mean: " << mean << " +/- " << stddev << "s\n";
+}
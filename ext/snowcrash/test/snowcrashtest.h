@@ -9,9 +9,13 @@
 #ifndef SNOWCRASH_SNOWCRASHTEST_H
 #define SNOWCRASH_SNOWCRASHTEST_H
 
+#include <thread>
+#include <vector>
+
 #include "catch.hpp"
 #include "MarkdownParser.h"
 #include "SectionParser.h"
+#include "snowcrash.h"
 
 namespace snowcrashtest
 {
@@ -28,6 +32,27 @@ namespace snowcrashtest
         mson::NamedTypeDependencyTable dependencyTable;
     };
 
+    /** Runner of every task on its own thread */
+    struct ThreadRunner : public snowcrash::TaskRunner {
+
+        virtual void run(size_t count, const Task& task) const
+        {
+            std::vector<std::thread> threads;
+
+            for (size_t i = 1; i < count; ++i) {
+                threads.push_back(std::thread(task, i));
+            }
+
+            if (count > 0) {
+                task(0);
+            }
+
+            for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it) {
+                it->join();
+            }
+        }
+    };
+
     template <typename T, typename PARSER>
     struct SectionParserHelper {
 
@@ -57,8 +82,9 @@ namespace snowcrashtest
             }
 
             snowcrash::SectionParserData pd(opts, source, bppointer->node);
-            mdp::BuildCharacterIndex(pd.sourceCharacterIndex, source);
+            ThreadRunner runner;
 
+            pd.runner = &runner;
             pd.sectionsContext.push_back(type);
 
             pd.modelTable.insert(models.modelTable.begin(), models.modelTable.end());
@@ -68,6 +94,15 @@ namespace snowcrashtest
             pd.namedTypeDependencyTable.insert(namedTypes.dependencyTable.begin(), namedTypes.dependencyTable.end());
 
             PARSER::parse(markdownAST.children().begin(), markdownAST.children(), pd, out);
+
+            // annotations are checked by the character ranges they are serialized with
+            std::vector<mdp::CharactersRangeSet> locations = snowcrash::locateAnnotations(out.report, source);
+
+            out.report.error.location = locations[0];
+
+            for (size_t i = 0; i < out.report.warnings.size(); ++i) {
+                out.report.warnings[i].location = locations[i + 1];
+            }
         }
 
         static void parseMSON(const mdp::ByteBuffer& source,
@@ -719,6 +719,62 @@ TEST_CASE("Report error when data Structure inheritance graph contains a cycle",
     SourceMapHelper::check(blueprint.report.error.location, 19, 9);
 }
 
+TEST_CASE("Resolve named type dependencies transitively", "[blueprint]")
+{
+    mdp::ByteBuffer source
+        = "# Data Structures\n"
+          "\n"
+          "## A (B)\n"
+          "## B (array[C])\n"
+          "## C (D)\n"
+          "## D (object)\n";
+
+    mdp::MarkdownParser markdownParser;
+    mdp::MarkdownNode markdownAST;
+    ParseResult<Blueprint> blueprint;
+
+    markdownParser.parse(source, markdownAST);
+    REQUIRE(!markdownAST.children().empty());
+
+    snowcrash::SectionParserData pd(ExportSourcemapOption, source, blueprint.node);
+    pd.sectionsContext.push_back(BlueprintSectionType);
+
+    BlueprintParser::parse(markdownAST.children().begin(), markdownAST.children(), pd, blueprint);
+
+    REQUIRE(blueprint.report.error.code == Error::OK);
+
+    std::set<mson::Literal> expected;
+    expected.insert("D");
+    REQUIRE(pd.namedTypeDependencyTable["C"] == expected);
+
+    expected.insert("C");
+    REQUIRE(pd.namedTypeDependencyTable["B"] == expected);
+
+    expected.insert("B");
+    REQUIRE(pd.namedTypeDependencyTable["A"] == expected);
+    REQUIRE(pd.namedTypeDependencyTable["D"].empty());
+
+    REQUIRE(pd.namedTypeBaseTable["A"] == mson::ValueBaseType);
+    REQUIRE(pd.namedTypeBaseTable["C"] == mson::ObjectBaseType);
+}
+
+TEST_CASE("Report the first named type of a cycle in alphabetical order", "[blueprint]")
+{
+    mdp::ByteBuffer source
+        = "# Data Structures\n"
+          "\n"
+          "## Z (Y)\n"
+          "## Y (M)\n"
+          "## M (Z)\n";
+
+    ParseResult<Blueprint> blueprint;
+    SectionParserHelper<Blueprint, BlueprintParser>::parse(
+        source, BlueprintSectionType, blueprint, ExportSourcemapOption);
+
+    REQUIRE(blueprint.report.error.code == MSONError);
+    REQUIRE(blueprint.report.error.message == "base type 'M' circularly referencing itself");
+}
+
 TEST_CASE("Report error when data Structure inheritance graph with only a few of them forming a cycle", "[blueprint]")
 {
     mdp::ByteBuffer source
@@ -1480,3 +1536,100 @@ TEST_CASE("Parse blueprint with escaped data structure reference", "[blueprint]"
     REQUIRE(blueprint.node.content.elements().at(0).element == Element::CategoryElement);
     REQUIRE(blueprint.node.content.elements().at(0).content.elements().size() == 1);
 }
+
+TEST_CASE("Parse resource groups concurrently", "[blueprint]")
+{
+    mdp::ByteBuffer source
+        = "# API\n"
+          "# Group First\n"
+          "## First [/first]\n"
+          "### GET\n"
+          "+ Response 200\n"
+          "\n"
+          "# Data Structures\n"
+          "## User (object)\n"
+          "+ id: 1 (number)\n"
+          "\n"
+          "## Admin (User)\n"
+          "+ admin: true (boolean)\n"
+          "\n"
+          "# Group Second\n"
+          "## Second [/second]\n"
+          "### GET\n"
+          "+ Response 200\n"
+          "    + Attributes (Admin)\n";
+
+    ParseResult<Blueprint> serial;
+    SectionParserHelper<Blueprint, BlueprintParser>::parse(
+        source, BlueprintSectionType, serial, ExportSourcemapOption, Models(), &serial);
+
+    ParseResult<Blueprint> blueprint;
+    SectionParserHelper<Blueprint, BlueprintParser>::parse(source,
+        BlueprintSectionType,
+        blueprint,
+        ExportSourcemapOption | ParallelParseOption,
+        Models(),
+        &blueprint);
+
+    REQUIRE(blueprint.report.error.code == Error::OK);
+    REQUIRE(blueprint.report.warnings.size() == serial.report.warnings.size());
+
+    REQUIRE(blueprint.node.content.elements().size() == 3);
+    REQUIRE(blueprint.node.content.elements().at(0).attributes.name == "First");
+    REQUIRE(blueprint.node.content.elements().at(1).category == Element::DataStructureGroupCategory);
+    REQUIRE(blueprint.node.content.elements().at(1).content.elements().size() == 2);
+    REQUIRE(blueprint.node.content.elements().at(2).attributes.name == "Second");
+    REQUIRE(blueprint.sourceMap.content.elements().collection.size() == 3);
+
+    const Resource& second = blueprint.node.content.elements().at(2).content.elements().at(0).content.resource;
+    REQUIRE(second.uriTemplate == "/second");
+    REQUIRE(second.actions.size() == 1);
+}
+
+TEST_CASE("Report duplicates of resource groups parsed concurrently", "[blueprint]")
+{
+    mdp::ByteBuffer source
+        = "# API\n"
+          "# Group Users\n"
+          "## Users [/users]\n"
+          "+ Model (text/plain)\n"
+          "\n"
+          "        users\n"
+          "\n"
+          "### GET\n"
+          "+ Response 200\n"
+          "\n"
+          "# Group Users\n"
+          "## Others [/users]\n"
+          "### GET\n"
+          "+ Response 200\n"
+          "\n"
+          "    [Users][]\n";
+
+    ParseResult<Blueprint> serial;
+    SectionParserHelper<Blueprint, BlueprintParser>::parse(
+        source, BlueprintSectionType, serial, ExportSourcemapOption, Models(), &serial);
+
+    ParseResult<Blueprint> blueprint;
+    SectionParserHelper<Blueprint, BlueprintParser>::parse(source,
+        BlueprintSectionType,
+        blueprint,
+        ExportSourcemapOption | ParallelParseOption,
+        Models(),
+        &blueprint);
+
+    REQUIRE(blueprint.report.error.code == serial.report.error.code);
+    REQUIRE(blueprint.report.warnings.size() == serial.report.warnings.size());
+
+    for (size_t i = 0; i < serial.report.warnings.size(); ++i) {
+        REQUIRE(blueprint.report.warnings[i].code == serial.report.warnings[i].code);
+        REQUIRE(blueprint.report.warnings[i].message == serial.report.warnings[i].message);
+    }
+
+    REQUIRE(blueprint.node.content.elements().size() == 2);
+
+    const Resource& others = blueprint.node.content.elements().at(1).content.elements().at(0).content.resource;
+    REQUIRE(others.actions.size() == 1);
+    REQUIRE(others.actions[0].examples[0].responses[0].reference.meta.state == Reference::StateResolved);
+    REQUIRE(others.actions[0].examples[0].responses[0].body == "users\n");
+}
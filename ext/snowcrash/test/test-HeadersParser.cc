@@ -476,3 +476,60 @@ TEST_CASE("Parse headers in codefences with hint", "[headers][codefence]")
     REQUIRE(headers.node[0].first == "Set-Cookie");
     REQUIRE(headers.node[0].second == "abcd");
 }
+
+TEST_CASE("Scan header line into name and value spans", "[headers]")
+{
+    HeaderLineSpans spans;
+
+    SECTION("Name and value separated by colon")
+    {
+        const mdp::ByteBuffer line = "Content-Type : application/json";
+
+        REQUIRE(ScanHeaderLine(line, spans));
+        REQUIRE(line.substr(spans.nameBegin, spans.nameLength) == "Content-Type");
+        REQUIRE(line.substr(spans.valueBegin) == "application/json");
+        REQUIRE(spans.colon);
+    }
+
+    SECTION("Missing colon")
+    {
+        const mdp::ByteBuffer line = "Set-Cookie chocolate cookie";
+
+        REQUIRE(ScanHeaderLine(line, spans));
+        REQUIRE(line.substr(spans.nameBegin, spans.nameLength) == "Set-Cookie");
+        REQUIRE(line.substr(spans.valueBegin) == "chocolate cookie");
+        REQUIRE_FALSE(spans.colon);
+    }
+
+    SECTION("Only second colon belongs to value")
+    {
+        const mdp::ByteBuffer line = "Set-Cookie :: chocolate cookie";
+
+        REQUIRE(ScanHeaderLine(line, spans));
+        REQUIRE(line.substr(spans.valueBegin) == ": chocolate cookie");
+        REQUIRE(spans.colon);
+    }
+
+    SECTION("No header name")
+    {
+        REQUIRE_FALSE(ScanHeaderLine(": value", spans));
+        REQUIRE_FALSE(ScanHeaderLine("\tname: value", spans));
+        REQUIRE_FALSE(ScanHeaderLine("", spans));
+    }
+}
+
+TEST_CASE("Duplicate headers are detected case insensitive across blocks", "[headers]")
+{
+    mdp::ByteBuffer source = "+ Headers\n\n";
+    source += "        X-Header: A\n\n";
+    source += "    x-header : B\n";
+
+    ParseResult<Headers> headers;
+    SectionParserHelper<Headers, HeadersParser>::parse(source, HeadersSectionType, headers);
+
+    REQUIRE(headers.report.error.code == Error::OK);
+    REQUIRE(headers.report.warnings.size() == 2); // not a code block, duplicate header
+    REQUIRE(headers.report.warnings[1].message == "duplicate definition of 'x-header' header");
+
+    REQUIRE(headers.node.size() == 2);
+}
@@ -6,11 +6,102 @@
 //  Copyright (c) 2014 Apiary Inc. All rights reserved.
 //
 
+#include <algorithm>
+#include <random>
 #include "catch.hpp"
 #include "UriTemplateParser.h"
+#include "RegexMatch.h"
 
 using namespace snowcrash;
 
+namespace
+{
+    /**
+    *  Regex based URI template parser the tokenizer replaced, kept as a reference
+    *  for the equivalence test. Warnings are reduced to their messages.
+    */
+    void ReferenceParse(const URITemplate& uri, ParsedURITemplate& result, std::vector<std::string>& warnings)
+    {
+        CaptureGroups groups;
+
+        if (uri.empty() || !RegexCapture(uri, "^(http|https|ftp|file)?(://)?([^/]*)?(.*)$", groups, 5))
+            return;
+
+        result.scheme = groups[1];
+        result.host = groups[3];
+        result.path = groups[4];
+
+        const std::string& path = result.path;
+        size_t open = 0, close = 0;
+        char lastBracket = ' ';
+        bool nested = false;
+
+        for (size_t i = 0; i < path.length(); ++i) {
+            if (path[i] == '{' || path[i] == '}') {
+                (path[i] == '{' ? open : close)++;
+                nested = nested || lastBracket == path[i];
+                lastBracket = path[i];
+            }
+        }
+
+        if (open != close) {
+            warnings.push_back("The URI template contains mismatched expression brackets");
+            return;
+        }
+
+        if (nested) {
+            warnings.push_back("The URI template contains nested expression brackets");
+            return;
+        }
+
+        if (path.find_first_of("[]") != std::string::npos)
+            warnings.push_back(
+                "The URI template contains square brackets, please percent encode square brackets as %5B and %5D");
+
+        for (size_t start = path.find('{'); start != std::string::npos; start = path.find('{', start + 1)) {
+            size_t end = path.find('}', start);
+            std::string expression = path.substr(start + 1, end == std::string::npos ? end : end - start - 1);
+
+            std::string op = expression.substr(0, 1);
+            if (op == "." || op == "/" || op == ";") {
+                warnings.push_back(op == "." ? "URI template label expansion is not supported" :
+                                               "URI template path segment expansion is not supported");
+                continue;
+            }
+
+            if (op == "|") {
+                warnings.push_back("Unidentified expression");
+                continue;
+            }
+
+            const char* issues[] = { " ", "spaces", "-", "hyphens", "=", "assignment" };
+            bool illegal = false;
+
+            for (size_t i = 0; i < 6; i += 2) {
+                if (expression.find(issues[i]) != std::string::npos) {
+                    warnings.push_back("URI template expression \"" + expression + "\" contains " + issues[i + 1]
+                        + ". Allowed characters for expressions are A-Z a-z 0-9 _ and percent encoded characters");
+                    illegal = true;
+                }
+            }
+
+            std::string name = expression;
+            std::replace(name.begin(), name.end(), '.', '_');
+
+            if (!illegal
+                && (expression.find("..") != std::string::npos
+                       || !RegexMatch(name,
+                              "^([?|#|+|&]?(([A-Z|a-z|0-9|_|,])*|(%[A-F|a-f|0-9]{2})*)*\\*?)$")))
+                warnings.push_back("URI template expression \"" + expression
+                    + "\" contains invalid characters. Allowed characters for expressions are A-Z a-z 0-9 _ and "
+                      "percent encoded characters");
+
+            if (end == std::string::npos)
+                break;
+        }
+    }
+}
+
 TEST_CASE("Parse a valid uri into separate parts", "[validuriparser][issue][79]")
 {
 
@@ -18,7 +109,7 @@ TEST_CASE("Parse a valid uri into separate parts", "[validuriparser][issue][79]"
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
     REQUIRE(result.scheme == "http");
@@ -34,7 +125,7 @@ TEST_CASE("Parse an invalid uri into separate parts", "[invaliduriparser][issue]
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
     REQUIRE(result.scheme == "http");
@@ -50,7 +141,7 @@ TEST_CASE("Parse uri template for invalid format curly brackets (nested brackets
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -64,7 +155,7 @@ TEST_CASE("Parse uri template for invalid format curly brackets (missing end bra
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -78,7 +169,7 @@ TEST_CASE("Parse uri template for supported level one variable expansion",
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -92,7 +183,7 @@ TEST_CASE("Parse uri template for supported variables with % encoding and explod
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -105,7 +196,7 @@ TEST_CASE("Parse uri template for invalid % encoding", "[invalidpercentencoding]
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -118,7 +209,7 @@ TEST_CASE("Parse uri template for invalid expansion", "[invalidexpression][issue
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -132,7 +223,7 @@ TEST_CASE("Parse uri template for supported level two fragment expansion",
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -146,7 +237,7 @@ TEST_CASE("Parse uri template for supported level three form style query string
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -160,7 +251,7 @@ TEST_CASE("Parse uri template for supported level three reserved expansion",
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -174,7 +265,7 @@ TEST_CASE("Parse uri template for unsupported level three label expansion",
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -188,7 +279,7 @@ TEST_CASE("Parse uri template for unsupported level three path segment expansion
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -202,7 +293,7 @@ TEST_CASE("Parse uri template for unsupported level three path style parameter e
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -216,7 +307,7 @@ TEST_CASE("Parse uri template for supported level three form style query continu
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -230,7 +321,7 @@ TEST_CASE(
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -245,7 +336,7 @@ TEST_CASE("Parse uri template for invalid variable name, contains hyphens",
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -260,7 +351,7 @@ TEST_CASE("Parse uri template for invalid variable name, contains assignment",
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -275,7 +366,7 @@ TEST_CASE("Parse uri template for invalid variable name, invalid % encoded",
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -289,7 +380,7 @@ TEST_CASE("Parse uri template for variable name containing dot", "[validvariable
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -303,7 +394,7 @@ TEST_CASE("Parse uri template for invalid variable name containing multiple cont
 
     URITemplateParser parser;
     ParsedURITemplate result;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(uri, sourceBlock, result);
 
@@ -319,7 +410,7 @@ TEST_CASE("Parse uri template for consistent invalid character warning",
     URITemplateParser parser;
     ParsedURITemplate result;
     ParsedURITemplate result2;
-    mdp::CharactersRangeSet sourceBlock;
+    mdp::BytesRangeSet sourceBlock;
 
     parser.parse(urione, sourceBlock, result);
 
@@ -331,3 +422,107 @@ TEST_CASE("Parse uri template for consistent invalid character warning",
     REQUIRE(result2.report.warnings.size() == 1);
     REQUIRE(result2.report.warnings[0].message == "URI template expression \"$a,b,c\" contains invalid characters. Allowed characters for expressions are A-Z a-z 0-9 _ and percent encoded characters");
 }
+
+TEST_CASE("Classify uri template expression", "[uritemplateclassify]")
+{
+    ClassifiedExpression expression;
+
+    SECTION("Supported operators")
+    {
+        ClassifyExpression("var", 3, expression);
+        REQUIRE(expression.type == VariableExpressionType);
+        REQUIRE(expression.IsSupportedExpressionType());
+        REQUIRE(expression.flags == 0);
+
+        ClassifyExpression("?a,b*", 5, expression);
+        REQUIRE(expression.type == QueryStringExpressionType);
+        REQUIRE(expression.IsSupportedExpressionType());
+        REQUIRE(expression.flags == 0);
+
+        ClassifyExpression("&a%2F", 5, expression);
+        REQUIRE(expression.type == FormStyleQueryContinuationExpressionType);
+        REQUIRE(expression.IsSupportedExpressionType());
+        REQUIRE(expression.flags == 0);
+    }
+
+    SECTION("Unsupported operators")
+    {
+        ClassifyExpression(";a", 2, expression);
+        REQUIRE(expression.type == PathStyleParameterExpansionExpressionType);
+        REQUIRE_FALSE(expression.IsSupportedExpressionType());
+
+        ClassifyExpression("|a", 2, expression);
+        REQUIRE(expression.type == UndefinedExpressionType);
+        REQUIRE(std::string(expression.UnsupportedWarningText()) == "Unidentified expression");
+    }
+
+    SECTION("Illegal characters")
+    {
+        ClassifyExpression("a b-c=d", 7, expression);
+        REQUIRE(expression.flags
+            == (ClassifiedExpression::SpacesFlag | ClassifiedExpression::HyphensFlag
+                   | ClassifiedExpression::AssignmentFlag | ClassifiedExpression::InvalidNameFlag));
+
+        ClassifyExpression("a..b", 4, expression);
+        REQUIRE(expression.flags == ClassifiedExpression::InvalidNameFlag);
+
+        ClassifyExpression("a%2", 3, expression);
+        REQUIRE(expression.flags == ClassifiedExpression::InvalidNameFlag);
+
+        ClassifyExpression("a*b", 3, expression);
+        REQUIRE(expression.flags == ClassifiedExpression::InvalidNameFlag);
+
+        ClassifyExpression("", 0, expression);
+        REQUIRE(expression.type == VariableExpressionType);
+        REQUIRE(expression.flags == ClassifiedExpression::InvalidNameFlag);
+    }
+}
+
+TEST_CASE("Parse uri template with an expression left open by the last bracket", "[uritemplatetrailingexpression]")
+{
+    const snowcrash::URITemplate uri = "/a}b{c d";
+
+    URITemplateParser parser;
+    ParsedURITemplate result;
+    mdp::BytesRangeSet sourceBlock;
+
+    parser.parse(uri, sourceBlock, result);
+
+    REQUIRE(result.report.warnings.size() == 1);
+    REQUIRE(result.report.warnings[0].message == "URI template expression \"c d\" contains spaces. Allowed characters for expressions are A-Z a-z 0-9 _ and percent encoded characters");
+}
+
+TEST_CASE("Parse uri template same as the regex based parser", "[uritemplateequivalence]")
+{
+    const char* const fragments[] = { "http", "https", "ftp", "file", "://", "/", "{", "}", "{?", "{#", "{+", "{.",
+        "{/", "{;", "{&", "{|", "[", "]", "%2", "%", "..", ".", "*", "=", "-", " ", ",", "_", "a", "Z", "9", "g" };
+    const size_t fragmentCount = sizeof(fragments) / sizeof(fragments[0]);
+
+    std::mt19937 generator(78);
+
+    for (int i = 0; i < 20000; ++i) {
+        URITemplate uri;
+        size_t length = generator() % 12;
+
+        for (size_t j = 0; j < length; ++j)
+            uri += fragments[generator() % fragmentCount];
+
+        URITemplateParser parser;
+        ParsedURITemplate result;
+        ParsedURITemplate expected;
+        std::vector<std::string> expectedWarnings;
+        mdp::BytesRangeSet sourceBlock;
+
+        parser.parse(uri, sourceBlock, result);
+        ReferenceParse(uri, expected, expectedWarnings);
+
+        INFO("URI template: '" << uri << "'");
+        REQUIRE(result.scheme == expected.scheme);
+        REQUIRE(result.host == expected.host);
+        REQUIRE(result.path == expected.path);
+        REQUIRE(result.report.warnings.size() == expectedWarnings.size());
+
+        for (size_t j = 0; j < expectedWarnings.size(); ++j)
+            REQUIRE(result.report.warnings[j].message == expectedWarnings[j]);
+    }
+}
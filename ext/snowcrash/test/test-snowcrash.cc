@@ -782,3 +782,62 @@ TEST_CASE("Parse blueprint with mismatched adapter blocks", "[blueprint]")
     REQUIRE(blueprint.report.warnings.empty());
     SourceMapHelper::check(blueprint.report.error.location, 42, 24);
 }
+
+TEST_CASE("Locate warnings by characters of multibyte source", "[parser][sourcemap]")
+{
+    // 21 characters in 30 bytes
+    mdp::ByteBuffer source
+        = "# API\n"
+          "Příliš žluťoučký kůň\n"
+          "\n"
+          "# PUT /branch";
+
+    ParseResult<Blueprint> blueprint;
+
+    REQUIRE_NOTHROW(parse(source, 0, blueprint));
+    REQUIRE(blueprint.report.error.code == Error::OK);
+    REQUIRE(blueprint.report.warnings.size() == 1);
+    REQUIRE(blueprint.report.warnings[0].code == EmptyDefinitionWarning);
+    SourceMapHelper::check(blueprint.report.warnings[0].location, 37, 13);
+
+    std::vector<mdp::CharactersRangeSet> locations = locateAnnotations(blueprint.report, source);
+    REQUIRE(locations.size() == 2);
+    REQUIRE(locations[0].empty());
+    SourceMapHelper::check(locations[1], 28, 13);
+}
+
+TEST_CASE("Split top-level sections while parsing", "[parser]")
+{
+    mdp::ByteBuffer source
+        = "# API\n"
+          "# Group A\n"
+          "## /a\n"
+          "### GET\n"
+          "+ Response 204\n"
+          "\n"
+          "# Data Structures\n"
+          "## B (object)\n";
+
+    ParseResult<Blueprint> blueprint;
+    TopLevelSections sections;
+
+    REQUIRE_NOTHROW(parse(source, 0, blueprint, &sections));
+    REQUIRE(blueprint.report.error.code == Error::OK);
+
+    TopLevelSections split;
+    splitTopLevelSections(source, split);
+
+    REQUIRE(sections.size() == 3);
+    REQUIRE(split.size() == sections.size());
+
+    for (size_t i = 0; i < sections.size(); ++i) {
+        REQUIRE(sections[i].type == split[i].type);
+        REQUIRE(sections[i].range.location == split[i].range.location);
+        REQUIRE(sections[i].range.length == split[i].range.length);
+    }
+
+    REQUIRE(sections[1].type == ResourceGroupSectionType);
+    REQUIRE(sections[1].range.location == 6);
+    REQUIRE(sections[2].type == DataStructureGroupSectionType);
+    REQUIRE(sections[2].range.location == 46);
+}
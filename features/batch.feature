@@ -0,0 +1,17 @@
+Feature: Process more blueprints
+
+  Scenario: Validate more blueprint files
+
+    When I run `drafter -j 2 --validate blueprint.apib invalid_blueprint.apib`
+    Then the output should contain:
+    """
+    invalid_blueprint.apib:
+    OK.
+    warning: (5)  unexpected header block, expected a group, resource or an action definition, e.g. '# Group <name>', '# <resource name> [<URI>]' or '# <HTTP method> <URI>' :24:29
+    """
+
+  Scenario: Parse more blueprint files into an output directory
+
+    When I run `drafter -j 2 -f json -o ../../tmp/batch blueprint.apib invalid_blueprint.apib`
+    Then a file named "../../tmp/batch/blueprint.json" should exist
+    And a file named "../../tmp/batch/invalid_blueprint.json" should exist
@@ -0,0 +1,25 @@
+Feature: Cache parse results
+
+  Scenario: Parse a cached blueprint file into Refract YAML
+
+    When I run `drafter --cache-dir ../../tmp/cache blueprint.apib`
+    And I run `drafter --cache-dir ../../tmp/cache blueprint.apib`
+    Then the output should contain the content of file "refract.yaml"
+
+  Scenario: Serve an unchanged blueprint file from the cache
+
+    Given an empty cache "../../tmp/cache-hit"
+    When I run `drafter --cache-dir ../../tmp/cache-hit blueprint.apib`
+    And I replace "parseResult" with "cacheResult" in the entries of cache "../../tmp/cache-hit"
+    And I run `drafter --cache-dir ../../tmp/cache-hit blueprint.apib`
+    Then the output should contain "element: \"cacheResult\""
+
+  Scenario: Validate a cached invalid blueprint file
+
+    When I run `drafter --cache-dir ../../tmp/cache --validate invalid_blueprint.apib`
+    And I run `drafter --cache-dir ../../tmp/cache --validate invalid_blueprint.apib`
+    Then the output should contain:
+    """
+    OK.
+    warning: (5)  unexpected header block, expected a group, resource or an action definition, e.g. '# Group <name>', '# <resource name> [<URI>]' or '# <HTTP method> <URI>' :24:29
+    """
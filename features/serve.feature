@@ -0,0 +1,23 @@
+Feature: Serve parse requests
+
+  Scenario: Serve a request read from stdin
+
+    When I run `drafter --serve -f json` interactively
+    When I pipe in the file "serve_request.txt"
+    Then the output should contain:
+    """
+    "element": "parseResult"
+    """
+    And the output should contain:
+    """
+    OK.
+    """
+
+  Scenario: Answer a truncated request
+
+    When I run `drafter --serve` interactively
+    When I pipe in the file "serve_truncated_request.txt"
+    Then the output should contain:
+    """
+    truncated request body
+    """
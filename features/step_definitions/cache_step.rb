@@ -0,0 +1,21 @@
+require 'fileutils'
+
+Given /^an empty cache "(.*)"$/ do |directory|
+  in_current_dir do
+    FileUtils.rm_rf(directory)
+  end
+end
+
+# Entries keep their size, so they are still valid and served as they are
+When /^I replace "(.*)" with "(.*)" in the entries of cache "(.*)"$/ do |from, to, directory|
+  raise "replacement must be of the same size" unless from.size == to.size
+
+  in_current_dir do
+    entries = Dir.glob(File.join(directory, '*.entry'))
+    raise "no entries in cache #{directory}" if entries.empty?
+
+    entries.each do |entry|
+      File.binwrite(entry, File.binread(entry).gsub(from, to))
+    end
+  end
+end
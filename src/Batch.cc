@@ -0,0 +1,273 @@
+//
+//  Batch.cc
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include "Batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(_WIN32)
+#include <direct.h>
+#include <io.h>
+#else
+#include <dirent.h>
+#endif
+
+#include "Processor.h"
+#include "ResultCache.h"
+
+namespace
+{
+    const std::string BlueprintExtension = ".apib";
+
+    bool IsDirectory(const std::string& path)
+    {
+        struct stat info;
+        return stat(path.c_str(), &info) == 0 && (info.st_mode & S_IFMT) == S_IFDIR;
+    }
+
+    void MakeDirectory(const std::string& path)
+    {
+#if defined(_WIN32)
+        _mkdir(path.c_str());
+#else
+        mkdir(path.c_str(), 0777);
+#endif
+    }
+
+    bool HasExtension(const std::string& name, const std::string& extension)
+    {
+        return name.size() > extension.size()
+            && name.compare(name.size() - extension.size(), extension.size(), extension) == 0;
+    }
+
+    /**
+     *  \brief Append blueprints in `directory` to `files`, sorted by name
+     *
+     *  \return False if the directory cannot be read
+     */
+    bool ListBlueprints(const std::string& directory, std::vector<std::string>& files)
+    {
+        std::vector<std::string> names;
+
+#if defined(_WIN32)
+        struct _finddata_t found;
+        intptr_t handle = _findfirst((directory + "/*" + BlueprintExtension).c_str(), &found);
+
+        if (handle == -1) {
+            // no blueprint in the directory is not an error
+            return errno == ENOENT;
+        }
+
+        do {
+            names.push_back(found.name);
+        } while (_findnext(handle, &found) == 0);
+
+        _findclose(handle);
+#else
+        DIR* dir = opendir(directory.c_str());
+
+        if (!dir) {
+            return false;
+        }
+
+        while (struct dirent* entry = readdir(dir)) {
+            if (HasExtension(entry->d_name, BlueprintExtension)) {
+                names.push_back(entry->d_name);
+            }
+        }
+
+        closedir(dir);
+#endif
+
+        std::sort(names.begin(), names.end());
+
+        for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it) {
+            files.push_back(directory + "/" + *it);
+        }
+
+        return true;
+    }
+
+    /** Name of file to save parse result of `input` into */
+    std::string OutputName(const Config& config, const std::string& input)
+    {
+        std::string name = input;
+
+        if (!config.output.empty()) {
+            const std::string::size_type slash = name.find_last_of("/\\");
+
+            if (slash != std::string::npos) {
+                name.erase(0, slash + 1);
+            }
+
+            name = config.output + "/" + name;
+        }
+
+        const std::string::size_type dot = name.find_last_of("./\\");
+
+        if (dot != std::string::npos && name[dot] == '.') {
+            name.erase(dot);
+        }
+
+        return name + (config.format == drafter::JSONFormat ? ".json" : ".yaml");
+    }
+
+    bool ReadFile(const std::string& path, std::string& content)
+    {
+        std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+
+        if (!in.is_open()) {
+            return false;
+        }
+
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        content = buffer.str();
+
+        return !in.bad();
+    }
+
+    /**
+     *  \brief Parse blueprint `input` and save its parse result
+     */
+    void ProcessFile(const Config& config,
+        const std::string& input,
+        const std::string& output,
+        ResultCache* cache,
+        ProcessResult& result)
+    {
+        std::string source;
+
+        if (!ReadFile(input, source)) {
+            result.status = EXIT_FAILURE;
+            result.report = "\nfatal: unable to open file '" + input + "'\n";
+            return;
+        }
+
+        ProcessBlueprint(config, source, cache, result);
+
+        // status of a parse without any result is negative
+        if (result.status < 0) {
+            result.status = EXIT_FAILURE;
+            result.report += "\nfatal: unable to parse file '" + input + "'\n";
+            return;
+        }
+
+        if (config.validate || result.output.empty()) {
+            return;
+        }
+
+        std::ofstream out(output.c_str(), std::ios::out | std::ios::binary);
+
+        if (!out.is_open()) {
+            result.status = std::max(result.status, EXIT_FAILURE);
+            result.report += "fatal: unable to open file '" + output + "'\n";
+            return;
+        }
+
+        out << result.output << "\n";
+        result.output.clear();
+    }
+}
+
+bool IsBatch(const Config& config)
+{
+    return config.inputs.size() > 1 || (config.inputs.size() == 1 && IsDirectory(config.inputs.front()));
+}
+
+int ProcessFiles(const Config& config)
+{
+    std::vector<std::string> inputs;
+
+    for (std::vector<std::string>::const_iterator it = config.inputs.begin(); it != config.inputs.end(); ++it) {
+        if (!IsDirectory(*it)) {
+            inputs.push_back(*it);
+        } else if (!ListBlueprints(*it, inputs)) {
+            std::cerr << "fatal: unable to read directory '" << *it << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<std::string> outputs;
+    std::set<std::string> unique;
+
+    for (std::vector<std::string>::const_iterator it = inputs.begin(); it != inputs.end(); ++it) {
+        outputs.push_back(OutputName(config, *it));
+
+        if (!config.validate && !unique.insert(outputs.back()).second) {
+            std::cerr << "fatal: more inputs would be saved into '" << outputs.back() << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!config.validate && !config.output.empty()) {
+        MakeDirectory(config.output);
+    }
+
+    std::unique_ptr<ResultCache> cache;
+
+    if (!config.cacheDir.empty()) {
+        cache.reset(new ResultCache(config.cacheDir, config.cacheSize));
+    }
+
+    std::vector<ProcessResult> results(inputs.size());
+    std::vector<bool> done(inputs.size(), false);
+
+    std::atomic<size_t> next(0);
+    std::mutex mutex;
+    size_t reported = 0;
+    int status = EXIT_SUCCESS;
+
+    auto work = [&]() {
+        for (size_t i = next++; i < inputs.size(); i = next++) {
+            ProcessFile(config, inputs[i], outputs[i], cache.get(), results[i]);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            done[i] = true;
+
+            // reports are printed as soon as all the preceding ones are
+            for (; reported < inputs.size() && done[reported]; ++reported) {
+                std::cerr << inputs[reported] << ":" << results[reported].report << std::flush;
+                status = std::max(status, results[reported].status);
+                results[reported] = ProcessResult();
+            }
+        }
+    };
+
+    size_t workers = config.jobs;
+
+    if (workers == 0) {
+        workers = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < std::min(workers, inputs.size()); ++i) {
+        threads.push_back(std::thread(work));
+    }
+
+    work();
+
+    for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it) {
+        it->join();
+    }
+
+    return status;
+}
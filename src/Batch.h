@@ -0,0 +1,34 @@
+//
+//  Batch.h
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#ifndef DRAFTER_BATCH_H
+#define DRAFTER_BATCH_H
+
+#include <string>
+
+#include "config.h"
+
+/**
+ *  \brief Check whether the input names a batch of blueprints
+ *
+ *  \return True for more than one input file or a directory
+ */
+bool IsBatch(const Config& config);
+
+/**
+ *  \brief Process every input file, `config.jobs` of them concurrently
+ *
+ *  Directories are replaced by `.apib` files they contain. Parse result
+ *  of `name.apib` is saved into `name.yaml` or `name.json` next to it,
+ *  or into directory `config.output` if given. Reports are printed to
+ *  stderr in order of the input files, each preceded by the file name.
+ *
+ *  \return The highest exit code of all the files
+ */
+int ProcessFiles(const Config& config);
+
+#endif // #ifndef DRAFTER_BATCH_H
@@ -18,7 +18,8 @@ namespace drafter
 
     class ConversionContext
     {
-        refract::Registry registry;
+        refract::Registry ownRegistry;
+        refract::Registry& registry;
 
     public:
         const WrapperOptions& options;
@@ -33,7 +34,18 @@ namespace drafter
             return registry;
         }
 
-        ConversionContext(const WrapperOptions& options) : options(options)
+        ConversionContext(const WrapperOptions& options) : registry(ownRegistry), options(options)
+        {
+        }
+
+        /**
+         * \brief Context of a conversion task
+         *
+         * Shares the named types registry with another context,
+         * but collects warnings of its own.
+         */
+        ConversionContext(const WrapperOptions& options, refract::Registry& registry)
+            : registry(registry), options(options)
         {
         }
 
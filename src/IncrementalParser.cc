@@ -0,0 +1,515 @@
+//
+//  IncrementalParser.cc
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include "IncrementalParser.h"
+
+#include "RefractAPI.h"
+#include "SerializeResult.h"
+#include "NamedTypesRegistry.h"
+#include "ConversionContext.h"
+#include "WorkerPool.h"
+
+#include "refract/TypeQueryVisitor.h"
+#include "refract/Visitor.h"
+
+#include <sstream>
+
+namespace drafter
+{
+
+    namespace
+    {
+
+        bool IsGroupOf(const snowcrash::Element& element, snowcrash::Element::Category category)
+        {
+            return element.element == snowcrash::Element::CategoryElement && element.category == category;
+        }
+
+        /**
+         * Find byte range of the top-level section every element has been parsed from
+         *
+         * \return False if elements do not correspond to top-level sections
+         */
+        bool MapElementsToSections(const snowcrash::TopLevelSections& sections,
+            const snowcrash::Elements& elements,
+            mdp::BytesRangeSet& ranges)
+        {
+            // the content preceding the first group gives an element only if it contains resources
+            const size_t first = elements.size() + 1 == sections.size() ? 1 : 0;
+
+            if (elements.size() + first != sections.size()) {
+                return false;
+            }
+
+            for (size_t i = 0; i < elements.size(); ++i) {
+                const snowcrash::TopLevelSection& section = sections[i + first];
+                const snowcrash::Element& element = elements[i];
+
+                switch (section.type) {
+                    case snowcrash::UndefinedSectionType:
+                        if (!IsGroupOf(element, snowcrash::Element::ResourceGroupCategory)
+                            || !element.attributes.name.empty()) {
+                            return false;
+                        }
+                        break;
+
+                    case snowcrash::ResourceGroupSectionType:
+                        if (!IsGroupOf(element, snowcrash::Element::ResourceGroupCategory)) {
+                            return false;
+                        }
+                        break;
+
+                    case snowcrash::DataStructureGroupSectionType:
+                        if (!IsGroupOf(element, snowcrash::Element::DataStructureGroupCategory)) {
+                            return false;
+                        }
+                        break;
+
+                    default:
+                        return false;
+                }
+
+                ranges.push_back(section.range);
+            }
+
+            return true;
+        }
+
+        /** \see FindNamedTypes() in NamedTypesRegistry.cc */
+        bool DefinesNamedTypes(const snowcrash::Element& element)
+        {
+            if (element.element == snowcrash::Element::DataStructureElement
+                || !element.content.resource.attributes.empty()) {
+                return true;
+            }
+
+            if (element.element == snowcrash::Element::CategoryElement) {
+                const snowcrash::Elements& children = element.content.elements();
+
+                for (snowcrash::Elements::const_iterator it = children.begin(); it != children.end(); ++it) {
+                    if (DefinesNamedTypes(*it)) {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        template <typename T>
+        bool ReferencesModel(const T& payloads)
+        {
+            for (typename T::const_iterator it = payloads.begin(); it != payloads.end(); ++it) {
+                if (!it->reference.id.empty()) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /**
+         * Payloads referencing a model contain the model itself,
+         * so they depend on the section defining the model
+         */
+        bool ReferencesModel(const snowcrash::Element& element)
+        {
+            if (element.element == snowcrash::Element::CategoryElement) {
+                const snowcrash::Elements& children = element.content.elements();
+
+                for (snowcrash::Elements::const_iterator it = children.begin(); it != children.end(); ++it) {
+                    if (ReferencesModel(*it)) {
+                        return true;
+                    }
+                }
+            }
+
+            const snowcrash::Actions& actions = element.content.resource.actions;
+
+            for (snowcrash::Actions::const_iterator action = actions.begin(); action != actions.end(); ++action) {
+                for (snowcrash::TransactionExamples::const_iterator example = action->examples.begin();
+                     example != action->examples.end();
+                     ++example) {
+
+                    if (ReferencesModel(example->requests) || ReferencesModel(example->responses)) {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        bool IsWithin(const mdp::Range& range, const mdp::BytesRange& section)
+        {
+            return range.location >= section.location
+                && range.location + range.length <= section.location + section.length;
+        }
+
+        void Shift(mdp::Range& range, size_t from, size_t to)
+        {
+            range.location = range.location - from + to;
+        }
+
+        void Shift(snowcrash::Warning& warning, size_t from, size_t to)
+        {
+            for (mdp::BytesRangeSet::iterator it = warning.location.begin(); it != warning.location.end(); ++it) {
+                Shift(*it, from, to);
+            }
+        }
+
+        /**
+         * Walks all the source maps of an element and its descendants,
+         * either to check they are all within a section or to move them
+         */
+        struct SourceMapWalker {
+
+            const mdp::BytesRange section;
+            const size_t to;
+            const bool shift;
+            bool within;
+
+            SourceMapWalker(const mdp::BytesRange& section, size_t to, bool shift)
+                : section(section), to(to), shift(shift), within(true)
+            {
+            }
+
+            void walk(refract::IElement* element)
+            {
+                if (element) {
+                    refract::VisitBy(*element, *this);
+                }
+            }
+
+            void ranges(refract::IElement* sourceMap)
+            {
+                refract::ArrayElement* list = refract::TypeQueryVisitor::as<refract::ArrayElement>(sourceMap);
+
+                if (!list) {
+                    return;
+                }
+
+                for (refract::RefractElements::iterator map = list->value.begin(); map != list->value.end(); ++map) {
+                    refract::ArrayElement* rangeSet = refract::TypeQueryVisitor::as<refract::ArrayElement>(*map);
+
+                    if (!rangeSet) {
+                        continue;
+                    }
+
+                    for (refract::RefractElements::iterator it = rangeSet->value.begin(); it != rangeSet->value.end();
+                         ++it) {
+
+                        refract::ArrayElement* range = refract::TypeQueryVisitor::as<refract::ArrayElement>(*it);
+
+                        if (!range || range->value.size() != 2) {
+                            continue;
+                        }
+
+                        refract::NumberElement* location
+                            = refract::TypeQueryVisitor::as<refract::NumberElement>(range->value[0]);
+                        refract::NumberElement* length
+                            = refract::TypeQueryVisitor::as<refract::NumberElement>(range->value[1]);
+
+                        if (!location || !length) {
+                            continue;
+                        }
+
+                        if (shift) {
+                            location->value = location->value - section.location + to;
+                        } else {
+                            within = within
+                                && IsWithin(mdp::Range(static_cast<size_t>(location->value),
+                                                static_cast<size_t>(length->value)),
+                                         section);
+                        }
+                    }
+                }
+            }
+
+            void members(const refract::IElement::MemberElementCollection& collection)
+            {
+                for (refract::IElement::MemberElementCollection::const_iterator it = collection.begin();
+                     it != collection.end();
+                     ++it) {
+
+                    if (!*it) {
+                        continue;
+                    }
+
+                    refract::StringElement* key
+                        = refract::TypeQueryVisitor::as<refract::StringElement>((*it)->value.first);
+
+                    if (key && key->value == SerializeKey::SourceMap) {
+                        ranges((*it)->value.second);
+                    } else {
+                        walk((*it)->value.second);
+                    }
+                }
+            }
+
+            template <typename T>
+            void children(const T&)
+            {
+            }
+
+            void children(refract::IElement* element)
+            {
+                walk(element);
+            }
+
+            template <typename E>
+            void children(const std::vector<E*>& elements)
+            {
+                for (typename std::vector<E*>::const_iterator it = elements.begin(); it != elements.end(); ++it) {
+                    walk(*it);
+                }
+            }
+
+            void children(const refract::MemberElement::ValueType& member)
+            {
+                walk(member.first);
+                walk(member.second);
+            }
+
+            void operator()(const refract::IElement&)
+            {
+            }
+
+            template <typename T>
+            void operator()(const T& element)
+            {
+                members(element.meta);
+                members(element.attributes);
+                children(element.value);
+            }
+        };
+
+        bool IsWithin(refract::IElement* element, const mdp::BytesRange& section)
+        {
+            SourceMapWalker walker(section, section.location, false);
+            walker.walk(element);
+            return walker.within;
+        }
+
+        void Shift(refract::IElement* element, size_t from, size_t to)
+        {
+            SourceMapWalker walker(mdp::BytesRange(from, 0), to, true);
+            walker.walk(element);
+        }
+    }
+
+    IncrementalParser::IncrementalParser(snowcrash::BlueprintParserOptions options,
+        const refract::Allocator* allocator,
+        const refract::Limits* limits,
+        const std::atomic<bool>* cancelled,
+        const refract::ProgressCallback& progress)
+        : parserOptions(options | snowcrash::ExportSourcemapOption),
+          options(false, false),
+          allocator(allocator ? *allocator : refract::CurrentAllocator()),
+          limits(limits ? *limits : refract::Limits()),
+          cancelled(cancelled),
+          progress(progress),
+          budgeted(limits || cancelled || progress),
+          reusable(false)
+    {
+    }
+
+    IncrementalParser::~IncrementalParser()
+    {
+        try {
+            registry.clearAll(true);
+        } catch (...) {
+            // released by the C API, nothing may be thrown
+        }
+    }
+
+    int IncrementalParser::edit(
+        size_t offset, size_t length, const mdp::ByteBuffer& replacement, refract::IElement*& out)
+    {
+        mdp::ByteBuffer source = document;
+        source.replace(offset, length, replacement);
+
+        return parse(source, out);
+    }
+
+    int IncrementalParser::parse(const mdp::ByteBuffer& source, refract::IElement*& out)
+    {
+        refract::ScopedAllocator scoped(&allocator);
+
+        std::unique_ptr<refract::Budget> budget(
+            budgeted ? new refract::Budget(limits, cancelled, progress) : NULL);
+        refract::ScopedBudget scopedBudget(budget.get());
+
+        document = source;
+
+        snowcrash::ParseResult<snowcrash::Blueprint> blueprint;
+        snowcrash::TopLevelSections sections;
+        WorkerPoolRunner runner;
+        snowcrash::parse(document, parserOptions, blueprint, &sections, budget.get(), &runner);
+
+        mdp::BytesRangeSet ranges;
+
+        if (blueprint.report.error.code == snowcrash::Error::OK
+            && !MapElementsToSections(sections, blueprint.node.content.elements(), ranges)) {
+            ranges.clear();
+        }
+
+        Cache used;
+        ConversionContext context(options, registry);
+
+        out = WrapRefract(blueprint,
+            document,
+            context,
+            [this, &ranges, &used](snowcrash::ParseResult<snowcrash::Blueprint>& blueprint,
+                ConversionContext& context) { return convert(blueprint, ranges, used, context); });
+
+        if (blueprint.report.error.code != snowcrash::Error::OK) {
+            reset();
+        } else {
+            cache.swap(used);
+        }
+
+        return blueprint.report.error.code;
+    }
+
+    refract::IElement* IncrementalParser::convert(snowcrash::ParseResult<snowcrash::Blueprint>& blueprint,
+        const mdp::BytesRangeSet& ranges,
+        Cache& used,
+        ConversionContext& context)
+    {
+        const snowcrash::Elements& elements = blueprint.node.content.elements();
+        const bool mapped = !elements.empty() && ranges.size() == elements.size();
+
+        mdp::ByteBuffer definitions;
+        std::vector<size_t> offsets;
+
+        if (mapped) {
+            for (size_t i = 0; i < elements.size(); ++i) {
+                if (DefinesNamedTypes(elements[i])) {
+                    std::stringstream length;
+                    length << ranges[i].length << ":";
+
+                    definitions.append(length.str()).append(document, ranges[i].location, ranges[i].length);
+                    offsets.push_back(ranges[i].location);
+                }
+            }
+        }
+
+        if (!mapped || !reusable || definitions != namedTypes) {
+            cache.clear();
+        }
+
+        if (!mapped || !reusable || definitions != namedTypes || offsets != namedTypesOffsets) {
+            registry.clearAll(true);
+            registrationWarnings.clear();
+
+            ConversionContext registration(options, registry);
+            RegisterNamedTypes(MakeNodeInfo(elements, blueprint.sourceMap.content.elements()), registration);
+
+            registrationWarnings.swap(registration.warnings);
+        }
+
+        namedTypes.swap(definitions);
+        namedTypesOffsets.swap(offsets);
+        reusable = mapped;
+
+        for (std::vector<snowcrash::Warning>::const_iterator it = registrationWarnings.begin();
+             it != registrationWarnings.end();
+             ++it) {
+            context.warn(*it);
+        }
+
+        return BlueprintToRefract(MakeNodeInfo(blueprint.node, blueprint.sourceMap),
+            context,
+            [this, mapped, &ranges, &used](
+                size_t i, const NodeInfo<snowcrash::Element>& element, ConversionContext& context) {
+                return mapped ? convertElement(element, ranges[i], used, context) : ElementToRefract(element, context);
+            });
+    }
+
+    refract::IElement* IncrementalParser::convertElement(const NodeInfo<snowcrash::Element>& element,
+        const mdp::BytesRange& range,
+        Cache& used,
+        ConversionContext& context)
+    {
+        const mdp::ByteBuffer text = document.substr(range.location, range.length);
+
+        Cache::iterator cached = cache.find(text);
+
+        if (cached != cache.end()) {
+            used[text] = std::move(cached->second);
+            cache.erase(cached);
+        }
+
+        cached = used.find(text);
+
+        if (cached != used.end()) {
+            const CachedElement& entry = cached->second;
+
+            refract::IElement* result = entry.element->clone();
+            Shift(result, entry.offset, range.location);
+
+            for (std::vector<snowcrash::Warning>::const_iterator it = entry.warnings.begin();
+                 it != entry.warnings.end();
+                 ++it) {
+                snowcrash::Warning warning = *it;
+                Shift(warning, entry.offset, range.location);
+                context.warn(warning);
+            }
+
+            return result;
+        }
+
+        ConversionContext elementContext(context.options, context.GetNamedTypesRegistry());
+        refract::IElement* result = NULL;
+
+        try {
+            result = ElementToRefract(element, elementContext);
+        } catch (...) {
+            for (std::vector<snowcrash::Warning>::const_iterator it = elementContext.warnings.begin();
+                 it != elementContext.warnings.end();
+                 ++it) {
+                context.warn(*it);
+            }
+
+            throw;
+        }
+
+        bool cacheable = result && !ReferencesModel(*element.node) && IsWithin(result, range);
+
+        for (std::vector<snowcrash::Warning>::const_iterator it = elementContext.warnings.begin();
+             it != elementContext.warnings.end();
+             ++it) {
+            context.warn(*it);
+
+            for (mdp::BytesRangeSet::const_iterator location = it->location.begin();
+                 location != it->location.end();
+                 ++location) {
+                cacheable = cacheable && IsWithin(*location, range);
+            }
+        }
+
+        if (cacheable) {
+            CachedElement& entry = used[text];
+            entry.offset = range.location;
+            entry.element.reset(result->clone());
+            entry.warnings.swap(elementContext.warnings);
+        }
+
+        return result;
+    }
+
+    void IncrementalParser::reset()
+    {
+        registry.clearAll(true);
+        registrationWarnings.clear();
+        namedTypes.clear();
+        namedTypesOffsets.clear();
+        reusable = false;
+        cache.clear();
+    }
+}
@@ -0,0 +1,132 @@
+//
+//  IncrementalParser.h
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#ifndef DRAFTER_INCREMENTALPARSER_H
+#define DRAFTER_INCREMENTALPARSER_H
+
+#include "Serialize.h"
+#include "snowcrash.h"
+#include "refract/Allocator.h"
+#include "refract/Budget.h"
+#include "refract/Registry.h"
+
+#include <map>
+#include <memory>
+
+namespace drafter
+{
+
+    class ConversionContext;
+
+    /**
+     *  \brief Parser of successive revisions of a single blueprint
+     *
+     *  Every revision is parsed by snowcrash as a whole, once, top-level
+     *  sections are split by the same markdown parse. Snowcrash AST is not
+     *  reused, parsing a section depends on named types and models defined
+     *  anywhere in the document.
+     *
+     *  Refract elements converted from top-level sections (resource and
+     *  data structure groups) are kept between parses. An unchanged section
+     *  reuses its element, with source maps shifted to its new offset.
+     *  Named types are registered again only if a section defining them
+     *  has changed or moved, a changed definition invalidates all the
+     *  elements kept.
+     *
+     *  The result is always the same as of parsing the source from scratch.
+     *
+     *  Elements are allocated by the allocator of the parser, the current
+     *  one when the parser is created unless another is given. Every parse
+     *  runs within its own budget of the limits given, cancelled once
+     *  `cancelled` is set and reporting progress to `progress`, if any.
+     */
+    class IncrementalParser
+    {
+    public:
+        explicit IncrementalParser(snowcrash::BlueprintParserOptions options,
+            const refract::Allocator* allocator = NULL,
+            const refract::Limits* limits = NULL,
+            const std::atomic<bool>* cancelled = NULL,
+            const refract::ProgressCallback& progress = refract::ProgressCallback());
+        ~IncrementalParser();
+
+        /**
+         *  \brief Parse `source` into refract parse result
+         *
+         *  \param out Parse result, owned by caller
+         *  \return Error code of the parse report
+         */
+        int parse(const mdp::ByteBuffer& source, refract::IElement*& out);
+
+        /**
+         *  \brief Replace `length` bytes at `offset` of the source parsed last and parse it
+         *
+         *  The range must lie within the source, \see source()
+         */
+        int edit(size_t offset, size_t length, const mdp::ByteBuffer& replacement, refract::IElement*& out);
+
+        /** \return Source parsed last */
+        const mdp::ByteBuffer& source() const
+        {
+            return document;
+        }
+
+    private:
+        IncrementalParser(const IncrementalParser&);
+        IncrementalParser& operator=(const IncrementalParser&);
+
+        /** Element converted from a top-level section */
+        struct CachedElement {
+            /** Offset of the section the element has been converted from */
+            size_t offset;
+            std::unique_ptr<refract::IElement> element;
+            std::vector<snowcrash::Warning> warnings;
+        };
+
+        /** Cached elements by source of their sections */
+        typedef std::map<mdp::ByteBuffer, CachedElement> Cache;
+
+        refract::IElement* convert(snowcrash::ParseResult<snowcrash::Blueprint>& blueprint,
+            const mdp::BytesRangeSet& ranges,
+            Cache& used,
+            ConversionContext& context);
+
+        refract::IElement* convertElement(const NodeInfo<snowcrash::Element>& element,
+            const mdp::BytesRange& range,
+            Cache& used,
+            ConversionContext& context);
+
+        void reset();
+
+        const snowcrash::BlueprintParserOptions parserOptions;
+        const WrapperOptions options;
+        const refract::Allocator allocator;
+
+        /** Budget of every parse, if `budgeted` */
+        const refract::Limits limits;
+        const std::atomic<bool>* const cancelled;
+        const refract::ProgressCallback progress;
+        const bool budgeted;
+
+        mdp::ByteBuffer document;
+
+        refract::Registry registry;
+        std::vector<snowcrash::Warning> registrationWarnings;
+
+        /** Sources of the sections defining named types */
+        mdp::ByteBuffer namedTypes;
+        /** Offsets of the sections defining named types */
+        std::vector<size_t> namedTypesOffsets;
+
+        /** Set if registry and cache belong to the source parsed last */
+        bool reusable;
+
+        Cache cache;
+    };
+}
+
+#endif // #ifndef DRAFTER_INCREMENTALPARSER_H
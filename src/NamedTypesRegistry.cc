@@ -3,6 +3,8 @@
 #include <string>
 #include <map>
 #include <set>
+#include <exception>
+#include <unordered_map>
 
 #include "MSON.h"
 #include "Blueprint.h"
@@ -16,6 +18,7 @@
 #include "RefractElementFactory.h"
 
 #include "ConversionContext.h"
+#include "WorkerPool.h"
 
 #undef DEBUG_DEPENDENCIES
 
@@ -348,6 +351,162 @@ namespace drafter
             }
         };
 
+        typedef std::vector<std::vector<size_t> > ConversionWaves;
+
+        /**
+         * Split named types, sorted by InheritanceComparator, into waves
+         * which can be converted concurrently.
+         *
+         * A named type is put into a later wave than every type sorted before it
+         * which it reaches through inheritance or members, and not into an earlier wave
+         * than any type sorted before it which reaches it. While converting a type,
+         * the registry then holds exactly the same converted types as it did when
+         * the types were converted one by one in the sorted order.
+         */
+        ConversionWaves SplitIntoWaves(const DataStructures& sorted, const DependencyTypeInfo& typeInfo)
+        {
+            const size_t count = sorted.size();
+            std::unordered_map<std::string, size_t> positions;
+
+            for (size_t i = 0; i < count; ++i) {
+                const std::string& name = typeInfo.name(sorted[i].node);
+
+                if (!name.empty()) {
+                    positions[name] = i;
+                }
+            }
+
+            // Direct references of every named type
+            std::vector<std::vector<size_t> > references(count);
+
+            for (size_t i = 0; i < count; ++i) {
+                const std::string& name = typeInfo.name(sorted[i].node);
+                std::unordered_map<std::string, size_t>::const_iterator position;
+
+                if (name.empty()) {
+                    continue;
+                }
+
+                DependencyTypeInfo::InheritanceMap::const_iterator parent = typeInfo.childToParent.find(name);
+
+                if (parent != typeInfo.childToParent.end()
+                    && (position = positions.find(parent->second)) != positions.end()) {
+                    references[i].push_back(position->second);
+                }
+
+                DependencyTypeInfo::MembersMap::const_iterator members = typeInfo.objectToMembers.find(name);
+
+                if (members == typeInfo.objectToMembers.end()) {
+                    continue;
+                }
+
+                for (DependencyTypeInfo::Members::const_iterator it = members->second.begin();
+                     it != members->second.end();
+                     ++it) {
+
+                    if ((position = positions.find(*it)) != positions.end()) {
+                        references[i].push_back(position->second);
+                    }
+                }
+            }
+
+            // Transitively reached named types, and the reverse
+            std::vector<std::vector<size_t> > reaches(count);
+            std::vector<std::vector<size_t> > reachedBy(count);
+            std::vector<size_t> visited(count, count);
+            std::vector<size_t> stack;
+
+            for (size_t i = 0; i < count; ++i) {
+                stack.assign(references[i].begin(), references[i].end());
+
+                while (!stack.empty()) {
+                    size_t reached = stack.back();
+                    stack.pop_back();
+
+                    if (visited[reached] == i) {
+                        continue;
+                    }
+
+                    visited[reached] = i;
+                    reaches[i].push_back(reached);
+                    reachedBy[reached].push_back(i);
+                    stack.insert(stack.end(), references[reached].begin(), references[reached].end());
+                }
+            }
+
+            std::vector<size_t> waveOf(count, 0);
+            ConversionWaves waves;
+
+            for (size_t i = 0; i < count; ++i) {
+                for (std::vector<size_t>::const_iterator it = reaches[i].begin(); it != reaches[i].end(); ++it) {
+                    if (*it < i) {
+                        waveOf[i] = std::max(waveOf[i], waveOf[*it] + 1);
+                    }
+                }
+
+                for (std::vector<size_t>::const_iterator it = reachedBy[i].begin(); it != reachedBy[i].end(); ++it) {
+                    if (*it < i) {
+                        waveOf[i] = std::max(waveOf[i], waveOf[*it]);
+                    }
+                }
+
+                if (waves.size() <= waveOf[i]) {
+                    waves.resize(waveOf[i] + 1);
+                }
+
+                waves[waveOf[i]].push_back(i);
+            }
+
+            return waves;
+        }
+
+        /**
+         * Result of converting a single named type
+         */
+        struct ConvertedType {
+            refract::IElement* element;
+            std::vector<snowcrash::Warning> warnings;
+            std::exception_ptr error;
+
+            ConvertedType() : element(NULL)
+            {
+            }
+        };
+
+        /**
+         * Converts named types of a wave, every one into its own element tree and
+         * with its own warnings, while the registry is only read.
+         */
+        struct ConvertTypeTask {
+
+            const DataStructures& sorted;
+            const std::vector<size_t>& wave;
+            std::vector<ConvertedType>& converted;
+            ConversionContext& context;
+
+            ConvertTypeTask(const DataStructures& sorted,
+                const std::vector<size_t>& wave,
+                std::vector<ConvertedType>& converted,
+                ConversionContext& context)
+                : sorted(sorted), wave(wave), converted(converted), context(context)
+            {
+            }
+
+            void operator()(size_t i) const
+            {
+                const size_t position = wave[i];
+                ConversionContext taskContext(context.options, context.GetNamedTypesRegistry());
+
+                try {
+                    converted[position].element = MSONToRefract(sorted[position], taskContext);
+                } catch (...) {
+                    converted[position].error = std::current_exception();
+                }
+
+                converted[position].warnings.swap(taskContext.warnings);
+            }
+        };
+
     } // ns anonymous
 
     void RegisterNamedTypes(const NodeInfo<snowcrash::Elements>& elements, ConversionContext& context)
@@ -386,12 +545,51 @@ namespace drafter
             }
         }
 
-        for (DataStructures::const_iterator i = found.begin(); i != found.end(); ++i) {
+        // second level registration - convert named types wave by wave, a wave concurrently
+        const ConversionWaves waves = SplitIntoWaves(found, typeInfo);
+        std::vector<ConvertedType> converted(found.size());
+        size_t failed = found.size(); // position of the first type failing to convert
+
+        size_t widest = 0;
+        for (ConversionWaves::const_iterator wave = waves.begin(); wave != waves.end(); ++wave) {
+            widest = std::max(widest, wave->size());
+        }
+
+        WorkerPool pool(WorkerPool::WorkersFor(widest));
+
+        for (ConversionWaves::const_iterator wave = waves.begin(); wave != waves.end(); ++wave) {
+
+            // Types sorted after a failed one would not have been converted at all
+            std::vector<size_t> positions;
+            for (std::vector<size_t>::const_iterator it = wave->begin(); it != wave->end(); ++it) {
+                if (*it < failed && !found[*it].node->name.symbol.literal.empty()) {
+                    positions.push_back(*it);
+                }
+            }
+
+            pool.run(positions.size(), ConvertTypeTask(found, positions, converted, context));
+
+            for (std::vector<size_t>::const_iterator it = positions.begin(); it != positions.end(); ++it) {
+                if (converted[*it].error) {
+                    failed = std::min(failed, *it);
+                }
+            }
 
-            if (!i->node->name.symbol.literal.empty()) {
+            for (std::vector<size_t>::const_iterator it = positions.begin(); it != positions.end(); ++it) {
 
-                const std::string& name = i->node->name.symbol.literal;
-                refract::IElement* element = MSONToRefract(*i, context);
+                refract::IElement* element = converted[*it].element;
+                converted[*it].element = NULL;
+
+                if (!element) {
+                    continue;
+                }
+
+                if (*it > failed) {
+                    delete element;
+                    continue;
+                }
+
+                const std::string& name = found[*it].node->name.symbol.literal;
 
 #ifdef DEBUG_DEPENDENCIES
                 refract::TypeQueryVisitor v;
@@ -409,11 +607,24 @@ namespace drafter
                 } catch (refract::LogicError& e) {
                     std::ostringstream out;
                     out << name << " is a reserved keyword and cannot be used.";
-                    throw snowcrash::Error(out.str(), snowcrash::MSONError, i->sourceMap->name.sourceMap);
+                    throw snowcrash::Error(out.str(), snowcrash::MSONError, found[*it].sourceMap->name.sourceMap);
                 }
             }
         }
 
+        // Warnings in the sorted order, as if converted one by one
+        for (size_t i = 0; i < converted.size() && i <= failed; ++i) {
+            for (std::vector<snowcrash::Warning>::const_iterator it = converted[i].warnings.begin();
+                 it != converted[i].warnings.end();
+                 ++it) {
+                context.warn(*it);
+            }
+        }
+
+        if (failed < found.size()) {
+            std::rethrow_exception(converted[failed].error);
+        }
+
 #ifdef DEBUG_DEPENDENCIES
         std::cout << "==DEPENDENCIES INFO END==" << std::endl;
 #endif /* DEBUG_DEPENDENCIES */
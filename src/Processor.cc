@@ -0,0 +1,90 @@
+//
+//  Processor.cc
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include "Processor.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#include "drafter.h"
+#include "reporting.h"
+#include "ResultCache.h"
+
+namespace
+{
+    /**
+     * \brief Key of cached result, everything the result depends on
+     */
+    std::string CacheKey(const Config& config, const std::string& source)
+    {
+        std::stringstream key;
+
+        key << drafter_version() << " " << config.format << " " << config.sourceMap << " " << config.validate << " "
+            << config.lineNumbers << "\n";
+        key << source;
+
+        return key.str();
+    }
+}
+
+void ProcessBlueprint(const Config& config, const std::string& source, ResultCache* cache, ProcessResult& result)
+{
+    std::string key;
+
+    if (cache) {
+        key = CacheKey(config, source);
+
+        if (cache->find(key, result)) {
+            return;
+        }
+    }
+
+    drafter_serialize_options options;
+    options.sourcemap = config.sourceMap;
+    options.format = config.format == drafter::YAMLFormat ? DRAFTER_SERIALIZE_YAML : DRAFTER_SERIALIZE_JSON;
+
+    drafter_result* parsed = nullptr;
+
+    // the command line tool does not require blueprint name
+    drafter_parse_options parseOptions = { false, config.parallel, NULL, { 0, 0, 0, 0 }, NULL, NULL, NULL };
+
+    result.status = drafter_parse_blueprint(source.c_str(), &parsed, parseOptions);
+
+    if (!parsed) {
+        result.status = -1;
+        return;
+    }
+
+    if (!config.validate) { // If not validate, we serialize
+        char* output = drafter_serialize(parsed, options);
+
+        if (output) {
+            result.output = output;
+            free(output);
+        }
+    }
+
+    std::stringstream report;
+    PrintReport(parsed, source, config.lineNumbers, result.status, report);
+    result.report = report.str();
+
+    drafter_free_result(parsed);
+
+    if (cache) {
+        cache->store(key, result);
+    }
+}
+
+void WriteResult(const ProcessResult& result, std::ostream& out)
+{
+    if (!result.output.empty()) {
+        out << result.output << "\n" << std::flush;
+    }
+
+    std::cerr << result.report;
+}
@@ -0,0 +1,51 @@
+//
+//  Processor.h
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#ifndef DRAFTER_PROCESSOR_H
+#define DRAFTER_PROCESSOR_H
+
+#include <ostream>
+#include <string>
+
+#include "config.h"
+
+class ResultCache;
+
+/**
+ *  \brief Result of processing a blueprint by the command line tool
+ */
+struct ProcessResult {
+    /** Exit code */
+    int status;
+
+    /** Serialized parse result, empty if only validated */
+    std::string output;
+
+    /** Report to be printed to stderr */
+    std::string report;
+
+    ProcessResult() : status(0)
+    {
+    }
+};
+
+/**
+ *  \brief Parse blueprint and serialize it as configured
+ *
+ *  Report is kept in result instead of being printed, so blueprints
+ *  can be processed concurrently.
+ *
+ *  \param cache Cache to serve results from and store them into, may be NULL
+ */
+void ProcessBlueprint(const Config& config, const std::string& source, ResultCache* cache, ProcessResult& result);
+
+/**
+ *  \brief Write result as the command line tool does, report goes to stderr
+ */
+void WriteResult(const ProcessResult& result, std::ostream& out);
+
+#endif // #ifndef DRAFTER_PROCESSOR_H
@@ -13,18 +13,22 @@
 
 #include "RefractSourceMap.h"
 
+#include <exception>
 #include <iterator>
+#include <memory>
 #include <set>
 
 #include "NamedTypesRegistry.h"
 #include "ConversionContext.h"
+#include "WorkerPool.h"
+
+#include "refract/Budget.h"
 
 namespace drafter
 {
 
-    // Forward Declarations
+    using refract::OwnedElements;
     using refract::RefractElements;
-    refract::IElement* ElementToRefract(const NodeInfo<snowcrash::Element>& element, ConversionContext& context);
 
     namespace
     {
@@ -40,34 +44,32 @@ namespace drafter
             elements.erase(std::remove_if(elements.begin(), elements.end(), IsNull<refract::IElement>), elements.end());
         }
 
-        template <typename T, typename Functor>
-        struct ContextBinder {
-
-            const Functor& functor;
-            ConversionContext& context;
-
-            ContextBinder(const Functor& functor, ConversionContext& context) : functor(functor), context(context)
-            {
-            }
-
-            refract::IElement* operator()(const NodeInfo<T>& nodeInfo) const
-            {
-                return functor(nodeInfo, context);
+        /**
+         * Poll the budget current in the calling thread, if any, before converting an element.
+         * Top-level sections give `done` of `total` sections converted.
+         */
+        void PollConversion(size_t done = 0, size_t total = 0)
+        {
+            if (refract::Budget* budget = refract::CurrentBudget()) {
+                budget->poll(refract::ConversionStage, done, total);
             }
-        };
+        }
 
         template <typename T, typename Functor>
         void NodeInfoToElements(const NodeInfo<T>& nodeInfo,
             const Functor& transformFunctor,
-            RefractElements& content,
+            OwnedElements& content,
             ConversionContext& context)
         {
             NodeInfoCollection<T> nodeInfoCollection(nodeInfo);
 
-            std::transform(nodeInfoCollection.begin(),
-                nodeInfoCollection.end(),
-                std::back_inserter(content),
-                ContextBinder<typename T::value_type, Functor>(transformFunctor, context));
+            for (typename NodeInfoCollection<T>::const_iterator it = nodeInfoCollection.begin();
+                 it != nodeInfoCollection.end();
+                 ++it) {
+
+                PollConversion();
+                content.push_back(transformFunctor(*it, context));
+            }
         }
 
         template <typename T, typename C, typename F>
@@ -76,8 +78,8 @@ namespace drafter
             const F& transformFunctor,
             const std::string& key = std::string())
         {
-            T* element = new T;
-            RefractElements content;
+            std::unique_ptr<T> element(new T);
+            OwnedElements content;
 
             if (!key.empty()) {
                 element->element(key);
@@ -85,11 +87,11 @@ namespace drafter
 
             NodeInfoToElements(collection, transformFunctor, content, context);
 
-            RemoveEmptyElements(content);
+            RemoveEmptyElements(content.get());
 
-            element->set(content);
+            element->set(content.release());
 
-            return element;
+            return element.release();
         }
     }
 
@@ -187,7 +189,7 @@ namespace drafter
 
     refract::IElement* ParameterToRefract(const NodeInfo<snowcrash::Parameter>& parameter, ConversionContext& context)
     {
-        refract::MemberElement* element = new refract::MemberElement;
+        std::unique_ptr<refract::MemberElement> element(new refract::MemberElement);
         refract::IElement* value = ExtractParameter(parameter, context);
         element->set(PrimitiveToRefract(MAKE_NODE_INFO(parameter, name)), value);
 
@@ -212,7 +214,7 @@ namespace drafter
         typeAttributes->push_back(refract::IElement::Create(use));
         element->attributes[SerializeKey::TypeAttributes] = typeAttributes;
 
-        return element;
+        return element.release();
     }
 
     refract::IElement* ParametersToRefract(
@@ -257,8 +259,8 @@ namespace drafter
         const NodeInfo<snowcrash::Action>& action,
         ConversionContext& context)
     {
-        refract::ArrayElement* element = new refract::ArrayElement;
-        RefractElements content;
+        std::unique_ptr<refract::ArrayElement> element(new refract::ArrayElement);
+        OwnedElements content;
 
         // Use HTTP method to recognize if request or response
         if (action.isNull() || action.node->method.empty()) {
@@ -279,12 +281,12 @@ namespace drafter
             }
         }
 
-        AttachSourceMap(element, payload);
+        AttachSourceMap(element.get(), payload);
 
         // If no payload, return immediately
         if (payload.isNull()) {
-            element->set(content);
-            return element;
+            element->set(content.release());
+            return element.release();
         }
 
         if (!payload.node->parameters.empty()) {
@@ -305,8 +307,10 @@ namespace drafter
         // in a payload gets converted to refract 3 times which is something we should fix.
         try {
             // Render using boutique
-            NodeInfoByValue<snowcrash::Asset> payloadBody = renderPayloadBody(payload, action, context);
-            NodeInfoByValue<snowcrash::Asset> payloadSchema = renderPayloadSchema(payload, action, context);
+            snowcrash::Asset renderedBody, renderedSchema;
+            NodeInfo<snowcrash::Asset> payloadBody = renderPayloadBody(payload, action, context, renderedBody);
+            NodeInfo<snowcrash::Asset> payloadSchema
+                = renderPayloadSchema(payload, action, context, renderedSchema);
 
             // Get content type
             std::string contentType = getContentTypeFromHeaders(payload.node->headers);
@@ -314,13 +318,11 @@ namespace drafter
                 = snowcrash::RegexMatch(contentType, JSONRegex) ? JSONSchemaContentType : contentType;
 
             // Push Body Asset
-            content.push_back(
-                AssetToRefract(NodeInfo<snowcrash::Asset>(payloadBody), contentType, SerializeKey::MessageBody));
+            content.push_back(AssetToRefract(payloadBody, contentType, SerializeKey::MessageBody));
 
             // Render only if Body is JSON or Schema is defined
-            if (!payloadSchema.first.empty()) {
-                content.push_back(AssetToRefract(
-                    NodeInfo<snowcrash::Asset>(payloadSchema), schemaContentType, SerializeKey::MessageBodySchema));
+            if (!payloadSchema.node->empty()) {
+                content.push_back(AssetToRefract(payloadSchema, schemaContentType, SerializeKey::MessageBodySchema));
             }
         }
 
@@ -341,10 +343,10 @@ namespace drafter
                 payload.sourceMap->sourceMap));
         }
 
-        RemoveEmptyElements(content);
-        element->set(content);
+        RemoveEmptyElements(content.get());
+        element->set(content.release());
 
-        return element;
+        return element.release();
     }
 
     refract::IElement* TransactionToRefract(const NodeInfo<snowcrash::TransactionExample>& transaction,
@@ -353,8 +355,8 @@ namespace drafter
         const NodeInfo<snowcrash::Response>& response,
         ConversionContext& context)
     {
-        refract::ArrayElement* element = new refract::ArrayElement;
-        RefractElements content;
+        std::unique_ptr<refract::ArrayElement> element(new refract::ArrayElement);
+        OwnedElements content;
 
         element->element(SerializeKey::HTTPTransaction);
         content.push_back(CopyToRefract(MAKE_NODE_INFO(transaction, description)));
@@ -362,16 +364,16 @@ namespace drafter
         content.push_back(PayloadToRefract(request, action, context));
         content.push_back(PayloadToRefract(response, NodeInfo<snowcrash::Action>(), context));
 
-        RemoveEmptyElements(content);
-        element->set(content);
+        RemoveEmptyElements(content.get());
+        element->set(content.release());
 
-        return element;
+        return element.release();
     }
 
     refract::IElement* ActionToRefract(const NodeInfo<snowcrash::Action>& action, ConversionContext& context)
     {
-        refract::ArrayElement* element = new refract::ArrayElement;
-        RefractElements content;
+        std::unique_ptr<refract::ArrayElement> element(new refract::ArrayElement);
+        OwnedElements content;
 
         element->element(SerializeKey::Transition);
         element->meta[SerializeKey::Title] = PrimitiveToRefract(MAKE_NODE_INFO(action, name));
@@ -439,16 +441,16 @@ namespace drafter
             }
         }
 
-        RemoveEmptyElements(content);
-        element->set(content);
+        RemoveEmptyElements(content.get());
+        element->set(content.release());
 
-        return element;
+        return element.release();
     }
 
     refract::IElement* ResourceToRefract(const NodeInfo<snowcrash::Resource>& resource, ConversionContext& context)
     {
-        refract::ArrayElement* element = new refract::ArrayElement;
-        RefractElements content;
+        std::unique_ptr<refract::ArrayElement> element(new refract::ArrayElement);
+        OwnedElements content;
 
         element->element(SerializeKey::Resource);
 
@@ -465,11 +467,11 @@ namespace drafter
         content.push_back(DataStructureToRefract(MAKE_NODE_INFO(resource, attributes), context));
         NodeInfoToElements(MAKE_NODE_INFO(resource, actions), ActionToRefract, content, context);
 
-        RemoveEmptyElements(content);
+        RemoveEmptyElements(content.get());
 
-        element->set(content);
+        element->set(content.release());
 
-        return element;
+        return element.release();
     }
 
     const snowcrash::SourceMap<snowcrash::Elements>* GetElementChildrenSourceMap(
@@ -480,19 +482,30 @@ namespace drafter
             &element.sourceMap->content.elements();
     }
 
-    refract::IElement* CategoryToRefract(const NodeInfo<snowcrash::Element>& element, ConversionContext& context)
+    namespace
     {
-        refract::ArrayElement* category = new refract::ArrayElement;
-        RefractElements content;
 
-        category->element(SerializeKey::Category);
+        refract::ArrayElement* CategoryHeadToRefract(const NodeInfo<snowcrash::Element>& element)
+        {
+            refract::ArrayElement* category = new refract::ArrayElement;
+
+            category->element(SerializeKey::Category);
 
-        if (element.node->category == snowcrash::Element::ResourceGroupCategory) {
-            category->meta[SerializeKey::Classes] = CreateArrayElement(SerializeKey::ResourceGroup);
-            category->meta[SerializeKey::Title] = PrimitiveToRefract(MAKE_NODE_INFO(element, attributes.name));
-        } else if (element.node->category == snowcrash::Element::DataStructureGroupCategory) {
-            category->meta[SerializeKey::Classes] = CreateArrayElement(SerializeKey::DataStructures);
+            if (element.node->category == snowcrash::Element::ResourceGroupCategory) {
+                category->meta[SerializeKey::Classes] = CreateArrayElement(SerializeKey::ResourceGroup);
+                category->meta[SerializeKey::Title] = PrimitiveToRefract(MAKE_NODE_INFO(element, attributes.name));
+            } else if (element.node->category == snowcrash::Element::DataStructureGroupCategory) {
+                category->meta[SerializeKey::Classes] = CreateArrayElement(SerializeKey::DataStructures);
+            }
+
+            return category;
         }
+    }
+
+    refract::IElement* CategoryToRefract(const NodeInfo<snowcrash::Element>& element, ConversionContext& context)
+    {
+        std::unique_ptr<refract::ArrayElement> category(CategoryHeadToRefract(element));
+        OwnedElements content;
 
         if (!element.node->content.elements().empty()) {
             const NodeInfo<snowcrash::Elements> elementsNodeInfo
@@ -501,10 +514,10 @@ namespace drafter
             NodeInfoToElements(elementsNodeInfo, ElementToRefract, content, context);
         }
 
-        RemoveEmptyElements(content);
-        category->set(content);
+        RemoveEmptyElements(content.get());
+        category->set(content.release());
 
-        return category;
+        return category.release();
     }
 
     refract::IElement* ElementToRefract(const NodeInfo<snowcrash::Element>& element, ConversionContext& context)
@@ -527,32 +540,277 @@ namespace drafter
         }
     }
 
+    namespace
+    {
+
+        refract::ArrayElement* BlueprintHeadToRefract(
+            const NodeInfo<snowcrash::Blueprint>& blueprint, OwnedElements& content, ConversionContext& context)
+        {
+            std::unique_ptr<refract::ArrayElement> ast(new refract::ArrayElement);
+
+            ast->element(SerializeKey::Category);
+
+            ast->meta[SerializeKey::Classes] = CreateArrayElement(SerializeKey::API);
+            ast->meta[SerializeKey::Title] = PrimitiveToRefract(MAKE_NODE_INFO(blueprint, name));
+
+            content.push_back(CopyToRefract(MAKE_NODE_INFO(blueprint, description)));
+
+            if (!blueprint.node->metadata.empty()) {
+                ast->attributes[SerializeKey::Metadata] = CollectionToRefract<refract::ArrayElement>(
+                    MAKE_NODE_INFO(blueprint, metadata), context, MetadataToRefract);
+            }
+
+            return ast.release();
+        }
+
+        /**
+         * Release memory held by value.
+         *
+         * Assignment of empty value is not enough, std::string and std::vector
+         * keep their capacity, so we swap content with temporary instead.
+         */
+        template <typename T>
+        void Release(T& value)
+        {
+            T empty;
+            std::swap(value, empty);
+        }
+
+        // NOTE: snowcrash::Element has no move semantic - swapping whole element
+        // would deep copy it, so we release its members one by one
+        void ReleaseElement(snowcrash::Element& element)
+        {
+            Release(element.attributes.name);
+            Release(element.content.copy);
+            Release(element.content.resource);
+            Release(element.content.dataStructure);
+            Release(element.content.elements());
+        }
+
+        void ReleaseElement(snowcrash::SourceMap<snowcrash::Element>& sourceMap)
+        {
+            Release(sourceMap.sourceMap);
+            Release(sourceMap.attributes.name);
+            Release(sourceMap.content.copy);
+            Release(sourceMap.content.resource);
+            Release(sourceMap.content.dataStructure);
+            Release(sourceMap.content.elements().collection);
+        }
+
+        /**
+         * Categories are split into their children, so resources
+         * of a single large group are converted concurrently too
+         */
+        bool IsSplitIntoChildren(const NodeInfo<snowcrash::Element>& element)
+        {
+            return element.node->element == snowcrash::Element::CategoryElement
+                && !element.node->content.elements().empty();
+        }
+
+        /**
+         * Result of converting a single element
+         */
+        struct ConvertedElement {
+            std::unique_ptr<refract::IElement> element;
+            std::vector<snowcrash::Warning> warnings;
+            std::exception_ptr error;
+        };
+
+        /**
+         * Converts elements, every one with its own warnings,
+         * while the named types registry is only read.
+         */
+        struct ConvertElementTask {
+
+            const NodeInfoCollection<snowcrash::Elements>::CollectionType& elements;
+            std::vector<ConvertedElement>& converted;
+            ConversionContext& context;
+
+            ConvertElementTask(const NodeInfoCollection<snowcrash::Elements>::CollectionType& elements,
+                std::vector<ConvertedElement>& converted,
+                ConversionContext& context)
+                : elements(elements), converted(converted), context(context)
+            {
+            }
+
+            void operator()(size_t i) const
+            {
+                ConversionContext taskContext(context.options, context.GetNamedTypesRegistry());
+
+                try {
+                    PollConversion(i, elements.size());
+                    converted[i].element.reset(ElementToRefract(elements[i], taskContext));
+                } catch (...) {
+                    converted[i].error = std::current_exception();
+                }
+
+                converted[i].warnings.swap(taskContext.warnings);
+            }
+        };
+
+        /**
+         * Convert top-level elements on a worker pool.
+         *
+         * Elements and warnings are merged in document order, so both
+         * the result and annotations are the same as of serial conversion.
+         */
+        void ElementsToRefractConcurrently(
+            const NodeInfoCollection<snowcrash::Elements>& elements, OwnedElements& content, ConversionContext& context)
+        {
+            NodeInfoCollection<snowcrash::Elements>::CollectionType tasks;
+            std::vector<size_t> firstTask; // first task of every top-level element
+
+            for (NodeInfoCollection<snowcrash::Elements>::const_iterator it = elements.begin(); it != elements.end();
+                 ++it) {
+
+                firstTask.push_back(tasks.size());
+
+                if (IsSplitIntoChildren(*it)) {
+                    NodeInfoCollection<snowcrash::Elements> children(
+                        MakeNodeInfo(&it->node->content.elements(), GetElementChildrenSourceMap(*it)));
+                    tasks.insert(tasks.end(), children.begin(), children.end());
+                } else {
+                    tasks.push_back(*it);
+                }
+            }
+
+            firstTask.push_back(tasks.size());
+
+            std::vector<ConvertedElement> converted(tasks.size());
+
+            {
+                WorkerPool pool(WorkerPool::WorkersFor(tasks.size()));
+                pool.run(tasks.size(), ConvertElementTask(tasks, converted, context));
+            }
+
+            PollConversion(tasks.size(), tasks.size());
+
+            // Serial conversion stops at the first failing element, keeping warnings issued until then
+            size_t failed = 0;
+            while (failed < converted.size() && !converted[failed].error) {
+                ++failed;
+            }
+
+            for (size_t i = 0; i < converted.size() && i <= failed; ++i) {
+                for (std::vector<snowcrash::Warning>::const_iterator it = converted[i].warnings.begin();
+                     it != converted[i].warnings.end();
+                     ++it) {
+                    context.warn(*it);
+                }
+            }
+
+            if (failed < converted.size()) {
+                std::rethrow_exception(converted[failed].error);
+            }
+
+            for (size_t i = 0; i < elements.size(); ++i) {
+                if (!IsSplitIntoChildren(elements[i])) {
+                    content.push_back(converted[firstTask[i]].element.release());
+                    continue;
+                }
+
+                std::unique_ptr<refract::ArrayElement> category(CategoryHeadToRefract(elements[i]));
+                OwnedElements children;
+
+                for (size_t j = firstTask[i]; j < firstTask[i + 1]; ++j) {
+                    children.push_back(converted[j].element.release());
+                }
+
+                RemoveEmptyElements(children.get());
+                category->set(children.release());
+
+                content.push_back(category.release());
+            }
+        }
+    }
+
     refract::IElement* BlueprintToRefract(const NodeInfo<snowcrash::Blueprint>& blueprint, ConversionContext& context)
     {
-        refract::ArrayElement* ast = new refract::ArrayElement;
-        RefractElements content;
+        OwnedElements content;
+        std::unique_ptr<refract::ArrayElement> ast(BlueprintHeadToRefract(blueprint, content, context));
+
+        if (context.options.parallelConversion) {
+            ElementsToRefractConcurrently(MAKE_NODE_INFO(blueprint, content.elements()), content, context);
+        } else {
+            NodeInfoCollection<snowcrash::Elements> elements(MAKE_NODE_INFO(blueprint, content.elements()));
+
+            for (size_t i = 0; i < elements.size(); ++i) {
+                PollConversion(i, elements.size());
+                content.push_back(ElementToRefract(elements[i], context));
+            }
+
+            PollConversion(elements.size(), elements.size());
+        }
+
+        RemoveEmptyElements(content.get());
+        ast->set(content.release());
 
-        ast->element(SerializeKey::Category);
+        return ast.release();
+    }
 
-        ast->meta[SerializeKey::Classes] = CreateArrayElement(SerializeKey::API);
-        ast->meta[SerializeKey::Title] = PrimitiveToRefract(MAKE_NODE_INFO(blueprint, name));
+    refract::IElement* BlueprintToRefract(
+        const NodeInfo<snowcrash::Blueprint>& blueprint, ConversionContext& context, const ElementConverter& converter)
+    {
+        OwnedElements content;
+        std::unique_ptr<refract::ArrayElement> ast(BlueprintHeadToRefract(blueprint, content, context));
 
-        content.push_back(CopyToRefract(MAKE_NODE_INFO(blueprint, description)));
+        NodeInfoCollection<snowcrash::Elements> elements(MAKE_NODE_INFO(blueprint, content.elements()));
 
-        if (!blueprint.node->metadata.empty()) {
-            ast->attributes[SerializeKey::Metadata] = CollectionToRefract<refract::ArrayElement>(
-                MAKE_NODE_INFO(blueprint, metadata), context, MetadataToRefract);
+        for (size_t i = 0; i < elements.size(); ++i) {
+            PollConversion(i, elements.size());
+            content.push_back(converter(i, elements[i], context));
+        }
+
+        PollConversion(elements.size(), elements.size());
+
+        RemoveEmptyElements(content.get());
+        ast->set(content.release());
+
+        return ast.release();
+    }
+
+    refract::IElement* BlueprintToRefract(snowcrash::Blueprint& blueprint,
+        snowcrash::SourceMap<snowcrash::Blueprint>& sourceMap,
+        ConversionContext& context)
+    {
+        OwnedElements content;
+        std::unique_ptr<refract::ArrayElement> ast(
+            BlueprintHeadToRefract(MakeNodeInfo(blueprint, sourceMap), content, context));
+
+        snowcrash::Elements& elements = blueprint.content.elements();
+        snowcrash::SourceMap<snowcrash::Elements>& sourceMaps = sourceMap.content.elements();
+
+        // same rule as in NodeInfoCollection<> - use source maps only if they fit to elements
+        const bool hasSourceMap = elements.size() == sourceMaps.collection.size();
+
+        // elements converted concurrently are released once all of them are converted
+        if (context.options.parallelConversion) {
+            ElementsToRefractConcurrently(
+                NodeInfoCollection<snowcrash::Elements>(elements, sourceMaps), content, context);
+        } else {
+            for (size_t i = 0; i < elements.size(); ++i) {
+                if (hasSourceMap) {
+                    content.push_back(ElementToRefract(MakeNodeInfo(elements[i], sourceMaps.collection[i]), context));
+                    ReleaseElement(sourceMaps.collection[i]);
+                } else {
+                    content.push_back(ElementToRefract(MakeNodeInfoWithoutSourceMap(elements[i]), context));
+                }
+
+                ReleaseElement(elements[i]);
+            }
         }
 
-        NodeInfoToElements(MAKE_NODE_INFO(blueprint, content.elements()), ElementToRefract, content, context);
+        Release(elements);
+        Release(sourceMaps.collection);
 
-        RemoveEmptyElements(content);
-        ast->set(content);
+        RemoveEmptyElements(content.get());
+        ast->set(content.release());
 
-        return ast;
+        return ast.release();
     }
 
-    refract::IElement* AnnotationToRefract(const snowcrash::SourceAnnotation& annotation, const std::string& key)
+    refract::IElement* AnnotationToRefract(
+        const snowcrash::SourceAnnotation& annotation, const mdp::CharactersRangeSet& location, const std::string& key)
     {
         refract::IElement* element = refract::IElement::Create(annotation.message);
 
@@ -561,7 +819,7 @@ namespace drafter
         element->meta[SerializeKey::Classes] = CreateArrayElement(key);
 
         element->attributes[SerializeKey::AnnotationCode] = refract::IElement::Create(annotation.code);
-        element->attributes[SerializeKey::SourceMap] = SourceMapToRefract(annotation.location);
+        element->attributes[SerializeKey::SourceMap] = SourceMapToRefract(location);
 
         return element;
     }
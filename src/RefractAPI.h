@@ -11,6 +11,8 @@
 
 #include "Serialize.h"
 
+#include <functional>
+
 namespace snowcrash
 {
     struct SourceAnnotation;
@@ -21,11 +23,44 @@ namespace drafter
 
     class ConversionContext;
 
-    refract::IElement* AnnotationToRefract(const snowcrash::SourceAnnotation& annotation, const std::string& key);
+    /**
+     * Converts an annotation located by `location`, character ranges
+     * of an annotation reported by snowcrash or the byte ranges of one
+     * reported by the conversion
+     */
+    refract::IElement* AnnotationToRefract(
+        const snowcrash::SourceAnnotation& annotation, const mdp::CharactersRangeSet& location, const std::string& key);
 
     refract::IElement* DataStructureToRefract(
         const NodeInfo<snowcrash::DataStructure>& dataStructure, ConversionContext& context);
+    refract::IElement* ElementToRefract(const NodeInfo<snowcrash::Element>& element, ConversionContext& context);
     refract::IElement* BlueprintToRefract(const NodeInfo<snowcrash::Blueprint>& blueprint, ConversionContext& context);
+
+    /**
+     * Converts top-level element of blueprint, given its index in blueprint content
+     */
+    typedef std::function<refract::IElement*(size_t, const NodeInfo<snowcrash::Element>&, ConversionContext&)>
+        ElementConverter;
+
+    /**
+     * Convert blueprint into refract, top-level elements are converted by `converter`
+     * instead of ElementToRefract(), so it is able to reuse elements converted before.
+     */
+    refract::IElement* BlueprintToRefract(
+        const NodeInfo<snowcrash::Blueprint>& blueprint, ConversionContext& context, const ElementConverter& converter);
+
+    /**
+     * Convert blueprint into refract and release snowcrash subtree (including source maps)
+     * of every top-level element as soon as it is converted, so peak memory consumption
+     * is bounded by roughly one representation of document instead of both.
+     *
+     * Named types MUST be registered (\see RegisterNamedTypes()) before calling this,
+     * because elements released before are no longer available for type resolution.
+     * Content of `blueprint` and `sourceMap` is left empty.
+     */
+    refract::IElement* BlueprintToRefract(snowcrash::Blueprint& blueprint,
+        snowcrash::SourceMap<snowcrash::Blueprint>& sourceMap,
+        ConversionContext& context);
 }
 
 #endif // #ifndef DRAFTER_REFRACTAST_H
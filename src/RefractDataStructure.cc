@@ -20,6 +20,8 @@
 
 #include "ElementData.h"
 
+#include <memory>
+
 namespace drafter
 {
 
@@ -1368,15 +1370,17 @@ namespace drafter
             return element;
         }
 
+        // released if the expansion is cancelled
+        std::unique_ptr<refract::IElement> owned(element);
+
         refract::ExpandVisitor expander(context.GetNamedTypesRegistry());
         refract::Visit(expander, *element);
 
         if (refract::IElement* expanded = expander.get()) {
-            delete element;
-            element = expanded;
+            return expanded;
         }
 
-        return element;
+        return owned.release();
     }
 
     sos::Object SerializeRefract(refract::IElement* element, ConversionContext& context)
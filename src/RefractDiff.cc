@@ -0,0 +1,303 @@
+//
+//  RefractDiff.cc
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include "RefractDiff.h"
+
+#include <map>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "Serialize.h"
+#include "refract/Element.h"
+#include "refract/StructuralHash.h"
+#include "refract/TypeQueryVisitor.h"
+
+using namespace refract;
+
+namespace drafter
+{
+
+    namespace
+    {
+
+        const std::string Diff = "diff";
+        const std::string Change = "change";
+        const std::string Added = "added";
+        const std::string Removed = "removed";
+        const std::string Changed = "changed";
+        const std::string Base = "base";
+        const std::string Head = "head";
+
+        typedef std::vector<std::string> Path;
+
+        std::string StringValue(const IElement* e)
+        {
+            const StringElement* s = TypeQueryVisitor::as<StringElement>(e);
+            return s ? s->value : std::string();
+        }
+
+        std::string Value(const IElement::MemberElementCollection& collection, const std::string& key)
+        {
+            IElement::MemberElementCollection::const_iterator it = collection.find(key);
+            return it != collection.end() ? StringValue((*it)->value.second) : std::string();
+        }
+
+        std::string FirstClass(const IElement& e)
+        {
+            IElement::MemberElementCollection::const_iterator it = e.meta.find(SerializeKey::Classes);
+
+            if (it == e.meta.end()) {
+                return std::string();
+            }
+
+            const ArrayElement* classes = TypeQueryVisitor::as<ArrayElement>((*it)->value.second);
+            return classes && !classes->value.empty() ? StringValue(classes->value.front()) : std::string();
+        }
+
+        /**
+         * \return Children matched by identity, NULL for elements compared as a whole
+         */
+        const RefractElements* Children(const IElement& e)
+        {
+            const std::string name = e.element();
+
+            if (name != SerializeKey::ParseResult && name != SerializeKey::Category && name != SerializeKey::Resource
+                && name != SerializeKey::Transition && name != SerializeKey::HTTPTransaction) {
+                return NULL;
+            }
+
+            const ArrayElement* array = TypeQueryVisitor::as<ArrayElement>(&e);
+            return array ? &array->value : NULL;
+        }
+
+        /** Method of the first request of transition */
+        std::string Method(const IElement& transition)
+        {
+            const RefractElements* transactions = Children(transition);
+
+            if (!transactions) {
+                return std::string();
+            }
+
+            for (RefractElements::const_iterator it = transactions->begin(); it != transactions->end(); ++it) {
+                if (!*it || (*it)->element() != SerializeKey::HTTPTransaction) {
+                    continue;
+                }
+
+                const ArrayElement* transaction = TypeQueryVisitor::as<ArrayElement>(*it);
+
+                if (!transaction) {
+                    continue;
+                }
+
+                for (RefractElements::const_iterator message = transaction->value.begin();
+                     message != transaction->value.end();
+                     ++message) {
+                    if (*message && (*message)->element() == SerializeKey::HTTPRequest) {
+                        return Value((*message)->attributes, SerializeKey::Method);
+                    }
+                }
+            }
+
+            return std::string();
+        }
+
+        /**
+         * \return Identity of element among its siblings, empty if it is matched by order
+         */
+        std::string Identity(const IElement& e)
+        {
+            const std::string name = e.element();
+
+            if (name == SerializeKey::Category) {
+                return FirstClass(e) + " " + Value(e.meta, SerializeKey::Title);
+            }
+
+            if (name == SerializeKey::Resource) {
+                std::string href = Value(e.attributes, SerializeKey::Href);
+                return href.empty() ? Value(e.meta, SerializeKey::Title) : href;
+            }
+
+            if (name == SerializeKey::Transition) {
+                const std::string href = Value(e.attributes, SerializeKey::Href);
+                return href.empty() ? Method(e) : Method(e) + " " + href;
+            }
+
+            if (name == SerializeKey::DataStructure) {
+                const HolderElement* holder = TypeQueryVisitor::as<HolderElement>(&e);
+                return holder && holder->value ? Value(holder->value->meta, SerializeKey::Id) : std::string();
+            }
+
+            return std::string();
+        }
+
+        /**
+         * \brief Keys of children, identities or element names numbered by order
+         *
+         * Siblings of the same identity are numbered too, so every key is unique.
+         */
+        std::vector<std::string> Keys(const RefractElements& children)
+        {
+            std::vector<std::string> keys;
+            std::map<std::string, size_t> occurrences;
+
+            for (RefractElements::const_iterator it = children.begin(); it != children.end(); ++it) {
+                std::string key = *it ? (*it)->element() + ":" + Identity(**it) : std::string();
+
+                std::stringstream numbered;
+                numbered << key << "#" << occurrences[key]++;
+
+                keys.push_back(numbered.str());
+            }
+
+            return keys;
+        }
+
+        std::string Segment(const IElement& e)
+        {
+            std::string identity = Identity(e);
+
+            if (e.element() == SerializeKey::Category) {
+                identity = Value(e.meta, SerializeKey::Title);
+
+                if (identity.empty()) {
+                    identity = FirstClass(e);
+                }
+            }
+
+            return identity.empty() ? e.element() : identity;
+        }
+
+        class Differ
+        {
+            StructuralHash hash;
+            ArrayElement* changes;
+
+            void report(const std::string& kind, const Path& path, IElement* base, IElement* head)
+            {
+                ArrayElement* segments = new ArrayElement;
+
+                for (Path::const_iterator it = path.begin(); it != path.end(); ++it) {
+                    segments->push_back(IElement::Create(*it));
+                }
+
+                ObjectElement* change = new ObjectElement;
+                change->element(Change);
+                change->meta[SerializeKey::Classes] = CreateArrayElement(kind);
+                change->push_back(new MemberElement(SerializeKey::Path, segments));
+
+                if (base) {
+                    change->push_back(new MemberElement(Base, base));
+                }
+
+                if (head) {
+                    change->push_back(new MemberElement(Head, head));
+                }
+
+                changes->push_back(change);
+            }
+
+        public:
+            Differ() : hash(true), changes(new ArrayElement)
+            {
+                changes->element(Diff);
+            }
+
+            ArrayElement* release()
+            {
+                ArrayElement* result = changes;
+                changes = NULL;
+                return result;
+            }
+
+            ~Differ()
+            {
+                delete changes;
+            }
+
+            void diff(const IElement& base, const IElement& head, Path& path)
+            {
+                if (hash.equal(&base, &head)) {
+                    return;
+                }
+
+                const RefractElements* baseChildren = Children(base);
+                const RefractElements* headChildren = Children(head);
+
+                if (!baseChildren || !headChildren || base.element() != head.element()) {
+                    report(Changed, path, base.clone(), head.clone());
+                    return;
+                }
+
+                const int own = IElement::cMeta | IElement::cAttributes | IElement::cElement;
+                std::unique_ptr<IElement> baseOwn(base.clone(own));
+                std::unique_ptr<IElement> headOwn(head.clone(own));
+
+                // copies are compared by hash of their own, memoized hashes are kept for the compared trees
+                StructuralHash ownHash(hash.ignoresSourceMaps());
+
+                if (!ownHash.equal(baseOwn.get(), headOwn.get())) {
+                    report(Changed, path, baseOwn.release(), headOwn.release());
+                }
+
+                diff(*baseChildren, *headChildren, path);
+            }
+
+            void diff(const RefractElements& base, const RefractElements& head, Path& path)
+            {
+                const std::vector<std::string> baseKeys = Keys(base);
+                const std::vector<std::string> headKeys = Keys(head);
+
+                std::map<std::string, size_t> headIndexes;
+
+                for (size_t i = 0; i < headKeys.size(); ++i) {
+                    headIndexes[headKeys[i]] = i;
+                }
+
+                std::vector<bool> matched(head.size(), false);
+
+                for (size_t i = 0; i < base.size(); ++i) {
+                    if (!base[i]) {
+                        continue;
+                    }
+
+                    path.push_back(Segment(*base[i]));
+
+                    std::map<std::string, size_t>::const_iterator found = headIndexes.find(baseKeys[i]);
+
+                    if (found == headIndexes.end() || !head[found->second]) {
+                        report(Removed, path, base[i]->clone(), NULL);
+                    } else {
+                        matched[found->second] = true;
+                        diff(*base[i], *head[found->second], path);
+                    }
+
+                    path.pop_back();
+                }
+
+                for (size_t i = 0; i < head.size(); ++i) {
+                    if (!matched[i] && head[i]) {
+                        path.push_back(Segment(*head[i]));
+                        report(Added, path, NULL, head[i]->clone());
+                        path.pop_back();
+                    }
+                }
+            }
+        };
+    }
+
+    IElement* DiffParseResults(const IElement& base, const IElement& head)
+    {
+        Differ differ;
+        Path path;
+
+        differ.diff(base, head, path);
+
+        return differ.release();
+    }
+}
@@ -0,0 +1,41 @@
+//
+//  RefractDiff.h
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#ifndef DRAFTER_REFRACTDIFF_H
+#define DRAFTER_REFRACTDIFF_H
+
+#include <string>
+
+namespace refract
+{
+    struct IElement;
+}
+
+namespace drafter
+{
+
+    /**
+     * \brief Semantic difference of two refract parse results
+     *
+     * Categories are matched by class and title, resources by URI template,
+     * transitions by method and URI template and data structures by name.
+     * Other elements are matched by their order among the siblings of the
+     * same element name. Unchanged subtrees are skipped by their structural
+     * hash and source maps are ignored.
+     *
+     * Every change is an element `change` of class `added`, `removed` or
+     * `changed` with members `path` (identities of the matched ancestors),
+     * `base` and `head` (copies of the element, as present). A changed
+     * category, resource, transition or HTTP transaction is reported without
+     * its content, changes of its children follow it.
+     *
+     * \return Array element `diff` of changes, owned by caller
+     */
+    refract::IElement* DiffParseResults(const refract::IElement& base, const refract::IElement& head);
+}
+
+#endif // #ifndef DRAFTER_REFRACTDIFF_H
@@ -18,6 +18,8 @@
 #include "refract/RenderJSONVisitor.h"
 #include "refract/JSONSchemaVisitor.h"
 
+#include <memory>
+
 using namespace snowcrash;
 
 namespace drafter
@@ -50,11 +52,11 @@ namespace drafter
         return "";
     }
 
-    NodeInfoByValue<Asset> renderPayloadBody(
-        const NodeInfo<Payload>& payload, const NodeInfo<Action>& action, ConversionContext& context)
+    NodeInfo<Asset> renderPayloadBody(
+        const NodeInfo<Payload>& payload, const NodeInfo<Action>& action, ConversionContext& context, Asset& rendered)
     {
 
-        NodeInfoByValue<Asset> body = std::make_pair(payload.node->body, &payload.sourceMap->body);
+        NodeInfo<Asset> body = MAKE_NODE_INFO(payload, body);
 
         NodeInfo<Attributes> payloadAttributes = MAKE_NODE_INFO(payload, attributes);
         NodeInfo<Attributes> actionAttributes = MAKE_NODE_INFO(action, attributes);
@@ -80,7 +82,7 @@ namespace drafter
             return body;
         }
 
-        refract::IElement* expanded = ExpandRefract(element, context);
+        std::unique_ptr<refract::IElement> expanded(ExpandRefract(element, context));
 
         if (!expanded) {
             return body;
@@ -92,18 +94,17 @@ namespace drafter
                 refract::RenderJSONVisitor renderer;
                 refract::Visit(renderer, *expanded);
 
-                delete expanded;
+                expanded.reset();
 
-                return std::make_pair(renderer.getString(), NodeInfo<Asset>::NullSourceMap());
+                rendered = renderer.getString();
+                return NodeInfo<Asset>(&rendered, NodeInfo<Asset>::NullSourceMap());
             }
 
             case JSONSchemaRenderFormat: {
                 refract::JSONSchemaVisitor renderer;
-                std::string result = renderer.getSchema(*expanded);
-
-                delete expanded;
+                rendered = renderer.getSchema(*expanded);
 
-                return std::make_pair(result, NodeInfo<Asset>::NullSourceMap());
+                return NodeInfo<Asset>(&rendered, NodeInfo<Asset>::NullSourceMap());
             }
 
             case UndefinedRenderFormat:
@@ -114,12 +115,13 @@ namespace drafter
         throw snowcrash::Error("unknown content type for messageBody to be rendered", snowcrash::ApplicationError);
     }
 
-    NodeInfoByValue<Asset> renderPayloadSchema(const NodeInfo<snowcrash::Payload>& payload,
+    NodeInfo<Asset> renderPayloadSchema(const NodeInfo<snowcrash::Payload>& payload,
         const NodeInfo<snowcrash::Action>& action,
-        ConversionContext& context)
+        ConversionContext& context,
+        Asset& rendered)
     {
 
-        NodeInfoByValue<Asset> schema = std::make_pair(payload.node->schema, &payload.sourceMap->schema);
+        NodeInfo<Asset> schema = MAKE_NODE_INFO(payload, schema);
 
         NodeInfo<Attributes> payloadAttributes = MAKE_NODE_INFO(payload, attributes);
         NodeInfo<Attributes> actionAttributes = MAKE_NODE_INFO(action, attributes);
@@ -145,15 +147,14 @@ namespace drafter
             return schema;
         }
 
-        refract::IElement* expanded = ExpandRefract(element, context);
+        std::unique_ptr<refract::IElement> expanded(ExpandRefract(element, context));
 
         if (!expanded) {
             return schema;
         }
 
-        std::string result = renderer.getSchema(*expanded);
-        delete expanded;
+        rendered = renderer.getSchema(*expanded);
 
-        return std::make_pair(result, NodeInfo<Asset>::NullSourceMap());
+        return NodeInfo<Asset>(&rendered, NodeInfo<Asset>::NullSourceMap());
     }
 }
@@ -30,13 +30,23 @@ namespace drafter
     RenderFormat findRenderFormat(const std::string& contentType);
     std::string getContentTypeFromHeaders(const snowcrash::Headers& headers);
 
-    NodeInfoByValue<snowcrash::Asset> renderPayloadBody(const NodeInfo<snowcrash::Payload>& payload,
+    /**
+     * Body asset of the payload, or the body rendered from its attributes into `rendered`.
+     * The body of the payload is not copied.
+     */
+    NodeInfo<snowcrash::Asset> renderPayloadBody(const NodeInfo<snowcrash::Payload>& payload,
         const NodeInfo<snowcrash::Action>& action,
-        ConversionContext& context);
-
-    NodeInfoByValue<snowcrash::Asset> renderPayloadSchema(const NodeInfo<snowcrash::Payload>& payload,
+        ConversionContext& context,
+        snowcrash::Asset& rendered);
+
+    /**
+     * Schema asset of the payload, or the schema rendered from its attributes into `rendered`.
+     * The schema of the payload is not copied.
+     */
+    NodeInfo<snowcrash::Asset> renderPayloadSchema(const NodeInfo<snowcrash::Payload>& payload,
         const NodeInfo<snowcrash::Action>& action,
-        ConversionContext& context);
+        ConversionContext& context,
+        snowcrash::Asset& rendered);
 }
 
 #endif
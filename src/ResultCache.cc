@@ -0,0 +1,315 @@
+//
+//  ResultCache.cc
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include "ResultCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(_WIN32)
+#include <direct.h>
+#include <io.h>
+#include <process.h>
+#include <sys/utime.h>
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+namespace
+{
+    const std::string Magic = "drafter-cache 1";
+    const std::string Extension = ".entry";
+
+    /** 64-bit FNV-1a */
+    std::string Hash(const std::string& data)
+    {
+        unsigned long long hash = 14695981039346656037ULL;
+
+        for (std::string::const_iterator it = data.begin(); it != data.end(); ++it) {
+            hash ^= static_cast<unsigned char>(*it);
+            hash *= 1099511628211ULL;
+        }
+
+        std::stringstream hex;
+        hex.width(16);
+        hex.fill('0');
+        hex << std::hex << hash;
+
+        return hex.str();
+    }
+
+    bool ReadFile(const std::string& path, std::string& content)
+    {
+        std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+
+        if (!in) {
+            return false;
+        }
+
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        content = buffer.str();
+
+        return !in.bad();
+    }
+
+    /** Mark file as recently used */
+    void Touch(const std::string& path)
+    {
+#if defined(_WIN32)
+        _utime(path.c_str(), NULL);
+#else
+        utime(path.c_str(), NULL);
+#endif
+    }
+
+    void MakeDirectory(const std::string& path)
+    {
+#if defined(_WIN32)
+        _mkdir(path.c_str());
+#else
+        mkdir(path.c_str(), 0777);
+#endif
+    }
+
+    /** Number of entries stored by this process, distinguishes temporary files of its threads */
+    std::atomic<unsigned long> Stored(0);
+
+    /** Size of file, 0 if it does not exist */
+    size_t FileSize(const std::string& path)
+    {
+        struct stat info;
+
+        if (stat(path.c_str(), &info) != 0) {
+            return 0;
+        }
+
+        return info.st_size;
+    }
+
+    /** Rename `from` to `to` replacing it if it exists */
+    bool Replace(const std::string& from, const std::string& to)
+    {
+#if defined(_WIN32)
+        // rename() fails on Windows if the target exists
+        return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    }
+
+    int ProcessId()
+    {
+#if defined(_WIN32)
+        return _getpid();
+#else
+        return getpid();
+#endif
+    }
+
+    struct CachedFile {
+        std::string path;
+        size_t size;
+        time_t used;
+
+        bool operator<(const CachedFile& other) const
+        {
+            return used < other.used;
+        }
+    };
+
+    bool HasExtension(const std::string& name)
+    {
+        return name.size() > Extension.size()
+            && name.compare(name.size() - Extension.size(), Extension.size(), Extension) == 0;
+    }
+
+    void ListEntries(const std::string& directory, std::vector<CachedFile>& files)
+    {
+#if defined(_WIN32)
+        struct _finddata_t found;
+        intptr_t handle = _findfirst((directory + "/*" + Extension).c_str(), &found);
+
+        if (handle == -1) {
+            return;
+        }
+
+        do {
+            CachedFile file;
+            file.path = directory + "/" + found.name;
+            file.size = found.size;
+            file.used = found.time_write;
+            files.push_back(file);
+        } while (_findnext(handle, &found) == 0);
+
+        _findclose(handle);
+#else
+        DIR* dir = opendir(directory.c_str());
+
+        if (!dir) {
+            return;
+        }
+
+        while (struct dirent* entry = readdir(dir)) {
+            if (!HasExtension(entry->d_name)) {
+                continue;
+            }
+
+            CachedFile file;
+            file.path = directory + "/" + entry->d_name;
+
+            struct stat info;
+
+            if (stat(file.path.c_str(), &info) != 0) {
+                continue;
+            }
+
+            file.size = info.st_size;
+            file.used = info.st_mtime;
+            files.push_back(file);
+        }
+
+        closedir(dir);
+#endif
+    }
+}
+
+ResultCache::ResultCache(const std::string& directory, size_t maxSize)
+    : directory(directory), maxSize(maxSize), size(0), sized(false)
+{
+    MakeDirectory(directory);
+}
+
+std::string ResultCache::path(const std::string& key) const
+{
+    return directory + "/" + Hash(key) + Extension;
+}
+
+bool ResultCache::find(const std::string& key, ProcessResult& entry) const
+{
+    const std::string file = path(key);
+    std::string content;
+
+    if (!ReadFile(file, content)) {
+        return false;
+    }
+
+    std::stringstream header(content);
+    std::string magic;
+    size_t keySize = 0, outputSize = 0, reportSize = 0;
+
+    std::getline(header, magic);
+    header >> entry.status >> keySize >> outputSize >> reportSize;
+    header.ignore(1);
+
+    if (magic != Magic || !header) {
+        return false;
+    }
+
+    const size_t offset = static_cast<size_t>(header.tellg());
+
+    if (content.size() - offset != keySize + outputSize + reportSize
+        || content.compare(offset, keySize, key) != 0) {
+        return false;
+    }
+
+    entry.output = content.substr(offset + keySize, outputSize);
+    entry.report = content.substr(offset + keySize + outputSize, reportSize);
+
+    Touch(file);
+
+    return true;
+}
+
+void ResultCache::store(const std::string& key, const ProcessResult& entry) const
+{
+    const std::string file = path(key);
+    size_t stored = 0;
+
+    std::stringstream temporary;
+    temporary << file << "." << ProcessId() << "." << Stored++ << ".tmp";
+
+    {
+        std::ofstream out(temporary.str().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+        out << Magic << "\n";
+        out << entry.status << " " << key.size() << " " << entry.output.size() << " " << entry.report.size() << "\n";
+        out << key << entry.output << entry.report;
+
+        stored = static_cast<size_t>(out.tellp());
+        out.close();
+
+        if (!out) {
+            std::remove(temporary.str().c_str());
+            return;
+        }
+    }
+
+    const size_t replaced = FileSize(file);
+
+    // an entry stored by another process meanwhile has the same content
+    if (!Replace(temporary.str(), file)) {
+        std::remove(temporary.str().c_str());
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // the first entry stored is counted by listing the directory
+    if (sized) {
+        size += stored;
+        size -= std::min(size, replaced);
+    }
+
+    if (!sized || size > maxSize) {
+        evict(file);
+    }
+}
+
+void ResultCache::evict(const std::string& stored) const
+{
+    std::vector<CachedFile> files;
+    ListEntries(directory, files);
+
+    size = 0;
+    sized = true;
+
+    for (std::vector<CachedFile>::const_iterator it = files.begin(); it != files.end(); ++it) {
+        size += it->size;
+    }
+
+    if (size <= maxSize) {
+        return;
+    }
+
+    // evict below the limit, so the directory is not listed again by the next few entries stored
+    const size_t target = maxSize - maxSize / 10;
+
+    std::sort(files.begin(), files.end());
+
+    for (std::vector<CachedFile>::const_iterator it = files.begin(); it != files.end() && size > target; ++it) {
+        // modification times have a coarse resolution, the entry just stored may seem as old as any other
+        if (it->path == stored) {
+            continue;
+        }
+
+        if (std::remove(it->path.c_str()) == 0) {
+            size -= it->size;
+        }
+    }
+}
@@ -0,0 +1,74 @@
+//
+//  ResultCache.h
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#ifndef DRAFTER_RESULTCACHE_H
+#define DRAFTER_RESULTCACHE_H
+
+#include <mutex>
+#include <string>
+
+#include "Processor.h"
+
+/**
+ *  \brief On-disk cache of results of the command line tool
+ *
+ *  Every entry is a file named by hash of its key. The key itself is
+ *  stored in the entry too, so a hash collision is a miss rather than
+ *  a wrong result. Entries are written atomically, so concurrent
+ *  processes sharing the directory see either a whole entry or none.
+ *
+ *  Size of the cache is bounded, least recently used entries are
+ *  removed when a new entry exceeds it, down to 90 % of the size so that
+ *  eviction does not run on every entry stored. The directory is listed
+ *  by the first entry stored, the size is then tracked by entries stored
+ *  and the directory is listed again only to evict, so finding an entry
+ *  only reads its file. Entries stored by other processes are counted by
+ *  the listings.
+ */
+class ResultCache
+{
+public:
+    /**
+     *  \param directory Directory of the cache, created if it does not exist
+     *  \param maxSize Maximal size of the entries in bytes
+     */
+    ResultCache(const std::string& directory, size_t maxSize);
+
+    /**
+     *  \brief Find entry stored for `key`
+     *
+     *  \return True if found, the entry is marked as recently used then
+     */
+    bool find(const std::string& key, ProcessResult& entry) const;
+
+    /**
+     *  \brief Store entry for `key`
+     *
+     *  Failures are ignored, the cache only loses the entry then.
+     */
+    void store(const std::string& key, const ProcessResult& entry) const;
+
+private:
+    std::string path(const std::string& key) const;
+
+    /**
+     *  \brief Recount size from the directory and remove least recently used entries but `stored`
+     *
+     *  `mutex` must be locked.
+     */
+    void evict(const std::string& stored) const;
+
+    const std::string directory;
+    const size_t maxSize;
+
+    /** Size of entries as far as known to this instance, if `sized`, guarded by `mutex` */
+    mutable size_t size;
+    mutable bool sized;
+    mutable std::mutex mutex;
+};
+
+#endif // #ifndef DRAFTER_RESULTCACHE_H
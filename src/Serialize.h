@@ -44,17 +44,24 @@ namespace drafter
     struct WrapperOptions {
         const bool generateSourceMap;
         const bool expandMSON;
+        const bool parallelConversion; // convert API description elements concurrently
+
+        WrapperOptions(const bool generateSourceMap, const bool expandMSON, const bool parallelConversion)
+            : generateSourceMap(generateSourceMap), expandMSON(expandMSON), parallelConversion(parallelConversion)
+        {
+        }
 
         WrapperOptions(const bool generateSourceMap, const bool expandMSON)
-            : generateSourceMap(generateSourceMap), expandMSON(expandMSON)
+            : generateSourceMap(generateSourceMap), expandMSON(expandMSON), parallelConversion(false)
         {
         }
 
-        WrapperOptions(const bool generateSourceMap) : generateSourceMap(generateSourceMap), expandMSON(false)
+        WrapperOptions(const bool generateSourceMap)
+            : generateSourceMap(generateSourceMap), expandMSON(false), parallelConversion(false)
         {
         }
 
-        WrapperOptions() : generateSourceMap(false), expandMSON(false)
+        WrapperOptions() : generateSourceMap(false), expandMSON(false), parallelConversion(false)
         {
         }
     };
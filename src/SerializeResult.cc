@@ -14,54 +14,100 @@
 #include "SourceAnnotation.h"
 #include "SectionProcessor.h"
 
+#include "refract/Budget.h"
 #include "refract/Build.h"
-#include "refract/ElementInserter.h"
 
 #include "NamedTypesRegistry.h"
 #include "ConversionContext.h"
 
 using namespace drafter;
 
-namespace helper
+namespace
 {
 
-    struct AnnotationToRefract {
+    refract::IElement* ConvertBlueprint(
+        snowcrash::ParseResult<snowcrash::Blueprint>& blueprint, ConversionContext& context)
+    {
+        RegisterNamedTypes(
+            MakeNodeInfo(blueprint.node.content.elements(), blueprint.sourceMap.content.elements()), context);
+        // snowcrash AST is released while converting, only report survives
+        return BlueprintToRefract(blueprint.node, blueprint.sourceMap, context);
+    }
 
-        const std::string& key;
+    /**
+     * Locations of the annotations of a report, the error followed by each
+     * warning. Annotations reported by snowcrash are converted from bytes to
+     * characters by a single pass over the source. Annotations of the
+     * conversion keep byte ranges of the refract source maps.
+     */
+    std::vector<mdp::CharactersRangeSet> LocateAnnotations(
+        const snowcrash::Report& report, bool error, size_t warnings, const mdp::ByteBuffer& source)
+    {
+        std::vector<const mdp::BytesRangeSet*> parsed;
+        parsed.reserve(warnings + 1);
+
+        if (error) {
+            parsed.push_back(&report.error.location);
+        }
 
-        AnnotationToRefract(const std::string& key) : key(key)
-        {
+        for (size_t i = 0; i < warnings; ++i) {
+            parsed.push_back(&report.warnings[i].location);
         }
 
-        refract::IElement* operator()(snowcrash::SourceAnnotation& annotation)
-        {
-            return drafter::AnnotationToRefract(annotation, key);
+        std::vector<mdp::CharactersRangeSet> located = mdp::BytesRangeSetsToCharactersRangeSets(parsed, source);
+        std::vector<mdp::CharactersRangeSet>::const_iterator next = located.begin();
+
+        std::vector<mdp::CharactersRangeSet> locations;
+        locations.reserve(report.warnings.size() + 1);
+
+        locations.push_back(error ? *next++ : report.error.location);
+
+        for (size_t i = 0; i < report.warnings.size(); ++i) {
+            locations.push_back(i < warnings ? *next++ : report.warnings[i].location);
         }
-    };
+
+        return locations;
+    }
 }
 
 refract::IElement* drafter::WrapRefract(
-    snowcrash::ParseResult<snowcrash::Blueprint>& blueprint, ConversionContext& context)
+    snowcrash::ParseResult<snowcrash::Blueprint>& blueprint, const mdp::ByteBuffer& source, ConversionContext& context)
+{
+    refract::IElement* parseResult = WrapRefract(blueprint, source, context, ConvertBlueprint);
+
+    context.GetNamedTypesRegistry().clearAll(true);
+
+    return parseResult;
+}
+
+refract::IElement* drafter::WrapRefract(snowcrash::ParseResult<snowcrash::Blueprint>& blueprint,
+    const mdp::ByteBuffer& source,
+    ConversionContext& context,
+    const BlueprintConverter& converter)
 {
     snowcrash::Error error;
     refract::IElement* blueprintRefract = NULL;
 
+    // annotations reported by snowcrash, the conversion appends its own
+    const bool parseError = blueprint.report.error.code != snowcrash::Error::OK;
+    const size_t parseWarnings = blueprint.report.warnings.size();
+
     refract::ArrayElement* parseResult = new refract::ArrayElement;
     parseResult->element(SerializeKey::ParseResult);
 
     if (blueprint.report.error.code == snowcrash::Error::OK) {
         try {
-            RegisterNamedTypes(
-                MakeNodeInfo(blueprint.node.content.elements(), blueprint.sourceMap.content.elements()), context);
-            blueprintRefract = BlueprintToRefract(MakeNodeInfo(blueprint.node, blueprint.sourceMap), context);
+            blueprintRefract = converter(blueprint, context);
+        } catch (refract::LimitExceeded& e) {
+            error = snowcrash::Error(e.what(), snowcrash::LimitError);
+        } catch (refract::ParseCancelled& e) {
+            error = snowcrash::Error(e.what(), snowcrash::CancelledError);
         } catch (std::exception& e) {
             error = snowcrash::Error(e.what(), snowcrash::MSONError);
         } catch (snowcrash::Error& e) {
             error = e;
         }
 
-        context.GetNamedTypesRegistry().clearAll(true);
-
         if (error.code != snowcrash::Error::OK) {
             blueprint.report.error = error;
         }
@@ -71,9 +117,8 @@ refract::IElement* drafter::WrapRefract(
         }
     }
 
-    if (blueprint.report.error.code != snowcrash::Error::OK) {
-        parseResult->push_back(helper::AnnotationToRefract(SerializeKey::Error)(blueprint.report.error));
-    }
+    // annotations are reported whatever resources the conversion has used
+    refract::ScopedBudget unlimited(NULL);
 
     snowcrash::Warnings& warnings = blueprint.report.warnings;
 
@@ -81,11 +126,15 @@ refract::IElement* drafter::WrapRefract(
         warnings.insert(warnings.end(), context.warnings.begin(), context.warnings.end());
     }
 
-    if (!warnings.empty()) {
-        std::transform(warnings.begin(),
-            warnings.end(),
-            refract::ElementInserter(*parseResult),
-            helper::AnnotationToRefract(SerializeKey::Warning));
+    const std::vector<mdp::CharactersRangeSet> locations
+        = LocateAnnotations(blueprint.report, parseError, parseWarnings, source);
+
+    if (blueprint.report.error.code != snowcrash::Error::OK) {
+        parseResult->push_back(AnnotationToRefract(blueprint.report.error, locations[0], SerializeKey::Error));
+    }
+
+    for (size_t i = 0; i < warnings.size(); ++i) {
+        parseResult->push_back(AnnotationToRefract(warnings[i], locations[i + 1], SerializeKey::Warning));
     }
 
     return parseResult;
@@ -12,6 +12,8 @@
 #include "Serialize.h"
 #include "SectionParserData.h"
 
+#include <functional>
+
 namespace snowcrash
 {
     struct SourceAnnotation;
@@ -27,7 +29,37 @@ namespace drafter
 
     class ConversionContext;
 
-    refract::IElement* WrapRefract(snowcrash::ParseResult<snowcrash::Blueprint>& blueprint, ConversionContext& context);
+    /**
+     * Convert snowcrash parse result into refract parse result.
+     *
+     * Snowcrash AST and its source maps are released while converting,
+     * so only `blueprint.report` is meaningful after the call.
+     *
+     * Annotations reported by snowcrash are located by bytes of `source`,
+     * they are converted to characters in the parse result.
+     *
+     * The conversion runs within the budget current in the calling thread,
+     * exceeding it is reported as an error of code snowcrash::LimitError.
+     */
+    refract::IElement* WrapRefract(snowcrash::ParseResult<snowcrash::Blueprint>& blueprint,
+        const mdp::ByteBuffer& source,
+        ConversionContext& context);
+
+    /**
+     * Converts snowcrash blueprint into refract, named types included
+     */
+    typedef std::function<refract::IElement*(snowcrash::ParseResult<snowcrash::Blueprint>&, ConversionContext&)>
+        BlueprintConverter;
+
+    /**
+     * Convert snowcrash parse result into refract parse result, blueprint
+     * is converted by `converter`. Errors thrown by the converter are
+     * reported in the parse result.
+     */
+    refract::IElement* WrapRefract(snowcrash::ParseResult<snowcrash::Blueprint>& blueprint,
+        const mdp::ByteBuffer& source,
+        ConversionContext& context,
+        const BlueprintConverter& converter);
 }
 
 #endif // #ifndef DRAFTER_SERIALIZERESULT_H
@@ -0,0 +1,524 @@
+//
+//  Server.cc
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include "Server.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Processor.h"
+#include "ResultCache.h"
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const int MalformedRequest = -2;
+
+    /** Requests of a connection read ahead of the responses written */
+    const size_t PendingResponses = 64;
+
+    /** Tasks queued per worker */
+    const size_t PendingTasks = 4;
+
+    /**
+     *  \brief Bounded queue of tasks shared by all connections, run by fixed set of threads
+     */
+    class TaskQueue
+    {
+    public:
+        typedef std::function<void()> Task;
+
+        explicit TaskQueue(size_t workers) : capacity(workers * PendingTasks), stopping(false)
+        {
+            for (size_t i = 0; i < workers; ++i) {
+                threads.push_back(std::thread(&TaskQueue::work, this));
+            }
+        }
+
+        ~TaskQueue()
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                stopping = true;
+            }
+
+            available.notify_all();
+
+            for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it) {
+                it->join();
+            }
+        }
+
+        /** Queue task, waiting while the queue is full */
+        void push(const Task& task)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+
+                while (tasks.size() >= capacity) {
+                    taken.wait(lock);
+                }
+
+                tasks.push_back(task);
+            }
+
+            available.notify_one();
+        }
+
+    private:
+        TaskQueue(const TaskQueue&);
+        TaskQueue& operator=(const TaskQueue&);
+
+        void work()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            while (true) {
+                while (tasks.empty() && !stopping) {
+                    available.wait(lock);
+                }
+
+                if (tasks.empty()) {
+                    return;
+                }
+
+                Task task = tasks.front();
+                tasks.pop_front();
+                taken.notify_one();
+
+                lock.unlock();
+                task();
+                lock.lock();
+            }
+        }
+
+        std::vector<std::thread> threads;
+        std::deque<Task> tasks;
+        const size_t capacity;
+
+        std::mutex mutex;
+        std::condition_variable available;
+        std::condition_variable taken;
+        bool stopping;
+    };
+
+    /**
+     *  \brief Bounded queue of results of a connection in order of its requests
+     */
+    class Responses
+    {
+    public:
+        Responses() : closed(false)
+        {
+        }
+
+        /** Queue result, waiting while `PendingResponses` results are not written yet */
+        void push(const std::shared_future<ProcessResult>& result)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            while (results.size() >= PendingResponses) {
+                changed.wait(lock);
+            }
+
+            results.push_back(result);
+            changed.notify_all();
+        }
+
+        void close()
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                closed = true;
+            }
+
+            changed.notify_one();
+        }
+
+        /** \return False if closed and all results popped */
+        bool pop(std::shared_future<ProcessResult>& result)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            while (results.empty() && !closed) {
+                changed.wait(lock);
+            }
+
+            if (results.empty()) {
+                return false;
+            }
+
+            result = results.front();
+            results.pop_front();
+            changed.notify_all();
+
+            return true;
+        }
+
+    private:
+        std::deque<std::shared_future<ProcessResult> > results;
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool closed;
+    };
+
+    /**
+     *  \brief Read request header, applying its options to `config`
+     *
+     *  \return False on end of input or malformed header
+     */
+    bool ReadHeader(FILE* in, Config& config, size_t& length, bool& malformed)
+    {
+        std::string line;
+        int c;
+
+        while ((c = fgetc(in)) != EOF && c != '\n') {
+            line += static_cast<char>(c);
+        }
+
+        malformed = false;
+
+        if (c == EOF && line.empty()) {
+            return false;
+        }
+
+        std::stringstream header(line);
+        std::string option;
+
+        if (!(header >> length)) {
+            malformed = true;
+            return false;
+        }
+
+        while (header >> option) {
+            if (option == "json") {
+                config.format = drafter::JSONFormat;
+            } else if (option == "yaml") {
+                config.format = drafter::YAMLFormat;
+            } else if (option == "sourcemap") {
+                config.sourceMap = true;
+            } else if (option == "validate") {
+                config.validate = true;
+            } else if (option == "use-line-num") {
+                config.lineNumbers = true;
+            } else {
+                malformed = true;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /** \return False if the response could not be written, e.g. the client has disconnected */
+    bool WriteResponse(FILE* out, const ProcessResult& result)
+    {
+        fprintf(out,
+            "%d %lu %lu\n",
+            result.status,
+            static_cast<unsigned long>(result.output.size()),
+            static_cast<unsigned long>(result.report.size()));
+        fwrite(result.output.data(), 1, result.output.size(), out);
+        fwrite(result.report.data(), 1, result.report.size(), out);
+
+        return fflush(out) == 0 && !ferror(out);
+    }
+
+    void PushError(Responses& responses, const std::string& report)
+    {
+        std::promise<ProcessResult> error;
+        ProcessResult result;
+        result.status = MalformedRequest;
+        result.report = report;
+        error.set_value(result);
+        responses.push(error.get_future().share());
+    }
+
+    /**
+     *  \brief Answer requests read from `in` until it is closed
+     */
+    void ServeConnection(const Config& config, ResultCache* cache, TaskQueue& queue, FILE* in, FILE* out)
+    {
+        Responses responses;
+
+        // results are popped even if the client has disconnected, so the reader is not blocked
+        std::thread writer([&responses, out]() {
+            std::shared_future<ProcessResult> result;
+            bool connected = true;
+
+            while (responses.pop(result)) {
+                if (connected) {
+                    connected = WriteResponse(out, result.get());
+                }
+            }
+        });
+
+        while (true) {
+            Config requestConfig = config;
+            size_t length = 0;
+            bool malformed = false;
+
+            if (!ReadHeader(in, requestConfig, length, malformed)) {
+                if (malformed) {
+                    PushError(responses, "malformed request header\n");
+                }
+
+                break;
+            }
+
+            std::shared_ptr<std::string> source = std::make_shared<std::string>(length, '\0');
+
+            if (length > 0 && fread(&(*source)[0], 1, length, in) != length) {
+                PushError(responses, "truncated request body\n");
+                break;
+            }
+
+            std::shared_ptr<std::promise<ProcessResult> > promise = std::make_shared<std::promise<ProcessResult> >();
+            responses.push(promise->get_future().share());
+
+            queue.push([requestConfig, source, cache, promise]() {
+                ProcessResult result;
+                ProcessBlueprint(requestConfig, *source, cache, result);
+                promise->set_value(result);
+            });
+        }
+
+        responses.close();
+        writer.join();
+    }
+
+#if !defined(_WIN32)
+    volatile sig_atomic_t Stopping = 0;
+    volatile sig_atomic_t Listening = -1;
+
+    /** Signal handler, wakes accept() even if the signal is delivered to another thread */
+    void Stop(int)
+    {
+        Stopping = 1;
+
+        if (Listening >= 0) {
+            shutdown(Listening, SHUT_RDWR);
+        }
+    }
+
+    /**
+     *  \brief Connections being served, each by its own thread
+     *
+     *  Threads of closed connections are joined by the next connection
+     *  accepted, the rest by finish().
+     */
+    class Connections
+    {
+    public:
+        /** Serve `socket` on a thread of its own */
+        void serve(int socket, const Config& config, ResultCache* cache, TaskQueue& queue)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            for (std::list<Connection>::iterator it = connections.begin(); it != connections.end();) {
+                if (it->closed) {
+                    it->thread.join();
+                    it = connections.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+
+            connections.push_back(Connection(socket));
+            std::list<Connection>::iterator connection = --connections.end();
+
+            connection->thread = std::thread([this, connection, &config, cache, &queue]() {
+                FILE* in = fdopen(connection->socket, "rb");
+                FILE* out = fdopen(dup(connection->socket), "wb");
+
+                if (in && out) {
+                    ServeConnection(config, cache, queue, in, out);
+                }
+
+                close(connection);
+
+                if (out) {
+                    fclose(out);
+                }
+
+                if (in) {
+                    fclose(in);
+                } else {
+                    ::close(connection->socket);
+                }
+            });
+        }
+
+        /** Stop reading requests of all connections and wait until their responses are written */
+        void finish()
+        {
+            std::list<Connection> finishing;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+
+                for (std::list<Connection>::const_iterator it = connections.begin(); it != connections.end(); ++it) {
+                    if (!it->closed) {
+                        shutdown(it->socket, SHUT_RD);
+                    }
+                }
+
+                finishing.swap(connections);
+            }
+
+            for (std::list<Connection>::iterator it = finishing.begin(); it != finishing.end(); ++it) {
+                it->thread.join();
+            }
+        }
+
+    private:
+        struct Connection {
+            int socket;
+            std::thread thread;
+            bool closed; // socket is being closed, it must not be shut down anymore
+
+            explicit Connection(int socket) : socket(socket), closed(false)
+            {
+            }
+        };
+
+        void close(std::list<Connection>::iterator connection)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            connection->closed = true;
+        }
+
+        std::list<Connection> connections;
+        std::mutex mutex;
+    };
+
+    int ServeSocket(const Config& config, ResultCache* cache, TaskQueue& queue)
+    {
+        struct sockaddr_un address;
+
+        if (config.socket.size() >= sizeof(address.sun_path)) {
+            std::cerr << "socket path too long: " << config.socket << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        int listening = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (listening < 0) {
+            perror("socket");
+            return EXIT_FAILURE;
+        }
+
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strcpy(address.sun_path, config.socket.c_str());
+
+        unlink(config.socket.c_str());
+
+        if (bind(listening, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0
+            || listen(listening, SOMAXCONN) != 0) {
+            perror(config.socket.c_str());
+            close(listening);
+            return EXIT_FAILURE;
+        }
+
+        // SIGINT and SIGTERM stop accepting connections, to shut down in order
+        Listening = listening;
+
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = Stop;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGINT, &action, NULL);
+        sigaction(SIGTERM, &action, NULL);
+
+        Connections connections;
+        int status = EXIT_SUCCESS;
+
+        while (!Stopping) {
+            int connection = accept(listening, NULL, NULL);
+
+            if (connection < 0) {
+                if (Stopping) {
+                    break;
+                }
+
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                perror("accept");
+                status = EXIT_FAILURE;
+                break;
+            }
+
+            connections.serve(connection, config, cache, queue);
+        }
+
+        Listening = -1;
+        close(listening);
+        connections.finish();
+        unlink(config.socket.c_str());
+
+        return status;
+    }
+#endif
+}
+
+int Serve(const Config& config)
+{
+    size_t workers = config.jobs;
+
+    if (workers == 0) {
+        workers = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    std::unique_ptr<ResultCache> cache;
+
+    if (!config.cacheDir.empty()) {
+        cache.reset(new ResultCache(config.cacheDir, config.cacheSize));
+    }
+
+#if !defined(_WIN32)
+    // a client disconnecting before its responses are written must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    TaskQueue queue(workers);
+
+    if (!config.socket.empty()) {
+#if defined(_WIN32)
+        std::cerr << "serving on a socket is not supported on this platform" << std::endl;
+        return EXIT_FAILURE;
+#else
+        return ServeSocket(config, cache.get(), queue);
+#endif
+    }
+
+    ServeConnection(config, cache.get(), queue, stdin, stdout);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,39 @@
+//
+//  Server.h
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#ifndef DRAFTER_SERVER_H
+#define DRAFTER_SERVER_H
+
+#include "config.h"
+
+/**
+ *  \brief Serve parse requests until the input is closed
+ *
+ *  Requests are read from stdin, or from every connection to the Unix
+ *  domain socket `config.socket` if set. A request is a header line
+ *  followed by the blueprint:
+ *
+ *      <length>[ <option>...]\n<length bytes of blueprint>
+ *
+ *  where options are `json`, `yaml`, `sourcemap`, `validate` and
+ *  `use-line-num`, overriding those given on the command line. Every
+ *  request is answered, in order of the requests, by
+ *
+ *      <status> <output length> <report length>\n<output><report>
+ *
+ *  Requests are processed concurrently by `config.jobs` workers. Queues
+ *  of requests and responses are bounded, a connection is not read while
+ *  its client is slow to read the responses or all workers are busy.
+ *  A malformed header or a body shorter than its length is answered by
+ *  status -2 and the connection is closed. Serving on a socket ends by
+ *  SIGINT or SIGTERM, after the requests read are answered.
+ *
+ *  \return Exit code of the program
+ */
+int Serve(const Config& config);
+
+#endif // #ifndef DRAFTER_SERVER_H
@@ -0,0 +1,148 @@
+//
+//  WorkerPool.cc
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace drafter
+{
+
+    namespace
+    {
+        /// workers of all the pools alive
+        std::atomic<size_t> Running(0);
+    }
+
+    WorkerPool::WorkerPool(size_t workers)
+        : task(NULL), allocator(NULL), budget(NULL), count(0), next(0), pending(0), batch(0), stopping(false)
+    {
+        threads.reserve(workers);
+
+        try {
+            for (size_t i = 0; i < workers; ++i) {
+                threads.push_back(std::thread(&WorkerPool::work, this));
+                ++Running;
+            }
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        stop();
+    }
+
+    void WorkerPool::stop()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            stopping = true;
+        }
+
+        started.notify_all();
+
+        for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it) {
+            it->join();
+        }
+
+        Running -= threads.size();
+        threads.clear();
+    }
+
+    void WorkerPool::run(size_t count, const Task& task)
+    {
+        if (count == 0) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        this->task = &task;
+        this->allocator = &refract::CurrentAllocator();
+        this->budget = refract::CurrentBudget();
+        this->count = count;
+        next = 0;
+        pending = count;
+        ++batch;
+
+        started.notify_all();
+
+        drain(lock);
+
+        while (pending > 0) {
+            finished.wait(lock);
+        }
+
+        this->task = NULL;
+        this->allocator = NULL;
+        this->budget = NULL;
+        this->count = 0;
+    }
+
+    void WorkerPool::drain(std::unique_lock<std::mutex>& lock)
+    {
+        while (next < count) {
+            const Task& current = *task;
+            const refract::Allocator* currentAllocator = allocator;
+            refract::Budget* currentBudget = budget;
+            size_t index = next++;
+
+            lock.unlock();
+            {
+                refract::ScopedAllocator scopedAllocator(currentAllocator);
+                refract::ScopedBudget scopedBudget(currentBudget);
+                current(index);
+            }
+            lock.lock();
+
+            if (--pending == 0) {
+                finished.notify_all();
+            }
+        }
+    }
+
+    void WorkerPool::work()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        size_t seen = 0;
+
+        while (true) {
+            while (!stopping && batch == seen) {
+                started.wait(lock);
+            }
+
+            if (stopping) {
+                return;
+            }
+
+            seen = batch;
+            drain(lock);
+        }
+    }
+
+    size_t WorkerPool::WorkersFor(size_t tasks)
+    {
+        size_t hardware = std::thread::hardware_concurrency();
+        size_t running = Running;
+
+        if (tasks < 2 || hardware < running + 2) {
+            return 0;
+        }
+
+        return std::min(hardware - running, tasks) - 1;
+    }
+
+    void WorkerPoolRunner::run(size_t count, const Task& task) const
+    {
+        WorkerPool pool(WorkerPool::WorkersFor(count));
+        pool.run(count, task);
+    }
+}
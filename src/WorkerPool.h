@@ -0,0 +1,103 @@
+//
+//  WorkerPool.h
+//  drafter
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#ifndef DRAFTER_WORKERPOOL_H
+#define DRAFTER_WORKERPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "refract/Allocator.h"
+#include "refract/Budget.h"
+
+#include "SectionParserData.h"
+
+namespace drafter
+{
+
+    /**
+     *  \brief Fixed set of worker threads running batches of indexed tasks
+     *
+     *  The calling thread takes part in every batch, so a pool without
+     *  workers runs the tasks serially, in order of their indexes.
+     *
+     *  Workers of all the pools alive in the process are counted, so that
+     *  pools of concurrent parses together do not start more workers than
+     *  there are hardware threads, \see WorkersFor().
+     */
+    class WorkerPool
+    {
+    public:
+        typedef std::function<void(size_t)> Task;
+
+        /**
+         *  \brief Start the worker threads
+         *
+         *  \param workers Number of threads besides the calling one
+         */
+        explicit WorkerPool(size_t workers);
+
+        ~WorkerPool();
+
+        /**
+         *  \brief Run `task(i)` for every `i` in `[0, count)` and wait for all of them
+         *
+         *  Tasks must not throw. They allocate elements by the allocator
+         *  and within the budget current in the calling thread.
+         */
+        void run(size_t count, const Task& task);
+
+        /** \return Number of worker threads */
+        size_t size() const
+        {
+            return threads.size();
+        }
+
+        /**
+         *  \return Number of workers worth starting for `tasks` independent tasks,
+         *  besides the workers of the pools already alive
+         */
+        static size_t WorkersFor(size_t tasks);
+
+    private:
+        WorkerPool(const WorkerPool&);
+        WorkerPool& operator=(const WorkerPool&);
+
+        void work();
+        void drain(std::unique_lock<std::mutex>& lock);
+        void stop();
+
+        std::vector<std::thread> threads;
+
+        std::mutex mutex;
+        std::condition_variable started;
+        std::condition_variable finished;
+
+        const Task* task;
+        const refract::Allocator* allocator;
+        refract::Budget* budget;
+        size_t count;
+        size_t next;
+        size_t pending;
+        size_t batch;
+        bool stopping;
+    };
+
+    /**
+     *  \brief Runner of concurrent tasks of snowcrash on a worker pool started for every batch
+     */
+    class WorkerPoolRunner : public snowcrash::TaskRunner
+    {
+    public:
+        virtual void run(size_t count, const Task& task) const;
+    };
+}
+
+#endif // #ifndef DRAFTER_WORKERPOOL_H
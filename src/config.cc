@@ -24,13 +24,22 @@ namespace config
     static const std::string Validate = "validate";
     static const std::string Version = "version";
     static const std::string UseLineNumbers = "use-line-num";
+    static const std::string Parallel = "parallel";
+    static const std::string CacheDir = "cache-dir";
+    static const std::string CacheSize = "cache-size";
+    static const std::string Serve = "serve";
+    static const std::string Socket = "socket";
+    static const std::string Jobs = "jobs";
 };
 
 void PrepareCommanLineParser(cmdline::parser& parser)
 {
     parser.set_program_name(config::Program);
 
-    parser.add<std::string>(config::Output, 'o', "save output Parse Result into file", false);
+    parser.add<std::string>(config::Output,
+        'o',
+        "save output Parse Result into file, or into directory if more input files are given",
+        false);
     parser.add<std::string>(config::Format,
         'f',
         "output format of the Parse Result (yaml|json)",
@@ -43,28 +52,50 @@ void PrepareCommanLineParser(cmdline::parser& parser)
     parser.add(config::Validate, 'l', "validate input only, do not output Parse Result");
     parser.add(
         config::UseLineNumbers, 'u', "use line and row number instead of character index when printing annotation");
+    parser.add(config::Parallel, 'p', "parse and convert resource groups of the API description concurrently");
+    parser.add<std::string>(config::CacheDir, 'c', "reuse results cached in directory for unchanged input", false);
+    parser.add<int>(config::CacheSize,
+        '\0',
+        "maximal size of the cache in megabytes",
+        false,
+        100,
+        cmdline::range(1, 1024 * 1024));
+    parser.add(config::Serve, '\0', "serve length-prefixed parse requests read from stdin or socket");
+    parser.add<std::string>(config::Socket, '\0', "serve requests on Unix domain socket of given path", false);
+    parser.add<int>(config::Jobs,
+        'j',
+        "number of blueprints processed concurrently, number of cores by default",
+        false,
+        0,
+        cmdline::range(0, 1024));
 
     std::stringstream ss;
 
-    ss << "<input file>\n\n";
+    ss << "<input file>...\n\n";
     ss << "API Blueprint Parser\n";
     ss << "If called without <input file>, 'drafter' will listen on stdin.\n";
+    ss << "Given more input files or a directory of .apib files, 'drafter' saves Parse Result of each\n";
+    ss << "next to it, or into the output directory.\n";
 
     parser.footer(ss.str());
 }
 
 void ValidateParsedCommandLine(const cmdline::parser& parser, const Config& config)
 {
-    if (parser.rest().size() > 1) {
-        std::cerr << "one input file expected, got " << parser.rest().size() << std::endl;
-        exit(EXIT_FAILURE);
-    }
-
     if (parser.exist(config::Version)) {
         std::cout << DRAFTER_VERSION_STRING << std::endl;
         exit(EXIT_SUCCESS);
     }
 
+    if (config.serve && !parser.rest().empty()) {
+        std::cerr << "no input file expected while serving requests" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (!config.serve && parser.exist(config::Socket)) {
+        std::cerr << "WARN: Socket is used only while serving requests" << std::endl;
+    }
+
     if (config.validate) {
         if (parser.exist(config::Output)) {
             std::cerr << "WARN: While validation is enabled, output file will not be created" << std::endl;
@@ -79,15 +110,19 @@ void ParseCommadLineOptions(int argc, const char* argv[], /* out */ Config& conf
 
     parser.parse_check(argc, argv);
 
-    if (!parser.rest().empty()) {
-        conf.input = parser.rest().front();
-    }
+    conf.inputs = parser.rest();
 
     conf.lineNumbers = parser.exist(config::UseLineNumbers);
     conf.validate = parser.exist(config::Validate);
     conf.format = parser.get<std::string>(config::Format) == "json" ? drafter::JSONFormat : drafter::YAMLFormat;
     conf.output = parser.get<std::string>(config::Output);
     conf.sourceMap = parser.exist(config::Sourcemap);
+    conf.parallel = parser.exist(config::Parallel);
+    conf.cacheDir = parser.get<std::string>(config::CacheDir);
+    conf.cacheSize = static_cast<size_t>(parser.get<int>(config::CacheSize)) * 1024 * 1024;
+    conf.serve = parser.exist(config::Serve);
+    conf.socket = parser.get<std::string>(config::Socket);
+    conf.jobs = static_cast<size_t>(parser.get<int>(config::Jobs));
 
     ValidateParsedCommandLine(parser, conf);
 }
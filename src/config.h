@@ -10,16 +10,23 @@
 #define DRAFTER_CONFIG_H
 
 #include <string>
+#include <vector>
 
 #include "Serialize.h"
 
 struct Config {
-    std::string input;
+    std::vector<std::string> inputs;
     bool lineNumbers;
     bool validate;
     drafter::SerializeFormat format;
     bool sourceMap;
+    bool parallel;
     std::string output;
+    std::string cacheDir;
+    size_t cacheSize; // in bytes
+    bool serve;
+    std::string socket;
+    size_t jobs; // 0 for number of cores
 };
 
 /**
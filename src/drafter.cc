@@ -9,15 +9,18 @@
 
 #include "snowcrash.h"
 
+#include "refract/Allocator.h"
+#include "refract/Budget.h"
 #include "refract/Element.h"
-#include "refract/FilterVisitor.h"
-#include "refract/Query.h"
-#include "refract/Iterate.h"
+#include "refract/TypeQueryVisitor.h"
 
 #include "SerializeResult.h"      // FIXME: remove - actualy required by WrapParseResultRefract()
 #include "Serialize.h"            // FIXME: remove - actualy required by WrapperOptions
 #include "ConversionContext.h"    // FIXME: remove - required by ConversionContext
 #include "RefractDataStructure.h" // FIXME: remove - required by SerializeRefract()
+#include "IncrementalParser.h"
+#include "RefractDiff.h"
+#include "WorkerPool.h"
 
 #include "sos.h" // FIXME: remove sos dependency
 #include "sosJSON.h"
@@ -26,6 +29,12 @@
 #include "Version.h"
 
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+
+struct drafter_cancel_token {
+    std::atomic<bool> cancelled;
+};
 
 DRAFTER_API drafter_error drafter_parse_blueprint_to(const char* source,
     char** out,
@@ -59,6 +68,109 @@ DRAFTER_API drafter_error drafter_parse_blueprint_to(const char* source,
 
 namespace sc = snowcrash;
 
+namespace
+{
+
+    refract::Allocator ToAllocator(const drafter_allocator& allocator)
+    {
+        refract::Allocator converted
+            = { allocator.allocate, allocator.reallocate, allocator.deallocate, allocator.ctx };
+        return converted;
+    }
+
+    /**
+     * \brief Allocator of parsing options current in the calling thread for the lifetime of the object
+     */
+    class ParseAllocator
+    {
+        refract::Allocator allocator;
+        refract::ScopedAllocator scoped;
+
+    public:
+        explicit ParseAllocator(const drafter_parse_options& parse_opts)
+            : allocator(parse_opts.allocator ? ToAllocator(*parse_opts.allocator) : refract::CurrentAllocator()),
+              scoped(&allocator)
+        {
+        }
+    };
+
+    bool HasLimits(const drafter_parse_limits& limits)
+    {
+        return limits.elements || limits.expansionDepth || limits.outputSize || limits.time;
+    }
+
+    refract::Limits ToLimits(const drafter_parse_limits& limits)
+    {
+        refract::Limits converted = { limits.elements, limits.expansionDepth, limits.outputSize, limits.time };
+        return converted;
+    }
+
+    const std::atomic<bool>* ToCancelled(const drafter_parse_options& parse_opts)
+    {
+        return parse_opts.cancel ? &parse_opts.cancel->cancelled : NULL;
+    }
+
+    refract::ProgressCallback ToProgress(const drafter_parse_options& parse_opts)
+    {
+        if (!parse_opts.progress) {
+            return refract::ProgressCallback();
+        }
+
+        const drafter_progress_cb progress = parse_opts.progress;
+        void* const ctx = parse_opts.progress_ctx;
+
+        return [progress, ctx](refract::ParseStage stage, unsigned percent) {
+            progress(static_cast<drafter_parse_stage>(stage), percent, ctx);
+        };
+    }
+
+    /** \return Budget of parsing options, NULL if they neither limit, cancel nor report the parse */
+    refract::Budget* ToBudget(const drafter_parse_options& parse_opts)
+    {
+        if (!HasLimits(parse_opts.limits) && !parse_opts.cancel && !parse_opts.progress) {
+            return NULL;
+        }
+
+        return new refract::Budget(ToLimits(parse_opts.limits), ToCancelled(parse_opts), ToProgress(parse_opts));
+    }
+
+    /**
+     * \brief Budget of parsing options current in the calling thread for the lifetime of the object
+     */
+    class ParseBudget
+    {
+        std::unique_ptr<refract::Budget> budget;
+        refract::ScopedBudget scoped;
+
+    public:
+        explicit ParseBudget(const drafter_parse_options& parse_opts)
+            : budget(ToBudget(parse_opts)), scoped(budget.get())
+        {
+        }
+
+        /** \return Monitor polled while parsing, NULL if there is none */
+        const snowcrash::ParseMonitor* monitor() const
+        {
+            return budget.get();
+        }
+    };
+
+    sc::BlueprintParserOptions ParserOptions(const drafter_parse_options& parse_opts)
+    {
+        sc::BlueprintParserOptions scOptions = sc::ExportSourcemapOption;
+
+        if (parse_opts.requireBlueprintName) {
+            scOptions |= sc::RequireBlueprintNameOption;
+        }
+
+        if (parse_opts.parallel) {
+            scOptions |= sc::ParallelParseOption;
+        }
+
+        return scOptions;
+    }
+}
+
 /* Parse API Bleuprint and return result, which is a opaque handle for
  * later use*/
 DRAFTER_API drafter_error drafter_parse_blueprint(
@@ -73,18 +185,18 @@ DRAFTER_API drafter_error drafter_parse_blueprint(
         return DRAFTER_EINVALID_OUTPUT;
     }
 
-    sc::BlueprintParserOptions scOptions = sc::ExportSourcemapOption;
+    ParseAllocator allocator(parse_opts);
+    ParseBudget budget(parse_opts);
 
-    if (parse_opts.requireBlueprintName) {
-        scOptions |= sc::RequireBlueprintNameOption;
-    }
+    const mdp::ByteBuffer blueprintSource(source);
 
     sc::ParseResult<sc::Blueprint> blueprint;
-    sc::parse(source, scOptions, blueprint);
+    drafter::WorkerPoolRunner runner;
+    sc::parse(blueprintSource, ParserOptions(parse_opts), blueprint, NULL, budget.monitor(), &runner);
 
-    drafter::WrapperOptions wrapperOptions;
+    drafter::WrapperOptions wrapperOptions(false, false, parse_opts.parallel);
     drafter::ConversionContext context(wrapperOptions);
-    refract::IElement* result = WrapRefract(blueprint, context);
+    refract::IElement* result = WrapRefract(blueprint, blueprintSource, context);
 
     *out = result;
 
@@ -112,43 +224,143 @@ namespace
         *stream << "\n";
         *stream << std::flush;
     }
+
+    /**
+     * \brief Serialize result into stream
+     * \return false if the format is unknown
+     */
+    bool SerializeResult(drafter_result* res, const drafter_serialize_options& serialize_opts, std::ostream& out)
+    {
+        drafter::SerializeFormat format = drafter::UnknownFormat;
+
+        switch (serialize_opts.format) {
+            case DRAFTER_SERIALIZE_JSON:
+                format = drafter::JSONFormat;
+                break;
+
+            case DRAFTER_SERIALIZE_YAML:
+                format = drafter::YAMLFormat;
+                break;
+
+            default:
+                return false;
+        }
+
+        drafter::WrapperOptions wrapperOptions(serialize_opts.sourcemap);
+        drafter::ConversionContext context(wrapperOptions);
+
+        sos::Object result = drafter::SerializeRefract(res, context);
+
+        std::unique_ptr<sos::Serialize> serializer(CreateSerializer(format));
+
+        Serialization(&out, result, serializer.get());
+
+        return true;
+    }
+
+    /**
+     * \brief Stream buffer passing its content to drafter_write_cb in chunks of fixed size
+     */
+    class WriteCallbackBuffer : public std::streambuf
+    {
+        static const size_t ChunkSize = 4096;
+
+        char chunk[ChunkSize];
+        drafter_write_cb write;
+        void* ctx;
+
+        bool flush()
+        {
+            const size_t size = pptr() - pbase();
+
+            if (size && write(pbase(), size, ctx) != 0) {
+                return false;
+            }
+
+            setp(chunk, chunk + ChunkSize);
+            return true;
+        }
+
+    protected:
+        virtual int_type overflow(int_type c)
+        {
+            if (!flush()) {
+                return traits_type::eof();
+            }
+
+            if (!traits_type::eq_int_type(c, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(c);
+                pbump(1);
+            }
+
+            return traits_type::not_eof(c);
+        }
+
+        virtual int sync()
+        {
+            return flush() ? 0 : -1;
+        }
+
+    public:
+        WriteCallbackBuffer(drafter_write_cb write, void* ctx) : write(write), ctx(ctx)
+        {
+            setp(chunk, chunk + ChunkSize);
+        }
+    };
 }
 
 /* Serialize result to given format*/
 DRAFTER_API char* drafter_serialize(drafter_result* res, const drafter_serialize_options serialize_opts)
 {
 
-    drafter::SerializeFormat format = drafter::UnknownFormat;
-
     if (!res) {
         return nullptr;
     }
 
-    switch (serialize_opts.format) {
-        case DRAFTER_SERIALIZE_JSON:
-            format = drafter::JSONFormat;
-            break;
+    std::ostringstream out;
 
-        case DRAFTER_SERIALIZE_YAML:
-            format = drafter::YAMLFormat;
-            break;
+    if (!SerializeResult(res, serialize_opts, out)) {
+        return nullptr;
+    }
 
-        default:
-            return nullptr;
+    const std::string serialized = out.str();
+
+    // the buffer belongs to the allocator of the result, without a header so that it is released by its deallocate
+    const refract::Allocator& allocator = refract::AllocatorOf(*res);
+    char* buffer = static_cast<char*>(allocator.allocate(serialized.size() + 1, allocator.ctx));
+
+    if (buffer) {
+        memcpy(buffer, serialized.c_str(), serialized.size() + 1);
     }
 
-    drafter::WrapperOptions wrapperOptions(serialize_opts.sourcemap);
-    drafter::ConversionContext context(wrapperOptions);
+    return buffer;
+}
+
+/* Serialize result to given format by chunks passed to the callback */
+DRAFTER_API drafter_error drafter_serialize_chunked(
+    drafter_result* res, const drafter_serialize_options serialize_opts, drafter_write_cb write_cb, void* ctx)
+{
 
-    sos::Object result = drafter::SerializeRefract(res, context);
+    if (!res) {
+        return DRAFTER_EINVALID_INPUT;
+    }
 
-    std::unique_ptr<sos::Serialize> serializer(CreateSerializer(format));
+    if (!write_cb) {
+        return DRAFTER_EINVALID_OUTPUT;
+    }
 
-    std::ostringstream out;
+    WriteCallbackBuffer buffer(write_cb, ctx);
+    std::ostream out(&buffer);
 
-    Serialization(&out, result, serializer.get());
+    if (!SerializeResult(res, serialize_opts, out)) {
+        return DRAFTER_EINVALID_INPUT;
+    }
 
-    return strdup(out.str().c_str());
+    if (!out) {
+        return DRAFTER_EINVALID_OUTPUT;
+    }
+
+    return DRAFTER_OK;
 }
 
 /* Parse API Blueprint and return only annotations, if NULL than
@@ -161,6 +373,8 @@ DRAFTER_API drafter_error drafter_check_blueprint(
         return DRAFTER_EINVALID_INPUT;
     }
 
+    ParseAllocator allocator(parse_opts);
+
     drafter_result* result = nullptr;
 
     drafter_error ret = drafter_parse_blueprint(source, &result, parse_opts);
@@ -171,20 +385,20 @@ DRAFTER_API drafter_error drafter_check_blueprint(
 
     drafter_result* out = nullptr;
 
-    refract::FilterVisitor filter(refract::query::Element("annotation"));
-    refract::Iterate<refract::Children> iterate(filter);
-    iterate(*result);
+    // annotations are direct children of the parse result, they are moved out of it instead of copying them
+    if (refract::ArrayElement* parseResult = refract::TypeQueryVisitor::as<refract::ArrayElement>(result)) {
+        refract::RefractElements& content = parseResult->value;
 
-    if (!filter.empty()) {
-        refract::ArrayElement::ValueType elements;
+        const refract::RefractElements::iterator annotations = std::stable_partition(content.begin(),
+            content.end(),
+            [](const refract::IElement* e) { return e->element() != drafter::SerializeKey::Annotation; });
 
-        std::transform(filter.elements().begin(),
-            filter.elements().end(),
-            std::back_inserter(elements),
-            std::bind(&refract::IElement::clone, std::placeholders::_1, refract::IElement::cAll));
+        if (annotations != content.end()) {
+            out = new refract::ArrayElement(refract::ArrayElement::ValueType(annotations, content.end()));
+            out->element(drafter::SerializeKey::ParseResult);
 
-        out = new refract::ArrayElement(elements);
-        out->element(drafter::SerializeKey::ParseResult);
+            content.erase(annotations, content.end());
+        }
     }
 
     drafter_free_result(result);
@@ -196,9 +410,154 @@ DRAFTER_API drafter_error drafter_check_blueprint(
 
 DRAFTER_API void drafter_free_result(drafter_result* result)
 {
+    // released by the allocator of the element, \see refract::IElement::operator delete
     delete result;
 }
 
+DRAFTER_API void drafter_set_allocator(const drafter_allocator* allocator)
+{
+    if (!allocator) {
+        refract::SetGlobalAllocator(NULL);
+        return;
+    }
+
+    const refract::Allocator converted = ToAllocator(*allocator);
+    refract::SetGlobalAllocator(&converted);
+}
+
+DRAFTER_API drafter_error drafter_diff(const drafter_result* base, const drafter_result* head, drafter_result** out)
+{
+    if (!base || !head) {
+        return DRAFTER_EINVALID_INPUT;
+    }
+
+    if (!out) {
+        return DRAFTER_EINVALID_OUTPUT;
+    }
+
+    // the diff belongs to the allocator of the base result
+    refract::ScopedAllocator allocator(&refract::AllocatorOf(*base));
+
+    *out = drafter::DiffParseResults(*base, *head);
+
+    return DRAFTER_OK;
+}
+
+DRAFTER_API drafter_incremental_parser* drafter_new_incremental_parser(const drafter_parse_options parse_opts)
+{
+    ParseAllocator allocator(parse_opts);
+    const refract::Limits limits = ToLimits(parse_opts.limits);
+
+    try {
+        return new drafter::IncrementalParser(ParserOptions(parse_opts),
+            NULL,
+            HasLimits(parse_opts.limits) ? &limits : NULL,
+            ToCancelled(parse_opts),
+            ToProgress(parse_opts));
+    } catch (...) {
+        return NULL;
+    }
+}
+
+namespace
+{
+    /**
+     * \brief Run a parse of incremental parser, no exception crosses the C API
+     */
+    template <typename Parse>
+    drafter_error IncrementalParse(const Parse& parse, drafter_result** out)
+    {
+        refract::IElement* result = NULL;
+
+        try {
+            const drafter_error status = (drafter_error)parse(result);
+            *out = result;
+            return status;
+        } catch (...) {
+            delete result;
+            *out = NULL;
+            return DRAFTER_EUNKNOWN;
+        }
+    }
+}
+
+DRAFTER_API drafter_error drafter_incremental_parse(
+    drafter_incremental_parser* parser, const char* source, drafter_result** out)
+{
+
+    if (!parser || !source) {
+        return DRAFTER_EINVALID_INPUT;
+    }
+
+    if (!out) {
+        return DRAFTER_EINVALID_OUTPUT;
+    }
+
+    return IncrementalParse(
+        [parser, source](refract::IElement*& result) { return parser->parse(source, result); }, out);
+}
+
+DRAFTER_API drafter_error drafter_incremental_edit(drafter_incremental_parser* parser,
+    size_t offset,
+    size_t length,
+    const char* replacement,
+    drafter_result** out)
+{
+
+    if (!parser || !replacement) {
+        return DRAFTER_EINVALID_INPUT;
+    }
+
+    if (offset > parser->source().size() || length > parser->source().size() - offset) {
+        return DRAFTER_EINVALID_INPUT;
+    }
+
+    if (!out) {
+        return DRAFTER_EINVALID_OUTPUT;
+    }
+
+    return IncrementalParse(
+        [parser, offset, length, replacement](
+            refract::IElement*& result) { return parser->edit(offset, length, replacement, result); },
+        out);
+}
+
+DRAFTER_API void drafter_free_incremental_parser(drafter_incremental_parser* parser)
+{
+    // the destructor does not throw, \see ~IncrementalParser()
+    delete parser;
+}
+
+DRAFTER_API drafter_cancel_token* drafter_new_cancel_token(void)
+{
+    drafter_cancel_token* token = new (std::nothrow) drafter_cancel_token;
+
+    if (token) {
+        token->cancelled = false;
+    }
+
+    return token;
+}
+
+DRAFTER_API void drafter_cancel(drafter_cancel_token* token)
+{
+    if (token) {
+        token->cancelled = true;
+    }
+}
+
+DRAFTER_API void drafter_reset_cancel_token(drafter_cancel_token* token)
+{
+    if (token) {
+        token->cancelled = false;
+    }
+}
+
+DRAFTER_API void drafter_free_cancel_token(drafter_cancel_token* token)
+{
+    delete token;
+}
+
 #define VERSION_SHIFT_STEP 8
 
 DRAFTER_API unsigned int drafter_version(void)
@@ -9,6 +9,8 @@
 #ifndef DRAFTER_H
 #define DRAFTER_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -52,22 +54,96 @@ extern "C" {
 #ifndef __cplusplus
 #include <stdbool.h>
 typedef struct drafter_result drafter_result;
+typedef struct drafter_incremental_parser drafter_incremental_parser;
 #else
 namespace refract
 {
     struct IElement;
 }
+namespace drafter
+{
+    class IncrementalParser;
+}
 typedef refract::IElement drafter_result;
+typedef drafter::IncrementalParser drafter_incremental_parser;
 #endif
 
+typedef struct drafter_cancel_token drafter_cancel_token;
+
 /* Serialization formats, currently only YAML or JSON */
 typedef enum { DRAFTER_SERIALIZE_YAML = 0, DRAFTER_SERIALIZE_JSON } drafter_format;
 
+/* Memory allocator, every function gets `ctx` of the allocator.
+ * - allocate : returns NULL if the memory can not be allocated
+ * - reallocate : may be NULL, memory is then moved by allocate and deallocate
+ * - deallocate : releases memory returned by allocate or reallocate
+ */
+typedef struct {
+    void* (*allocate)(size_t size, void* ctx);
+    void* (*reallocate)(void* ptr, size_t size, void* ctx);
+    void (*deallocate)(void* ptr, void* ctx);
+    void* ctx;
+} drafter_allocator;
+
+/* Resource limits of a parse, 0 for no limit
+ * - elements : refract elements allocated by the conversion
+ * - expansionDepth : named types expanded one within another
+ * - outputSize : bytes of JSON message bodies and schemas rendered
+ * - time : wall-clock time of the parse in milliseconds
+ * A parse exceeding a limit stops at its next check, before the next section
+ * or element is converted, or while a body or schema is being rendered. It
+ * is reported as an error of code 5.
+ */
+typedef struct {
+    size_t elements;
+    size_t expansionDepth;
+    size_t outputSize;
+    size_t time;
+} drafter_parse_limits;
+
+/* Stages of a parse reported to a progress callback
+ * - PARSING : API Blueprint sections are parsed
+ * - CONVERSION : top-level sections are converted to the result
+ * - EXPANSION : named types are expanded by the conversion
+ * - RENDERING : message bodies and schemas are rendered by the conversion
+ */
+typedef enum {
+    DRAFTER_STAGE_PARSING = 0,
+    DRAFTER_STAGE_CONVERSION,
+    DRAFTER_STAGE_EXPANSION,
+    DRAFTER_STAGE_RENDERING
+} drafter_parse_stage;
+
+/* Progress callback of a parse, called with the stage of the parse, percent
+ * of top-level sections of the stage done and the context from the parsing
+ * options. Expansion and rendering are reported at the percent of the
+ * conversion. It is called by one thread at a time, not necessarily by the
+ * thread parsing, once when a stage starts and then only when the percent
+ * of the stage goes up.
+ */
+typedef void (*drafter_progress_cb)(drafter_parse_stage stage, unsigned int percent, void* ctx);
+
 /* Parsing options
  * - requireBlueprintName : API has to have a name, if not it is a parsing error
+ * - parallel : parse top-level groups and convert resource groups and other
+ *   API description elements concurrently, the result is the same as of
+ *   serial parsing and conversion
+ * - allocator : allocator of the result elements and of buffers serialized
+ *   from the result, NULL for the global allocator, see drafter_set_allocator()
+ * - limits : resource limits of the parse, see above
+ * - cancel : token cancelling the parse, NULL if the parse can not be cancelled,
+ *   a cancelled parse stops, it is reported as an error of code 6
+ * - progress : progress callback, NULL for none
+ * - progress_ctx : context passed to the progress callback
  */
 typedef struct {
     bool requireBlueprintName;
+    bool parallel;
+    const drafter_allocator* allocator;
+    drafter_parse_limits limits;
+    drafter_cancel_token* cancel;
+    drafter_progress_cb progress;
+    void* progress_ctx;
 } drafter_parse_options;
 
 /* Serialization options
@@ -86,7 +162,8 @@ typedef enum {
     DRAFTER_EINVALID_OUTPUT = -3,
 } drafter_error;
 
-/* Parse API Blueprint and serialize it to given format.
+/* Parse API Blueprint and serialize it to given format,
+ * `out` is allocated the same way as by drafter_serialize().
  * Returns:
  * - 0 if everything went smooth.
  * - positive numbers if it encountered parsing errors.
@@ -108,12 +185,40 @@ DRAFTER_API drafter_error drafter_parse_blueprint_to(const char* source,
 DRAFTER_API drafter_error drafter_parse_blueprint(
     const char* source, drafter_result** out, const drafter_parse_options parse_opts);
 
-/* Serialize result to given format, returns NULL if an error is encountered */
+/* Serialize result to given format, returns NULL if an error is encountered.
+ * The buffer is allocated by `allocate` of the allocator of the result and
+ * must be released by its `deallocate`, by free() with the default allocator.
+ */
 DRAFTER_API char* drafter_serialize(drafter_result* res, const drafter_serialize_options serialize_opts);
 
-/* Free memory allocated for result handler */
+/* Output callback of drafter_serialize_chunked(), called with successive chunks
+ * of serialized result and the context passed to drafter_serialize_chunked().
+ * Returns 0 if the chunk was written, any other value aborts serialization.
+ */
+typedef int (*drafter_write_cb)(const char* data, size_t size, void* ctx);
+
+/* Serialize result to given format by chunks passed to the callback.
+ * The result is first converted to a serialization tree as a whole, the same
+ * as by drafter_serialize(). Only the serialized text is buffered by chunks of
+ * a fixed size, so the text is never kept whole in memory.
+ * Returns:
+ * - 0 if everything went smooth.
+ * - DRAFTER_EINVALID_INPUT if there is no result or the format is unknown.
+ * - DRAFTER_EINVALID_OUTPUT if there is no callback or the callback failed.
+ */
+DRAFTER_API drafter_error drafter_serialize_chunked(
+    drafter_result* res, const drafter_serialize_options serialize_opts, drafter_write_cb write_cb, void* ctx);
+
+/* Free memory allocated for result handler, by the allocator it was allocated by */
 DRAFTER_API void drafter_free_result(drafter_result* res);
 
+/* Set the global allocator, used unless parsing options give another one,
+ * NULL restores malloc(), realloc() and free(). Memory is always released
+ * by the allocator it was allocated by. Parses already running keep the
+ * allocator they started with.
+ */
+DRAFTER_API void drafter_set_allocator(const drafter_allocator* allocator);
+
 /* Parse API Blueprint and return only annotations.
  * Returns:
  * - 0 if everything went smooth.
@@ -123,6 +228,66 @@ DRAFTER_API void drafter_free_result(drafter_result* res);
 DRAFTER_API drafter_error drafter_check_blueprint(
     const char* source, drafter_result** res, const drafter_parse_options parse_opts);
 
+/* Compare two parse results, e.g. of two versions of an API Blueprint.
+ * Resources, actions and data structures are matched by their identity
+ * (URI template, method, name), changes of source maps are ignored.
+ * The result is an array element `diff` of `change` elements of class
+ * `added`, `removed` or `changed`, see RefractDiff.h.
+ * Returns:
+ * - 0 if everything went smooth.
+ * - negative numbers if it failed due the programming errors like invalid input.
+ */
+DRAFTER_API drafter_error drafter_diff(const drafter_result* base, const drafter_result* head, drafter_result** out);
+
+/* Create parser of successive revisions of a single API Blueprint, e.g. as
+ * edited in an editor. Top-level sections (resource and data structure groups)
+ * unchanged since the previous parse are not converted again.
+ * Returns NULL if an error is encountered.
+ */
+DRAFTER_API drafter_incremental_parser* drafter_new_incremental_parser(const drafter_parse_options parse_opts);
+
+/* Parse API Blueprint by incremental parser, the result is the same as of
+ * drafter_parse_blueprint() with the options of the parser.
+ * Returns:
+ * - 0 if everything went smooth.
+ * - positive numbers if it encountered parsing errors.
+ * - negative numbers if it failed to parse due the programming errors like invalid input,
+ *   DRAFTER_EUNKNOWN if the parse failed unexpectedly, `out` is then NULL.
+ */
+DRAFTER_API drafter_error drafter_incremental_parse(
+    drafter_incremental_parser* parser, const char* source, drafter_result** out);
+
+/* Replace `length` bytes at byte `offset` of API Blueprint parsed last
+ * by the parser with `replacement` and parse it.
+ * Returns the same as drafter_incremental_parse(), the range out of
+ * the API Blueprint is an invalid input.
+ */
+DRAFTER_API drafter_error drafter_incremental_edit(drafter_incremental_parser* parser,
+    size_t offset,
+    size_t length,
+    const char* replacement,
+    drafter_result** out);
+
+/* Free memory allocated for incremental parser, NULL is ignored */
+DRAFTER_API void drafter_free_incremental_parser(drafter_incremental_parser* parser);
+
+/* Create token cancelling parses given it by parsing options,
+ * returns NULL if an error is encountered.
+ */
+DRAFTER_API drafter_cancel_token* drafter_new_cancel_token(void);
+
+/* Cancel parses of the token, it may be called by any thread while they run.
+ * Parses check the token regularly and return as soon as they notice it.
+ * The token stays cancelled, also for later parses, until it is reset.
+ */
+DRAFTER_API void drafter_cancel(drafter_cancel_token* token);
+
+/* Reset cancelled token, e.g. before the next parse by an incremental parser */
+DRAFTER_API void drafter_reset_cancel_token(drafter_cancel_token* token);
+
+/* Free memory allocated for cancel token, no parse may use it anymore */
+DRAFTER_API void drafter_free_cancel_token(drafter_cancel_token* token);
+
 DRAFTER_API unsigned int drafter_version(void);
 
 DRAFTER_API const char* drafter_version_string(void);
@@ -0,0 +1,168 @@
+//
+//  refract/Allocator.cc
+//  librefract
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include "Allocator.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+namespace refract
+{
+
+    namespace
+    {
+        void* MallocAllocate(size_t size, void*)
+        {
+            return std::malloc(size);
+        }
+
+        void* MallocReallocate(void* ptr, size_t size, void*)
+        {
+            return std::realloc(ptr, size);
+        }
+
+        void MallocDeallocate(void* ptr, void*)
+        {
+            std::free(ptr);
+        }
+
+        const Allocator Default = { &MallocAllocate, &MallocReallocate, &MallocDeallocate, NULL };
+
+        std::atomic<const Allocator*> Global(&Default);
+
+        /// copy of an allocator set globally, linked to the copy set before it
+        struct Installed {
+            Allocator allocator;
+            const Installed* previous;
+        };
+
+        /// copies are never released, the previous allocator may still be in use
+        std::atomic<const Installed*> LastInstalled(NULL);
+
+        thread_local const Allocator* Current = NULL;
+
+        /// header of allocated memory, aligned as the memory returned by malloc()
+        union Header {
+            struct {
+                Allocator allocator;
+                size_t size;
+            } block;
+            std::max_align_t align;
+        };
+
+        Header* HeaderOf(const void* ptr)
+        {
+            return const_cast<Header*>(static_cast<const Header*>(ptr)) - 1;
+        }
+    }
+
+    const Allocator& DefaultAllocator()
+    {
+        return Default;
+    }
+
+    bool IsDefault(const Allocator& allocator)
+    {
+        return allocator.allocate == Default.allocate && allocator.deallocate == Default.deallocate;
+    }
+
+    const Allocator& CurrentAllocator()
+    {
+        return Current ? *Current : *Global.load(std::memory_order_acquire);
+    }
+
+    void SetGlobalAllocator(const Allocator* allocator)
+    {
+        if (!allocator) {
+            Global.store(&Default, std::memory_order_release);
+            return;
+        }
+
+        Installed* installed = new Installed{ *allocator, LastInstalled.load() };
+
+        // every copy stays reachable, so it is not reported as leaked
+        while (!LastInstalled.compare_exchange_weak(installed->previous, installed)) {
+        }
+
+        Global.store(&installed->allocator, std::memory_order_release);
+    }
+
+    ScopedAllocator::ScopedAllocator(const Allocator* allocator)
+        : allocator(allocator ? *allocator : CurrentAllocator()), previous(Current)
+    {
+        Current = &this->allocator;
+    }
+
+    ScopedAllocator::~ScopedAllocator()
+    {
+        Current = previous;
+    }
+
+    void* Allocate(size_t size)
+    {
+        const Allocator& allocator = CurrentAllocator();
+        Header* header = static_cast<Header*>(allocator.allocate(sizeof(Header) + size, allocator.ctx));
+
+        if (!header) {
+            return NULL;
+        }
+
+        header->block.allocator = allocator;
+        header->block.size = size;
+        return header + 1;
+    }
+
+    void* Reallocate(void* ptr, size_t size)
+    {
+        if (!ptr) {
+            return Allocate(size);
+        }
+
+        Header* header = HeaderOf(ptr);
+        const Allocator allocator = header->block.allocator;
+
+        if (allocator.reallocate) {
+            header = static_cast<Header*>(allocator.reallocate(header, sizeof(Header) + size, allocator.ctx));
+
+            if (!header) {
+                return NULL;
+            }
+
+            header->block.size = size;
+            return header + 1;
+        }
+
+        Header* moved = static_cast<Header*>(allocator.allocate(sizeof(Header) + size, allocator.ctx));
+
+        if (!moved) {
+            return NULL;
+        }
+
+        std::memcpy(moved, header, sizeof(Header) + (size < header->block.size ? size : header->block.size));
+        moved->block.size = size;
+        allocator.deallocate(header, allocator.ctx);
+
+        return moved + 1;
+    }
+
+    void Deallocate(void* ptr)
+    {
+        if (!ptr) {
+            return;
+        }
+
+        Header* header = HeaderOf(ptr);
+        header->block.allocator.deallocate(header, header->block.allocator.ctx);
+    }
+
+    const Allocator& AllocatorOf(const void* ptr)
+    {
+        return HeaderOf(ptr)->block.allocator;
+    }
+
+}; // namespace refract
@@ -0,0 +1,84 @@
+//
+//  refract/Allocator.h
+//  librefract
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#ifndef REFRACT_ALLOCATOR_H
+#define REFRACT_ALLOCATOR_H
+
+#include <cstddef>
+
+namespace refract
+{
+
+    /**
+     * Memory allocator, every function gets the context of the allocator
+     *
+     * `reallocate` may be NULL, memory is then reallocated by `allocate`
+     * and `deallocate`.
+     */
+    struct Allocator {
+        void* (*allocate)(size_t size, void* ctx);
+        void* (*reallocate)(void* ptr, size_t size, void* ctx);
+        void (*deallocate)(void* ptr, void* ctx);
+        void* ctx;
+    };
+
+    /// malloc(), realloc() and free()
+    const Allocator& DefaultAllocator();
+
+    /// `allocator` allocates by malloc() and releases by free()
+    bool IsDefault(const Allocator& allocator);
+
+    /// allocator of the calling thread, \see ScopedAllocator, or the global one
+    const Allocator& CurrentAllocator();
+
+    /**
+     * Set the global allocator, NULL restores DefaultAllocator()
+     *
+     * It may be called while other threads allocate, they use either the
+     * previous or the new allocator. Copies of the allocators set are kept
+     * for the process, as references to them may be held.
+     */
+    void SetGlobalAllocator(const Allocator* allocator);
+
+    /**
+     * Allocator of the calling thread for the lifetime of the object,
+     * NULL keeps the current one
+     */
+    class ScopedAllocator
+    {
+        Allocator allocator;
+        const Allocator* previous;
+
+        ScopedAllocator(const ScopedAllocator&);
+        ScopedAllocator& operator=(const ScopedAllocator&);
+
+    public:
+        explicit ScopedAllocator(const Allocator* allocator);
+        ~ScopedAllocator();
+    };
+
+    /**
+     * Allocate memory by the current allocator
+     *
+     * The memory remembers its allocator, so it is reallocated and released
+     * by the allocator it was allocated by, whatever allocator is current.
+     * Returns NULL if the allocator fails.
+     */
+    void* Allocate(size_t size);
+
+    /// reallocate memory returned by Allocate(), NULL `ptr` allocates
+    void* Reallocate(void* ptr, size_t size);
+
+    /// release memory returned by Allocate(), NULL is ignored
+    void Deallocate(void* ptr);
+
+    /// allocator `ptr` was allocated by
+    const Allocator& AllocatorOf(const void* ptr);
+
+}; // namespace refract
+
+#endif // #ifndef REFRACT_ALLOCATOR_H
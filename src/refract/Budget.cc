@@ -0,0 +1,235 @@
+//
+//  refract/Budget.cc
+//  librefract
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include "Budget.h"
+#include "SourceAnnotation.h"
+
+#include <sstream>
+
+namespace refract
+{
+
+    namespace
+    {
+        thread_local Budget* Current = NULL;
+
+        LimitExceeded Exceeded(size_t limit, const char* what)
+        {
+            std::stringstream msg;
+            msg << "the parse has exceeded the limit of " << limit << " " << what;
+            return LimitExceeded(msg.str());
+        }
+    }
+
+    Budget::Budget(const Limits& limits, const std::atomic<bool>* cancelled, const ProgressCallback& progress)
+        : limits(limits),
+          deadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(limits.time)),
+          cancelled(cancelled),
+          progress(progress),
+          elements(0),
+          output(0),
+          sectionPercent(0),
+          sectionStage(ParsingStage),
+          reporting(false)
+    {
+        for (std::atomic<int>& percent : reportedPercents) {
+            percent = -1;
+        }
+    }
+
+    void Budget::allocate()
+    {
+        ++elements;
+    }
+
+    void Budget::expand(size_t depth) const
+    {
+        if (limits.expansionDepth && depth > limits.expansionDepth) {
+            throw Exceeded(limits.expansionDepth, "nested named type expansions");
+        }
+
+        poll(ExpansionStage);
+    }
+
+    void Budget::render(size_t size)
+    {
+        const size_t rendered = output += size;
+
+        if (limits.outputSize && rendered > limits.outputSize) {
+            throw Exceeded(limits.outputSize, "bytes of rendered message bodies and schemas");
+        }
+
+        poll(RenderingStage);
+    }
+
+    void Budget::checkElements() const
+    {
+        if (limits.elements && elements > limits.elements) {
+            throw Exceeded(limits.elements, "elements");
+        }
+    }
+
+    void Budget::checkTime() const
+    {
+        if (limits.time && std::chrono::steady_clock::now() > deadline) {
+            throw Exceeded(limits.time, "milliseconds");
+        }
+    }
+
+    void Budget::checkCancelled() const
+    {
+        if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+            throw ParseCancelled("the parse has been cancelled");
+        }
+    }
+
+    void Budget::poll(ParseStage stage, size_t done, size_t total) const
+    {
+        checkCancelled();
+        checkElements();
+        checkTime();
+        report(stage, done, total);
+    }
+
+    void Budget::report(ParseStage stage, size_t done, size_t total) const
+    {
+        if (!progress) {
+            return;
+        }
+
+        const unsigned percent = total ? static_cast<unsigned>(done * 100 / total) : sectionPercent.load();
+
+        // sections parsed or converted concurrently may be polled out of order
+        if (reportedPercents[stage] >= static_cast<int>(percent)) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(progressMutex);
+
+        if (total) {
+            if (stage != sectionStage) {
+                sectionStage = stage;
+                sectionPercent = percent;
+            } else if (percent > sectionPercent) {
+                sectionPercent = percent;
+            }
+        }
+
+        const unsigned current = total ? sectionPercent.load() : percent;
+
+        if (reportedPercents[stage] >= static_cast<int>(current)) {
+            return;
+        }
+
+        reportedPercents[stage] = current;
+        pendingReports.push_back(std::make_pair(stage, current));
+
+        // reports are delivered in order by the thread delivering already
+        if (reporting) {
+            return;
+        }
+
+        reporting = true;
+
+        while (!pendingReports.empty()) {
+            Reports reports;
+            reports.swap(pendingReports);
+
+            lock.unlock();
+
+            try {
+                for (Reports::const_iterator it = reports.begin(); it != reports.end(); ++it) {
+                    progress(it->first, it->second);
+                }
+            } catch (...) {
+                lock.lock();
+                reporting = false;
+                throw;
+            }
+
+            lock.lock();
+        }
+
+        reporting = false;
+    }
+
+    void Budget::check(const mdp::MarkdownNodeIterator& node, const mdp::MarkdownNodes& collection) const
+    {
+        const bool topLevel = node->hasParent() && !node->parent().hasParent();
+
+        try {
+            if (topLevel) {
+                poll(ParsingStage, node - collection.begin(), collection.size());
+            } else {
+                poll(ParsingStage);
+            }
+        } catch (const ParseCancelled& e) {
+            throw snowcrash::Error(e.what(), snowcrash::CancelledError);
+        } catch (const LimitExceeded& e) {
+            throw snowcrash::Error(e.what(), snowcrash::LimitError);
+        }
+    }
+
+    Budget* CurrentBudget()
+    {
+        return Current;
+    }
+
+    ScopedBudget::ScopedBudget(Budget* budget) : previous(Current)
+    {
+        Current = budget;
+    }
+
+    ScopedBudget::~ScopedBudget()
+    {
+        Current = previous;
+    }
+
+    RenderBuffer::RenderBuffer() : budget(CurrentBudget())
+    {
+        setp(chunk, chunk + sizeof(chunk));
+    }
+
+    void RenderBuffer::flush()
+    {
+        const size_t size = pptr() - pbase();
+
+        // the chunk is dropped if the budget throws
+        setp(chunk, chunk + sizeof(chunk));
+
+        if (budget && size) {
+            budget->render(size);
+        }
+
+        output.append(chunk, size);
+    }
+
+    RenderBuffer::int_type RenderBuffer::overflow(int_type c)
+    {
+        flush();
+
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+
+        return traits_type::not_eof(c);
+    }
+
+    int RenderBuffer::sync()
+    {
+        flush();
+        return 0;
+    }
+
+    const std::string& RenderBuffer::str()
+    {
+        flush();
+        return output;
+    }
+
+}; // namespace refract
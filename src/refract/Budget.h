@@ -0,0 +1,199 @@
+//
+//  refract/Budget.h
+//  librefract
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#ifndef REFRACT_BUDGET_H
+#define REFRACT_BUDGET_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SectionParserData.h"
+
+namespace refract
+{
+
+    /// limits of resources used by a single parse, 0 for no limit
+    struct Limits {
+        size_t elements;       ///< elements allocated
+        size_t expansionDepth; ///< named types expanded one within another
+        size_t outputSize;     ///< bytes of rendered JSON message bodies and schemas
+        size_t time;           ///< wall-clock time in milliseconds
+    };
+
+    /// a limit of the parse has been exceeded, \see Budget
+    struct LimitExceeded : std::runtime_error {
+        explicit LimitExceeded(const std::string& msg) : std::runtime_error(msg)
+        {
+        }
+    };
+
+    /// the parse has been cancelled, \see Budget
+    struct ParseCancelled : std::runtime_error {
+        explicit ParseCancelled(const std::string& msg) : std::runtime_error(msg)
+        {
+        }
+    };
+
+    /// stages of a parse reported to a progress callback
+    enum ParseStage
+    {
+        ParsingStage = 0, ///< markdown sections parsed
+        ConversionStage,  ///< top-level sections converted to refract
+        ExpansionStage,   ///< named types expanded by the conversion
+        RenderingStage    ///< message bodies and schemas rendered by the conversion
+    };
+
+    /**
+     * called with the stage and percent of top-level sections done,
+     * by one thread at a time without any lock of the parse held
+     */
+    typedef std::function<void(ParseStage stage, unsigned percent)> ProgressCallback;
+
+    /**
+     * Resources used by a parse, shared by all the threads of the parse
+     *
+     * Elements are counted while the budget is current in a thread,
+     * \see ScopedBudget. Counting never throws, elements allocated in the
+     * middle of building a tree would leak. The count of elements, time and
+     * cancellation are polled by the parser before every section, by the
+     * conversion before every element converted, and by expansions and
+     * renders, where the partial tree is owned.
+     *
+     * Progress of a stage is reported when the stage is polled first and
+     * whenever its percent of top-level sections done goes up. Expansions
+     * and renders run within the conversion, they are reported at the
+     * percent of the conversion, so switching between the stages of the
+     * conversion does not report the same percent again.
+     */
+    class Budget : public snowcrash::ParseMonitor
+    {
+        const Limits limits;
+        const std::chrono::steady_clock::time_point deadline;
+        const std::atomic<bool>* const cancelled;
+        const ProgressCallback progress;
+
+        std::atomic<size_t> elements;
+        std::atomic<size_t> output;
+
+        typedef std::vector<std::pair<ParseStage, unsigned> > Reports;
+
+        // percent reported last for every stage, -1 if not reported yet
+        mutable std::atomic<int> reportedPercents[RenderingStage + 1];
+
+        // percent of top-level sections done in the stage polled last with sections
+        mutable std::atomic<unsigned> sectionPercent;
+
+        mutable std::mutex progressMutex;
+        mutable ParseStage sectionStage;
+        mutable Reports pendingReports; ///< not delivered to the callback yet
+        mutable bool reporting;         ///< a thread is delivering reports
+
+        Budget(const Budget&);
+        Budget& operator=(const Budget&);
+
+        void report(ParseStage stage, size_t done, size_t total) const;
+
+    public:
+        /**
+         * the time limit starts running now, the parse is cancelled once
+         * `cancelled` is set, progress is reported to `progress` if any
+         */
+        explicit Budget(const Limits& limits,
+            const std::atomic<bool>* cancelled = NULL,
+            const ProgressCallback& progress = ProgressCallback());
+
+        /// count an element being allocated, the limit is checked by the next poll
+        void allocate();
+
+        /// check depth of named types being expanded, \throw LimitExceeded
+        void expand(size_t depth) const;
+
+        /// count bytes of a rendered message body or schema, \throw LimitExceeded
+        void render(size_t size);
+
+        /// \throw LimitExceeded
+        void checkElements() const;
+
+        /// \throw LimitExceeded
+        void checkTime() const;
+
+        /// \throw ParseCancelled
+        void checkCancelled() const;
+
+        /**
+         * poll cancellation, elements and time within `stage` and report progress,
+         * `done` of `total` top-level sections of the stage if `total` is given
+         *
+         * \throw ParseCancelled, LimitExceeded
+         */
+        void poll(ParseStage stage, size_t done = 0, size_t total = 0) const;
+
+        /// poll by the parser, \throw snowcrash::Error
+        virtual void check(const mdp::MarkdownNodeIterator& node, const mdp::MarkdownNodes& collection) const;
+    };
+
+    /// budget of the calling thread, NULL if there is none
+    Budget* CurrentBudget();
+
+    /**
+     * Stream buffer of a rendered message body or schema
+     *
+     * The budget current when it is created is charged with every chunk
+     * of the output before it is kept, so a render exceeding the limit
+     * stops without holding the whole output. Set `std::ios::badbit` in
+     * the exceptions of the stream to have LimitExceeded rethrown.
+     */
+    class RenderBuffer : public std::streambuf
+    {
+        Budget* const budget;
+        std::string output;
+        char chunk[4096];
+
+        RenderBuffer(const RenderBuffer&);
+        RenderBuffer& operator=(const RenderBuffer&);
+
+        /// charge and keep the chunk written
+        void flush();
+
+    protected:
+        virtual int_type overflow(int_type c);
+        virtual int sync();
+
+    public:
+        RenderBuffer();
+
+        /// output rendered so far, \throw LimitExceeded
+        const std::string& str();
+    };
+
+    /**
+     * Budget of the calling thread for the lifetime of the object,
+     * NULL for none
+     */
+    class ScopedBudget
+    {
+        Budget* previous;
+
+        ScopedBudget(const ScopedBudget&);
+        ScopedBudget& operator=(const ScopedBudget&);
+
+    public:
+        explicit ScopedBudget(Budget* budget);
+        ~ScopedBudget();
+    };
+
+}; // namespace refract
+
+#endif // #ifndef REFRACT_BUDGET_H
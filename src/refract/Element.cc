@@ -8,10 +8,14 @@
 #include "Element.h"
 #include <cassert>
 
+#include <cstdlib>
 #include <set>
 #include <map>
+#include <new>
 #include <string>
 
+#include "Allocator.h"
+#include "Budget.h"
 #include "ComparableVisitor.h"
 #include "TypeQueryVisitor.h"
 
@@ -20,25 +24,60 @@ namespace refract
 
     bool isReserved(const std::string& element)
     {
-        static const std::set<std::string> reserved = { "null",
-            "boolean",
-            "number",
-            "string",
+        // reserved names are interned in advance
+        return ElementName::Find(element).reserved();
+    }
+
+    namespace
+    {
+        /// whether the element being released has a header, set right before operator delete
+        thread_local bool ReleasedHasHeader = false;
+    }
 
-            "member",
+    ElementAllocation::ElementAllocation() : headed(!IsDefault(CurrentAllocator()))
+    {
+    }
 
-            "array",
-            "enum",
-            "object",
+    ElementAllocation::ElementAllocation(const ElementAllocation&) : headed(!IsDefault(CurrentAllocator()))
+    {
+    }
+
+    ElementAllocation::~ElementAllocation()
+    {
+        ReleasedHasHeader = headed;
+    }
+
+    void* IElement::operator new(size_t size)
+    {
+        // only counted, throwing here would leak the tree being built
+        if (Budget* budget = CurrentBudget()) {
+            budget->allocate();
+        }
 
-            "ref",
-            "select",
-            "option",
-            "extend",
+        const bool header = !IsDefault(CurrentAllocator());
 
-            "generic" };
+        // released without construction if the arguments of the constructor throw
+        ReleasedHasHeader = header;
 
-        return reserved.find(element) != reserved.end();
+        if (void* ptr = header ? Allocate(size) : std::malloc(size)) {
+            return ptr;
+        }
+
+        throw std::bad_alloc();
+    }
+
+    void IElement::operator delete(void* ptr)
+    {
+        if (ReleasedHasHeader) {
+            Deallocate(ptr);
+        } else {
+            std::free(ptr);
+        }
+    }
+
+    const Allocator& AllocatorOf(const IElement& element)
+    {
+        return element.hasHeader() ? AllocatorOf(static_cast<const void*>(&element)) : DefaultAllocator();
     }
 
     IElement::MemberElementCollection::const_iterator IElement::MemberElementCollection::find(
@@ -89,8 +128,18 @@ namespace refract
 
     void IElement::MemberElementCollection::clone(const IElement::MemberElementCollection& other)
     {
-        for (const auto& el : other.elements) {
-            elements.emplace_back(static_cast<MemberElement*>(el->clone()));
+        clone(other, other.end());
+    }
+
+    void IElement::MemberElementCollection::clone(
+        const IElement::MemberElementCollection& other, IElement::MemberElementCollection::const_iterator skip)
+    {
+        elements.reserve(elements.size() + other.elements.size());
+
+        for (const_iterator it = other.begin(); it != other.end(); ++it) {
+            if (it != skip) {
+                elements.emplace_back(static_cast<MemberElement*>((*it)->clone()));
+            }
         }
     }
 
@@ -14,11 +14,14 @@
 #include <functional>
 #include <stdexcept>
 #include <iterator>
+#include <memory>
 
 #include "Exception.h"
 #include "Visitor.h"
 
+#include "Allocator.h"
 #include "ElementFwd.h"
+#include "ElementName.h"
 
 namespace refract
 {
@@ -60,7 +63,37 @@ namespace refract
         typedef BooleanElement ElementType;
     };
 
-    struct IElement {
+    /**
+     * How an element was allocated, \see IElement::operator new
+     *
+     * Elements allocated by the default allocator have no header naming
+     * their allocator. The first base of IElement remembers whether there
+     * is one. It is destroyed after all the members of the element, right
+     * before the element is released.
+     */
+    class ElementAllocation
+    {
+        const bool headed;
+
+    protected:
+        ElementAllocation();
+        ElementAllocation(const ElementAllocation&);
+        ~ElementAllocation();
+
+        ElementAllocation& operator=(const ElementAllocation&)
+        {
+            return *this;
+        }
+
+    public:
+        /// allocated by Allocate() with a header, otherwise by malloc()
+        bool hasHeader() const
+        {
+            return headed;
+        }
+    };
+
+    struct IElement : public ElementAllocation {
         class MemberElementCollection final
         {
             // FIXME raw pointer ownership
@@ -108,6 +141,9 @@ namespace refract
             /// clone elements from `other` to `this`
             void clone(const MemberElementCollection& other);
 
+            /// clone elements from `other` to `this` except the one at `skip`
+            void clone(const MemberElementCollection& other, const_iterator skip);
+
             // FIXME erase(const std::string) deletes pointer, whereas erase(iterator) does not
             void erase(const std::string& key);
             void erase(iterator it)
@@ -144,9 +180,16 @@ namespace refract
          * usualy injected by "trait", but you can set own
          * via pair method `element(std::string)`
          */
-        virtual std::string element() const = 0;
+        virtual const std::string& element() const = 0;
         virtual void element(const std::string&) = 0;
 
+        /**
+         * interned "name" of element, compared without looking at the string
+         * \see element()
+         */
+        virtual ElementName name() const = 0;
+        virtual void element(const ElementName&) = 0;
+
         // NOTE: probably rename to Accept
         virtual void content(Visitor& v) const = 0;
 
@@ -186,13 +229,30 @@ namespace refract
          */
         static StringElement* Create(const char* value);
 
+        /**
+         * Elements are allocated by the current allocator and released
+         * by the one they were allocated by, \see Allocator.h. Only
+         * elements of other than the default allocator get a header naming
+         * the allocator. They are counted by the current budget, \see Budget.h
+         */
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr);
+
         virtual ~IElement()
         {
         }
     };
 
+    /// allocator `element` was allocated by
+    const Allocator& AllocatorOf(const IElement& element);
+
     bool isReserved(const std::string& element);
 
+    inline bool isReserved(const ElementName& element)
+    {
+        return element.reserved();
+    }
+
     /**
      * CRTP implementation of RefractElement
      */
@@ -206,19 +266,29 @@ namespace refract
         typedef typename TraitType::ValueType ValueType;
 
     protected:
-        std::string element_;
+        ElementName element_;
         bool hasContent; ///< was content of element already set? \see empty()
 
     public:
         // FIXME: move into protected part, currently still required in ComparableVisitor
         ValueType value;
 
-        virtual std::string element() const
+        virtual const std::string& element() const
         {
-            return element_.empty() ? TraitType::element() : element_;
+            return name().str();
         }
 
         virtual void element(const std::string& name)
+        {
+            element_ = ElementName(name);
+        }
+
+        virtual ElementName name() const
+        {
+            return element_.empty() ? TraitType::element() : element_;
+        }
+
+        virtual void element(const ElementName& name)
         {
             element_ = name;
         }
@@ -253,11 +323,7 @@ namespace refract
             }
 
             if (flags & cMeta) {
-                element->meta.clone(self->meta);
-
-                if (flags & cNoMetaId) {
-                    element->meta.erase("id");
-                }
+                element->meta.clone(self->meta, (flags & cNoMetaId) ? self->meta.find("id") : self->meta.end());
             }
 
             if (flags & cValue) {
@@ -292,9 +358,9 @@ namespace refract
         {
             return ValueType();
         }
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "null";
+            return names::Null;
         }
         static void release(ValueType&)
         {
@@ -314,9 +380,9 @@ namespace refract
         {
             return ValueType();
         }
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "string";
+            return names::String;
         }
         static void release(ValueType&)
         {
@@ -345,9 +411,9 @@ namespace refract
         {
             return 0;
         }
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "number";
+            return names::Number;
         }
         static void release(ValueType&)
         {
@@ -376,9 +442,9 @@ namespace refract
         {
             return false;
         }
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "boolean";
+            return names::Boolean;
         }
         static void release(ValueType&)
         {
@@ -407,9 +473,10 @@ namespace refract
         {
             return nullptr;
         }
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "";
+            static const ElementName empty;
+            return empty;
         }
 
         static void release(ValueType& value)
@@ -440,6 +507,53 @@ namespace refract
 
     typedef std::vector<IElement*> RefractElements;
 
+    /**
+     * Elements owned until they are released to their parent
+     *
+     * Elements still owned are deleted when the holder goes out of scope,
+     * so a partial tree is not leaked when a poll of the budget throws.
+     */
+    class OwnedElements
+    {
+        RefractElements elements;
+
+        OwnedElements(const OwnedElements&);
+        OwnedElements& operator=(const OwnedElements&);
+
+    public:
+        OwnedElements()
+        {
+        }
+
+        ~OwnedElements()
+        {
+            for (RefractElements::iterator it = elements.begin(); it != elements.end(); ++it) {
+                delete *it;
+            }
+        }
+
+        /// take ownership of `element`, NULL is kept as well
+        void push_back(IElement* element)
+        {
+            std::unique_ptr<IElement> owned(element);
+            elements.push_back(element);
+            owned.release();
+        }
+
+        RefractElements& get()
+        {
+            return elements;
+        }
+
+        /// give up ownership of the elements
+        RefractElements release()
+        {
+            RefractElements released;
+            released.swap(elements);
+            return released;
+        }
+    };
+
     template <typename Type = IElement, typename Collection = std::vector<Type*> >
     struct ElementCollectionTrait {
         typedef Collection ValueType;
@@ -482,9 +596,9 @@ namespace refract
     };
 
     struct ArrayElementTrait : public ElementCollectionTrait<> {
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "array";
+            return names::Array;
         }
     };
 
@@ -515,9 +629,9 @@ namespace refract
         {
             return nullptr;
         }
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "enum";
+            return names::Enum;
         }
 
         static void release(ValueType& value)
@@ -565,9 +679,9 @@ namespace refract
         {
             return ValueType();
         }
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "member";
+            return names::Member;
         }
 
         static void release(ValueType& member)
@@ -639,9 +753,9 @@ namespace refract
         // FIXME: behavioration for content types different than
         // `(array[Member Element])` is not currently implemented
 
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "object";
+            return names::Object;
         }
     };
 
@@ -677,9 +791,9 @@ namespace refract
         {
             return ValueType();
         }
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "ref";
+            return names::Ref;
         }
         static void release(ValueType&)
         {
@@ -702,9 +816,9 @@ namespace refract
     };
 
     struct ExtendElementTrait : public ElementCollectionTrait<> {
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "extend";
+            return names::Extend;
         }
     };
 
@@ -725,9 +839,9 @@ namespace refract
     };
 
     struct OptionElementTrait : public ElementCollectionTrait<> {
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "option";
+            return names::Option;
         }
     };
 
@@ -757,9 +871,9 @@ namespace refract
     };
 
     struct SelectElementTrait : public ElementCollectionTrait<OptionElement> {
-        static const std::string element()
+        static const ElementName& element()
         {
-            return "select";
+            return names::Select;
         }
 
         static void cloneValue(const ValueType& self, ValueType& other)
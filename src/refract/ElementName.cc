@@ -0,0 +1,155 @@
+//
+//  refract/ElementName.cc
+//  librefract
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include "ElementName.h"
+
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+namespace refract
+{
+
+    namespace
+    {
+
+        /// interned names, entries are erased once no name refers to them
+        struct Table {
+            std::unordered_map<std::string, ElementName::Data> entries;
+            std::mutex mutex;
+
+            Table()
+            {
+                add(std::string(), false, true);
+
+                const char* reserved[] = { "null",
+                    "boolean",
+                    "number",
+                    "string",
+
+                    "member",
+
+                    "array",
+                    "enum",
+                    "object",
+
+                    "ref",
+                    "select",
+                    "option",
+                    "extend",
+
+                    "generic" };
+
+                for (const char* name : reserved) {
+                    add(std::string(name), true, true);
+                }
+            }
+
+            std::unordered_map<std::string, ElementName::Data>::iterator add(
+                const std::string& name, bool reserved, bool pinned)
+            {
+                return entries
+                    .emplace(std::piecewise_construct,
+                        std::forward_as_tuple(name),
+                        std::forward_as_tuple(reserved, pinned))
+                    .first;
+            }
+
+            /// entry of `name` referenced by the caller, or NULL if `create` is false and `name` is not interned
+            const ElementName::Entry* acquire(const std::string& name, bool create)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                std::unordered_map<std::string, ElementName::Data>::iterator it = entries.find(name);
+
+                if (it == entries.end()) {
+                    if (!create) {
+                        return NULL;
+                    }
+
+                    it = add(name, false, false);
+                }
+
+                it->second.references.fetch_add(1, std::memory_order_relaxed);
+                return &*it;
+            }
+
+            /// drops the last reference to `entry` and erases it, unless it has been acquired meanwhile
+            void release(const ElementName::Entry* entry)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if (entry->second.references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    entries.erase(entry->first);
+                }
+            }
+        };
+
+        Table& Names()
+        {
+            // never destroyed, names with static storage may outlive any other static
+            static Table* table = new Table;
+            return *table;
+        }
+
+        const ElementName::Entry* EmptyEntry()
+        {
+            static const ElementName::Entry* empty = &*Names().entries.find(std::string());
+            return empty;
+        }
+    }
+
+    ElementName::ElementName() : entry(EmptyEntry())
+    {
+    }
+
+    ElementName::ElementName(const std::string& name) : entry(Names().acquire(name, true))
+    {
+    }
+
+    void ElementName::release()
+    {
+        if (entry->second.pinned) {
+            return;
+        }
+
+        // zero is only reached under the lock of the table, where entries are acquired
+        size_t references = entry->second.references.load(std::memory_order_relaxed);
+
+        while (references > 1) {
+            if (entry->second.references.compare_exchange_weak(
+                    references, references - 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+
+        Names().release(entry);
+    }
+
+    ElementName ElementName::Find(const std::string& name)
+    {
+        const Entry* entry = Names().acquire(name, false);
+        return entry ? ElementName(entry) : ElementName();
+    }
+
+    namespace names
+    {
+        const ElementName Null("null");
+        const ElementName Boolean("boolean");
+        const ElementName Number("number");
+        const ElementName String("string");
+        const ElementName Member("member");
+        const ElementName Array("array");
+        const ElementName Enum("enum");
+        const ElementName Object("object");
+        const ElementName Ref("ref");
+        const ElementName Select("select");
+        const ElementName Option("option");
+        const ElementName Extend("extend");
+        const ElementName Generic("generic");
+    }
+
+}; // namespace refract
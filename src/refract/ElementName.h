@@ -0,0 +1,157 @@
+//
+//  refract/ElementName.h
+//  librefract
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#ifndef REFRACT_ELEMENTNAME_H
+#define REFRACT_ELEMENTNAME_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace refract
+{
+
+    /**
+     * Interned name of an element
+     *
+     * Names are kept in a global table shared by all threads, equal names
+     * share a single entry, so names are compared and hashed by pointer.
+     * An entry is released with the last name referring to it, names of
+     * base elements and the empty name are kept for the process.
+     */
+    class ElementName
+    {
+    public:
+        struct Data {
+            /// reserved for a base element
+            const bool reserved;
+            /// never released, references are not counted
+            const bool pinned;
+            /// names referring to the entry
+            mutable std::atomic<size_t> references;
+
+            Data(bool reserved, bool pinned) : reserved(reserved), pinned(pinned), references(0)
+            {
+            }
+        };
+
+        /// entry of the table, the name and its data
+        typedef std::pair<const std::string, Data> Entry;
+
+    private:
+        const Entry* entry;
+
+        /// `entry` is already referenced on behalf of the new name
+        explicit ElementName(const Entry* entry) : entry(entry)
+        {
+        }
+
+        void acquire() const
+        {
+            if (!entry->second.pinned) {
+                entry->second.references.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void release();
+
+    public:
+        /// empty name
+        ElementName();
+
+        /// intern `name`
+        explicit ElementName(const std::string& name);
+
+        ElementName(const ElementName& other) : entry(other.entry)
+        {
+            acquire();
+        }
+
+        ElementName& operator=(const ElementName& other)
+        {
+            if (entry != other.entry) {
+                other.acquire();
+                release();
+                entry = other.entry;
+            }
+
+            return *this;
+        }
+
+        ~ElementName()
+        {
+            if (!entry->second.pinned) {
+                release();
+            }
+        }
+
+        /// interned `name`, or empty name if no name refers to it
+        static ElementName Find(const std::string& name);
+
+        const std::string& str() const
+        {
+            return entry->first;
+        }
+
+        bool empty() const
+        {
+            return entry->first.empty();
+        }
+
+        /// reserved for a base element, \see isReserved()
+        bool reserved() const
+        {
+            return entry->second.reserved;
+        }
+
+        bool operator==(const ElementName& other) const
+        {
+            return entry == other.entry;
+        }
+
+        bool operator!=(const ElementName& other) const
+        {
+            return entry != other.entry;
+        }
+
+        /// table order, stable for the process but not between processes
+        bool operator<(const ElementName& other) const
+        {
+            return entry < other.entry;
+        }
+
+        struct Hash {
+            size_t operator()(const ElementName& name) const
+            {
+                return std::hash<const Entry*>()(name.entry);
+            }
+        };
+    };
+
+    /// reserved names of base elements, interned in advance
+    namespace names
+    {
+        extern const ElementName Null;
+        extern const ElementName Boolean;
+        extern const ElementName Number;
+        extern const ElementName String;
+        extern const ElementName Member;
+        extern const ElementName Array;
+        extern const ElementName Enum;
+        extern const ElementName Object;
+        extern const ElementName Ref;
+        extern const ElementName Select;
+        extern const ElementName Option;
+        extern const ElementName Extend;
+        extern const ElementName Generic;
+    }
+
+}; // namespace refract
+
+#endif // #ifndef REFRACT_ELEMENTNAME_H
@@ -6,11 +6,14 @@
 //  Copyright (c) 2015 Apiary Inc. All rights reserved.
 //
 
+#include "Budget.h"
 #include "Element.h"
 #include "Registry.h"
-#include <stack>
+#include <vector>
 
 #include <functional>
+#include <memory>
+#include <unordered_set>
 
 #include <sstream>
 
@@ -33,13 +36,6 @@ namespace refract
     namespace
     {
 
-        bool Expandable(const IElement& e)
-        {
-            IsExpandableVisitor v;
-            VisitBy(e, v);
-            return v.get();
-        }
-
         void CopyMetaId(IElement& dst, const IElement& src)
         {
             IElement::MemberElementCollection::const_iterator name = src.meta.find("id");
@@ -50,11 +46,13 @@ namespace refract
 
         void MetaIdToRef(IElement& e)
         {
-            IElement::MemberElementCollection::const_iterator name = e.meta.find("id");
+            IElement::MemberElementCollection::iterator name = e.meta.find("id");
             if (name != e.meta.end() && (*name)->value.second && !(*name)->value.second->empty()) {
-                IElement* clone = (*name)->value.second->clone();
-                e.meta["ref"] = clone;
+                // move the id instead of copying it, the member is removed anyway
+                IElement* id = (*name)->value.second;
+                (*name)->value.second = nullptr;
                 e.meta.erase("id");
+                e.meta["ref"] = id;
             }
         }
 
@@ -84,32 +82,39 @@ namespace refract
             template <typename Functor>
             RefractElements operator()(const RefractElements& value, Functor& expand)
             {
-                RefractElements members;
-                std::transform(value.begin(), value.end(), std::back_inserter(members), expand);
+                // members expanded so far are released if expansion of the next one throws
+                OwnedElements members;
+
+                for (RefractElements::const_iterator it = value.begin(); it != value.end(); ++it) {
+                    members.push_back(expand(*it));
+                }
 
-                return members;
+                return members.release();
             }
         };
 
-        ExtendElement* GetInheritanceTree(const std::string& name, const Registry& registry)
+        ExtendElement* GetInheritanceTree(const ElementName& name, const Registry& registry)
         {
-            std::stack<IElement*> inheritance;
-            std::string en = name;
-
-            // FIXME: add check against recursive inheritance
-            // walk recursive in registry and expand inheritance tree
-            for (const IElement *parent = registry.find(en); parent && !isReserved(en);
-                 en = parent->element(), parent = registry.find(en)) {
-
-                inheritance.push(parent->clone((IElement::cAll ^ IElement::cElement) | IElement::cNoMetaId));
-                inheritance.top()->meta["ref"] = IElement::Create(en);
+            // the registry knows how many registered ancestors there are,
+            // so the walk ends on recursive inheritance as well
+            const size_t count = registry.find(name) ? registry.depth(name) + 1 : 0;
+            OwnedElements inheritance;
+            inheritance.get().reserve(count);
+            ElementName en = name;
+
+            // walk in registry and expand inheritance tree
+            while (inheritance.get().size() < count) {
+                const IElement* parent = registry.find(en);
+                inheritance.push_back(parent->clone((IElement::cAll ^ IElement::cElement) | IElement::cNoMetaId));
+                inheritance.get().back()->meta["ref"] = IElement::Create(en.str());
+                en = parent->name();
             }
 
+            RefractElements ancestors = inheritance.release();
             ExtendElement* e = new ExtendElement;
 
-            while (!inheritance.empty()) {
-                e->push_back(inheritance.top());
-                inheritance.pop();
+            for (RefractElements::reverse_iterator it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+                e->push_back(*it);
             }
 
             // FIXME: posible solution while referenced type is not found in regisry
@@ -128,10 +133,31 @@ namespace refract
         const Registry& registry;
         ExpandVisitor* expand;
 
+        /// expandability of elements visited during expansion
+        IsExpandableVisitor::Memo expandable;
+
+        /// replaced copies, kept until the end of expansion so their addresses in `expandable` stay unique
+        std::vector<std::unique_ptr<IElement> > discarded;
+
         Context(const Registry& registry, ExpandVisitor* expand) : registry(registry), expand(expand)
         {
         }
 
+        bool Expandable(const IElement& e)
+        {
+            IsExpandableVisitor::Memo::const_iterator found = expandable.find(&e);
+
+            if (found != expandable.end()) {
+                return found->second;
+            }
+
+            IsExpandableVisitor v(&expandable);
+            VisitBy(e, v);
+            expandable.insert(std::make_pair(&e, v.get()));
+
+            return v.get();
+        }
+
         IElement* ExpandOrClone(const IElement* e) const
         {
             IElement* result = NULL;
@@ -149,6 +175,26 @@ namespace refract
             return result;
         }
 
+        /**
+         * Expand `elements` in place, an element not needing expansion is kept
+         * instead of being replaced by its copy
+         */
+        void ExpandInPlace(RefractElements& elements)
+        {
+            for (RefractElements::iterator it = elements.begin(); it != elements.end(); ++it) {
+                if (!*it) {
+                    continue;
+                }
+
+                VisitBy(**it, *expand);
+
+                if (IElement* expanded = expand->get()) {
+                    discarded.push_back(std::unique_ptr<IElement>(*it));
+                    *it = expanded;
+                }
+            }
+        }
+
         template <typename V>
         V ExpandValue(const V& v)
         {
@@ -159,7 +205,7 @@ namespace refract
         template <typename T>
         T* ExpandMembers(const T& e)
         {
-            T* o = new T;
+            std::unique_ptr<T> o(new T);
             o->attributes.clone(e.attributes);
             o->meta.clone(e.meta);
 
@@ -167,52 +213,60 @@ namespace refract
                 o->set(ExpandValue(e.value));
             }
 
-            return o;
+            return o.release();
         }
 
-        std::deque<std::string> members;
+        /// named types being expanded
+        std::unordered_set<ElementName, ElementName::Hash> members;
 
         template <typename T>
         IElement* ExpandNamedType(const T& e)
         {
+            const ElementName name = e.name();
 
             // Look for Circular Reference thro members
-            if (std::find(members.begin(), members.end(), e.element()) != members.end()) {
+            if (members.count(name)) {
                 // To avoid unfinised recursion just clone
-                const IElement* root = FindRootAncestor(e.element(), registry);
+                const IElement* root = registry.root(name);
                 // FIXME: if not found root
                 IElement* result = root->clone(IElement::cMeta | IElement::cAttributes | IElement::cNoMetaId);
-                result->meta["ref"] = IElement::Create(e.element());
+                result->meta["ref"] = IElement::Create(name.str());
                 return result;
             }
 
-            members.push_back(e.element());
+            if (Budget* budget = CurrentBudget()) {
+                budget->expand(members.size() + 1);
+            }
+
+            members.insert(name);
 
-            ExtendElement* tree = GetInheritanceTree(e.element(), registry);
-            ExtendElement* extend = ExpandMembers(*tree);
-            delete tree;
+            // ancestors are already copies, so they are expanded without copying them again
+            std::unique_ptr<ExtendElement> extend(GetInheritanceTree(name, registry));
+            ExpandInPlace(extend->value);
 
             CopyMetaId(*extend, e);
 
-            members.pop_back();
+            members.erase(name);
 
             T* origin = ExpandMembers(e);
             origin->meta.erase("id");
 
             extend->push_back(origin);
 
-            return extend;
+            return extend.release();
         }
 
         RefElement* ExpandReference(const RefElement& e)
         {
-            RefElement* ref = static_cast<RefElement*>(e.clone());
+            std::unique_ptr<RefElement> ref(static_cast<RefElement*>(e.clone()));
 
             if (ref->value.empty()) {
-                return ref;
+                return ref.release();
             }
 
-            if (std::find(members.begin(), members.end(), ref->value) != members.end()) {
+            const ElementName name(ref->value);
+
+            if (members.count(name)) {
 
                 std::stringstream msg;
                 msg << "named type '";
@@ -222,17 +276,21 @@ namespace refract
                 throw snowcrash::Error(msg.str(), snowcrash::MSONError);
             }
 
-            members.push_back(ref->value);
+            if (Budget* budget = CurrentBudget()) {
+                budget->expand(members.size() + 1);
+            }
+
+            members.insert(name);
 
-            if (IElement* referenced = registry.find(ref->value)) {
+            if (IElement* referenced = registry.find(name)) {
                 referenced = ExpandOrClone(referenced);
                 MetaIdToRef(*referenced);
                 ref->attributes["resolved"] = referenced;
             }
 
-            members.pop_back();
+            members.erase(name);
 
-            return ref;
+            return ref.release();
         }
     };
 
@@ -243,7 +301,7 @@ namespace refract
         ExpandElement(const T& e, ExpandVisitor::Context* context) : result(NULL)
         {
 
-            if (!isReserved(e.element())) { // expand named type
+            if (!isReserved(e.name())) { // expand named type
                 result = context->ExpandNamedType(e);
             }
         }
@@ -278,18 +336,18 @@ namespace refract
         ExpandElement(const T& e, ExpandVisitor::Context* context) : result(NULL)
         {
 
-            if (!Expandable(e)) { // do we have some expandable members?
+            if (!context->Expandable(e)) { // do we have some expandable members?
                 return;
             }
 
-            T* o = new T;
+            std::unique_ptr<T> o(new T);
             o->meta.clone(e.meta);
 
             for (std::vector<OptionElement*>::const_iterator it = e.value.begin(); it != e.value.end(); ++it) {
                 o->push_back(static_cast<OptionElement*>(context->ExpandOrClone(*it)));
             }
 
-            result = o;
+            result = o.release();
         }
 
         operator IElement*()
@@ -305,13 +363,11 @@ namespace refract
         ExpandElement(const T& e, ExpandVisitor::Context* context) : result(NULL)
         {
 
-            if (!Expandable(e)) { // do we have some expandable members?
+            if (!context->Expandable(e)) { // do we have some expandable members?
                 return;
             }
 
-            std::string en = e.element();
-
-            if (!isReserved(en)) { // expand named type
+            if (!isReserved(e.name())) { // expand named type
                 result = context->ExpandNamedType(e);
             } else { // walk throught members and expand them
                 result = context->ExpandMembers(e);
@@ -331,14 +387,18 @@ namespace refract
         ExpandElement(const T& e, ExpandVisitor::Context* context) : result(NULL)
         {
 
-            if (!Expandable(e)) {
+            if (!context->Expandable(e)) {
                 return;
             }
 
-            MemberElement* expanded = static_cast<MemberElement*>(e.clone(IElement::cAll ^ IElement::cValue));
-            expanded->set(context->ExpandOrClone(e.value.first), context->ExpandOrClone(e.value.second));
+            std::unique_ptr<MemberElement> expanded(
+                static_cast<MemberElement*>(e.clone(IElement::cAll ^ IElement::cValue)));
+            std::unique_ptr<IElement> key(context->ExpandOrClone(e.value.first));
+            IElement* value = context->ExpandOrClone(e.value.second);
+
+            expanded->set(key.release(), value);
 
-            result = expanded;
+            result = expanded.release();
         }
 
         operator IElement*()
@@ -368,11 +428,13 @@ namespace refract
     // do nothing, DirectElements are not expandable
     void ExpandVisitor::operator()(const HolderElement& e)
     {
+        result = NULL;
     }
 
     // do nothing, NullElements are not expandable
     void ExpandVisitor::operator()(const NullElement& e)
     {
+        result = NULL;
     }
 
     VISIT_IMPL(String)
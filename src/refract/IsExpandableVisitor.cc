@@ -13,22 +13,36 @@ namespace refract
 
     namespace
     {
-        struct CheckElement {
-            bool checkElement(const IElement* e) const
-            {
-                std::string type;
+        bool IsExpandableChild(const IElement& e, IsExpandableVisitor::Memo* memo)
+        {
+            if (memo) {
+                IsExpandableVisitor::Memo::const_iterator found = memo->find(&e);
 
-                if (e) {
-                    type = e->element();
+                if (found != memo->end()) {
+                    return found->second;
                 }
+            }
+
+            IsExpandableVisitor v(memo);
+            VisitBy(e, v);
 
-                return !isReserved(type);
+            if (memo) {
+                memo->insert(std::make_pair(&e, v.get()));
+            }
+
+            return v.get();
+        }
+
+        struct CheckElement {
+            bool checkElement(const IElement* e) const
+            {
+                return !e || !isReserved(e->name());
             }
         };
 
         template <typename T, typename V = typename T::ValueType>
         struct IsExpandable : public CheckElement {
-            bool operator()(const T* e) const
+            bool operator()(const T* e, IsExpandableVisitor::Memo* memo) const
             {
 
                 if (checkElement(e)) {
@@ -41,7 +55,7 @@ namespace refract
 
         template <typename T>
         struct IsExpandable<T, RefElement::ValueType> : public CheckElement {
-            bool operator()(const T* e) const
+            bool operator()(const T* e, IsExpandableVisitor::Memo* memo) const
             {
 
                 return true;
@@ -50,7 +64,7 @@ namespace refract
 
         template <typename T>
         struct IsExpandable<T, SelectElement::ValueType> : public CheckElement {
-            bool operator()(const T* e) const
+            bool operator()(const T* e, IsExpandableVisitor::Memo* memo) const
             {
 
                 if (checkElement(e)) {
@@ -58,10 +72,7 @@ namespace refract
                 }
 
                 for (std::vector<OptionElement*>::const_iterator i = e->value.begin(); i != e->value.end(); ++i) {
-                    IsExpandableVisitor v;
-                    VisitBy(*(*i), v);
-
-                    if (v.get()) {
+                    if (IsExpandableChild(*(*i), memo)) {
                         return true;
                     }
                 }
@@ -72,27 +83,19 @@ namespace refract
 
         template <typename T>
         struct IsExpandable<T, MemberElement::ValueType> : public CheckElement {
-            bool operator()(const T* e) const
+            bool operator()(const T* e, IsExpandableVisitor::Memo* memo) const
             {
 
                 if (checkElement(e)) {
                     return true;
                 }
 
-                if (e->value.first) {
-                    IsExpandableVisitor v;
-                    VisitBy(*e->value.first, v);
-                    if (v.get()) {
-                        return true;
-                    }
+                if (e->value.first && IsExpandableChild(*e->value.first, memo)) {
+                    return true;
                 }
 
-                if (e->value.second) {
-                    IsExpandableVisitor v;
-                    VisitBy(*e->value.second, v);
-                    if (v.get()) {
-                        return true;
-                    }
+                if (e->value.second && IsExpandableChild(*e->value.second, memo)) {
+                    return true;
                 }
 
                 return false;
@@ -101,7 +104,7 @@ namespace refract
 
         template <typename T>
         struct IsExpandable<T, RefractElements> : public CheckElement {
-            bool operator()(const T* e) const
+            bool operator()(const T* e, IsExpandableVisitor::Memo* memo) const
             {
 
                 if (checkElement(e)) {
@@ -109,10 +112,7 @@ namespace refract
                 }
 
                 for (std::vector<IElement*>::const_iterator i = e->value.begin(); i != e->value.end(); ++i) {
-                    IsExpandableVisitor v;
-                    VisitBy(*(*i), v);
-
-                    if (v.get()) {
+                    if (IsExpandableChild(*(*i), memo)) {
                         return true;
                     }
                 }
@@ -122,14 +122,14 @@ namespace refract
         };
     } // anonymous namespace
 
-    IsExpandableVisitor::IsExpandableVisitor() : result(false)
+    IsExpandableVisitor::IsExpandableVisitor(Memo* memo) : result(false), memo(memo)
     {
     }
 
     template <typename T>
     void IsExpandableVisitor::operator()(const T& e)
     {
-        result = IsExpandable<T>()(&e);
+        result = IsExpandable<T>()(&e, memo);
     }
 
     template <>
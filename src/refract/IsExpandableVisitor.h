@@ -9,16 +9,29 @@
 #ifndef REFRACT_ISEXPANDABLEVISITOR_H
 #define REFRACT_ISEXPANDABLEVISITOR_H
 
+#include <unordered_map>
+
 namespace refract
 {
 
+    struct IElement;
+
     class IsExpandableVisitor
     {
+    public:
+        /// results of visited elements and their descendants
+        typedef std::unordered_map<const IElement*, bool> Memo;
 
+    private:
         bool result;
+        Memo* memo;
 
     public:
-        IsExpandableVisitor();
+        /**
+         * \param memo optional memo of results, elements must not be modified
+         * or deleted while it is in use
+         */
+        explicit IsExpandableVisitor(Memo* memo = NULL);
 
         template <typename T>
         void operator()(const T& e);
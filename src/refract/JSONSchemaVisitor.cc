@@ -9,7 +9,6 @@
 
 #include "VisitorUtils.h"
 #include "sosJSON.h"
-#include <sstream>
 #include <iostream>
 #include <map>
 #include <set>
@@ -17,6 +16,7 @@
 #include "RenderJSONVisitor.h"
 #include "JSONSchemaVisitor.h"
 #include "SerializeCompactVisitor.h"
+#include "Budget.h"
 
 
 #include <assert.h>
@@ -55,7 +55,7 @@ namespace refract
                 continue;
             }
 
-            if (value->element() == "ref") {
+            if (value->name() == names::Ref) {
                 HandleRefWhenFetchingMembers<T>(value, members, IncludeMembers<T>);
                 continue;
             }
@@ -568,14 +568,19 @@ namespace refract
         }
 
         sos::SerializeJSON s;
-        std::stringstream ss;
+
+        // the budget is charged while the schema is written
+        RenderBuffer buffer;
+        std::ostream os(&buffer);
+        os.exceptions(std::ios::badbit);
+
         // FIXME: remove SosSerializeCompactVisitor dependency
         SosSerializeCompactVisitor sv(false);
         VisitBy(*pObj, sv);
 
-        s.process(sv.value(), ss);
+        s.process(sv.value(), os);
 
-        return ss.str();
+        return buffer.str();
     }
 
     void JSONSchemaVisitor::processMembers(const std::vector<refract::IElement*>& members,
@@ -0,0 +1,459 @@
+//
+//  refract/PathQuery.cc
+//  librefract
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include "PathQuery.h"
+
+#include <set>
+
+#include "Element.h"
+#include "Exception.h"
+#include "TypeQueryVisitor.h"
+#include "Visitor.h"
+
+namespace refract
+{
+
+    namespace query
+    {
+
+        namespace
+        {
+
+            /**
+             * Collects children of visited element
+             */
+            struct ChildrenVisitor {
+                Elements& children;
+
+                explicit ChildrenVisitor(Elements& children) : children(children)
+                {
+                }
+
+                void add(const IElement* e)
+                {
+                    if (e) {
+                        children.push_back(e);
+                    }
+                }
+
+                template <typename V>
+                void addValue(const V&)
+                {
+                }
+
+                void addValue(IElement* value)
+                {
+                    add(value);
+                }
+
+                void addValue(const MemberElement::ValueType& value)
+                {
+                    add(value.first);
+                    add(value.second);
+                }
+
+                template <typename T>
+                void addValue(const std::vector<T*>& values)
+                {
+                    for (typename std::vector<T*>::const_iterator it = values.begin(); it != values.end(); ++it) {
+                        add(*it);
+                    }
+                }
+
+                void operator()(const IElement&)
+                {
+                }
+
+                template <typename T>
+                void operator()(const T& e)
+                {
+                    addValue(e.value);
+                }
+            };
+
+            void AppendChildren(const IElement& e, Elements& children)
+            {
+                ChildrenVisitor visitor(children);
+                VisitBy(e, visitor);
+            }
+
+            /// pre-order walk of descendants
+            void AppendDescendants(const IElement& e, Elements& descendants)
+            {
+                const size_t first = descendants.size();
+                AppendChildren(e, descendants);
+                const size_t last = descendants.size();
+
+                // children are collected first, so their subtrees are inserted behind each of them
+                Elements children(descendants.begin() + first, descendants.begin() + last);
+                descendants.resize(first);
+
+                for (Elements::const_iterator it = children.begin(); it != children.end(); ++it) {
+                    descendants.push_back(*it);
+                    AppendDescendants(**it, descendants);
+                }
+            }
+
+            std::string StringValue(const IElement* e)
+            {
+                const StringElement* s = TypeQueryVisitor::as<StringElement>(e);
+                return s ? s->value : std::string();
+            }
+
+            bool HasClass(const IElement& e, const std::string& name)
+            {
+                IElement::MemberElementCollection::const_iterator classes = e.meta.find("classes");
+
+                if (classes == e.meta.end()) {
+                    return false;
+                }
+
+                const ArrayElement* array = TypeQueryVisitor::as<ArrayElement>((*classes)->value.second);
+
+                if (!array) {
+                    return false;
+                }
+
+                for (RefractElements::const_iterator it = array->value.begin(); it != array->value.end(); ++it) {
+                    if (StringValue(*it) == name) {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            bool MatchesPredicate(const IElement& e, const Path::Predicate& predicate)
+            {
+                switch (predicate.kind) {
+                    case Path::Predicate::Id: {
+                        IElement::MemberElementCollection::const_iterator id = e.meta.find("id");
+                        return id != e.meta.end() && StringValue((*id)->value.second) == predicate.value;
+                    }
+
+                    case Path::Predicate::Class:
+                        return HasClass(e, predicate.value);
+
+                    case Path::Predicate::Attribute: {
+                        IElement::MemberElementCollection::const_iterator attribute
+                            = e.attributes.find(predicate.name);
+
+                        if (attribute == e.attributes.end()) {
+                            return false;
+                        }
+
+                        return !predicate.hasValue || StringValue((*attribute)->value.second) == predicate.value;
+                    }
+                }
+
+                return false;
+            }
+
+            /**
+             * Recursive descent parser of path expression
+             */
+            class Parser
+            {
+                const std::string& expression;
+                std::string::size_type position;
+
+                void error(const std::string& message) const
+                {
+                    throw LogicError("invalid path query '" + expression + "': " + message);
+                }
+
+                bool at(char c) const
+                {
+                    return position < expression.size() && expression[position] == c;
+                }
+
+                static bool IsNameChar(char c)
+                {
+                    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'
+                        || c == '-' || c == '.' || c == ':';
+                }
+
+                std::string name()
+                {
+                    std::string::size_type start = position;
+
+                    while (position < expression.size() && IsNameChar(expression[position])) {
+                        ++position;
+                    }
+
+                    if (start == position) {
+                        error("name expected");
+                    }
+
+                    return expression.substr(start, position - start);
+                }
+
+                std::string value()
+                {
+                    if (at('\'') || at('"')) {
+                        const char quote = expression[position++];
+                        std::string::size_type end = expression.find(quote, position);
+
+                        if (end == std::string::npos) {
+                            error("unterminated quoted value");
+                        }
+
+                        std::string result = expression.substr(position, end - position);
+                        position = end + 1;
+                        return result;
+                    }
+
+                    std::string::size_type end = expression.find(']', position);
+
+                    if (end == std::string::npos) {
+                        error("missing ']'");
+                    }
+
+                    std::string result = expression.substr(position, end - position);
+                    position = end;
+                    return result;
+                }
+
+                Path::Predicate predicate()
+                {
+                    Path::Predicate result;
+                    result.hasValue = false;
+
+                    if (at('@')) {
+                        ++position;
+                        result.kind = Path::Predicate::Attribute;
+                        result.name = name();
+                    } else {
+                        result.name = name();
+
+                        if (result.name == "id") {
+                            result.kind = Path::Predicate::Id;
+                        } else if (result.name == "class") {
+                            result.kind = Path::Predicate::Class;
+                        } else {
+                            error("unknown predicate '" + result.name + "'");
+                        }
+                    }
+
+                    if (at('=')) {
+                        ++position;
+                        result.value = value();
+                        result.hasValue = true;
+                    } else if (result.kind != Path::Predicate::Attribute) {
+                        error("value of predicate '" + result.name + "' expected");
+                    }
+
+                    if (!at(']')) {
+                        error("missing ']'");
+                    }
+
+                    ++position;
+
+                    return result;
+                }
+
+                Path::Step step(bool descendants)
+                {
+                    Path::Step result;
+                    result.descendants = descendants;
+
+                    if (at('*')) {
+                        ++position;
+                    } else {
+                        result.name = name();
+                    }
+
+                    while (at('[')) {
+                        ++position;
+                        result.predicates.push_back(predicate());
+                    }
+
+                    return result;
+                }
+
+            public:
+                explicit Parser(const std::string& expression) : expression(expression), position(0)
+                {
+                }
+
+                void parse(std::vector<Path::Step>& steps)
+                {
+                    bool descendants = false;
+
+                    if (expression.compare(0, 2, "//") == 0) {
+                        descendants = true;
+                        position = 2;
+                    } else if (at('/')) {
+                        ++position;
+                    }
+
+                    while (true) {
+                        steps.push_back(step(descendants));
+
+                        if (position == expression.size()) {
+                            return;
+                        }
+
+                        if (!at('/')) {
+                            error("'/' expected");
+                        }
+
+                        ++position;
+                        descendants = at('/');
+
+                        if (descendants) {
+                            ++position;
+                        }
+                    }
+                }
+            };
+        }
+
+        Index::Index(const IElement& root) : root(root), built(false)
+        {
+        }
+
+        void Index::build()
+        {
+            if (built) {
+                return;
+            }
+
+            AppendDescendants(root, all);
+
+            for (Elements::const_iterator it = all.begin(); it != all.end(); ++it) {
+                names[(*it)->element()].push_back(*it);
+
+                IElement::MemberElementCollection::const_iterator id = (*it)->meta.find("id");
+
+                if (id != (*it)->meta.end()) {
+                    ids[StringValue((*id)->value.second)].push_back(*it);
+                }
+            }
+
+            built = true;
+        }
+
+        const Elements& Index::elements()
+        {
+            build();
+            return all;
+        }
+
+        namespace
+        {
+            const Elements& Find(const std::map<std::string, Elements>& elements, const std::string& key)
+            {
+                static const Elements none;
+                std::map<std::string, Elements>::const_iterator found = elements.find(key);
+
+                return found != elements.end() ? found->second : none;
+            }
+        }
+
+        const Elements& Index::byName(const std::string& name)
+        {
+            build();
+            return Find(names, name);
+        }
+
+        const Elements& Index::byId(const std::string& id)
+        {
+            build();
+            return Find(ids, id);
+        }
+
+        Path::Path(const std::string& expression)
+        {
+            Parser(expression).parse(steps);
+        }
+
+        bool Path::Matches(const IElement& e, const Step& step)
+        {
+            if (!step.name.empty() && e.element() != step.name) {
+                return false;
+            }
+
+            for (std::vector<Predicate>::const_iterator it = step.predicates.begin(); it != step.predicates.end();
+                 ++it) {
+                if (!MatchesPredicate(e, *it)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        Elements Path::select(const IElement& root) const
+        {
+            return select(Elements(1, &root), steps.begin());
+        }
+
+        Elements Path::select(Index& index) const
+        {
+            const Step& first = steps.front();
+
+            if (!first.descendants) {
+                return select(Elements(1, &index.tree()), steps.begin());
+            }
+
+            Elements candidates;
+
+            std::vector<Predicate>::const_iterator id = first.predicates.begin();
+
+            while (id != first.predicates.end() && id->kind != Predicate::Id) {
+                ++id;
+            }
+
+            if (id != first.predicates.end()) {
+                candidates = index.byId(id->value);
+            } else if (!first.name.empty()) {
+                candidates = index.byName(first.name);
+            } else {
+                candidates = index.elements();
+            }
+
+            Elements matched;
+
+            for (Elements::const_iterator it = candidates.begin(); it != candidates.end(); ++it) {
+                if (Matches(**it, first)) {
+                    matched.push_back(*it);
+                }
+            }
+
+            return select(matched, steps.begin() + 1);
+        }
+
+        Elements Path::select(Elements context, std::vector<Step>::const_iterator step) const
+        {
+            for (; step != steps.end() && !context.empty(); ++step) {
+                Elements next;
+                std::set<const IElement*> seen;
+
+                for (Elements::const_iterator it = context.begin(); it != context.end(); ++it) {
+                    Elements candidates;
+
+                    if (step->descendants) {
+                        AppendDescendants(**it, candidates);
+                    } else {
+                        AppendChildren(**it, candidates);
+                    }
+
+                    for (Elements::const_iterator c = candidates.begin(); c != candidates.end(); ++c) {
+                        if (Matches(**c, *step) && seen.insert(*c).second) {
+                            next.push_back(*c);
+                        }
+                    }
+                }
+
+                context.swap(next);
+            }
+
+            return context;
+        }
+    }
+}
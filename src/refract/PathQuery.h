@@ -0,0 +1,126 @@
+//
+//  refract/PathQuery.h
+//  librefract
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#ifndef REFRACT_PATHQUERY_H
+#define REFRACT_PATHQUERY_H
+
+#include "ElementFwd.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace refract
+{
+
+    namespace query
+    {
+
+        typedef std::vector<const IElement*> Elements;
+
+        /**
+         * Index of elements of a tree by element name and meta id
+         *
+         * The index is built on the first lookup, by a single walk of
+         * the tree. It is valid while the tree is not modified.
+         */
+        class Index
+        {
+            const IElement& root;
+            bool built;
+
+            Elements all;
+            std::map<std::string, Elements> names;
+            std::map<std::string, Elements> ids;
+
+            void build();
+
+        public:
+            explicit Index(const IElement& root);
+
+            /// root of the indexed tree
+            const IElement& tree() const
+            {
+                return root;
+            }
+
+            /// all descendants of root in document order
+            const Elements& elements();
+
+            /// descendants of root of given element name in document order
+            const Elements& byName(const std::string& name);
+
+            /// descendants of root with meta id in document order, ids may repeat in a tree
+            const Elements& byId(const std::string& id);
+        };
+
+        /**
+         * Compiled path query
+         *
+         * A path is a sequence of steps separated by `/` (children of
+         * the elements matched so far) or `//` (all their descendants).
+         * The first step is matched against children of the root, or
+         * against its descendants if the path starts with `//`. A step
+         * is an element name or `*` followed by any of predicates:
+         *
+         * - `[id=value]` meta id equals value
+         * - `[class=value]` meta classes contain value
+         * - `[@name]` attribute is present
+         * - `[@name=value]` attribute is a string equal to value
+         *
+         * Values may be quoted by `'` or `"`. E.g. `//httpTransaction`,
+         * `annotation[class=warning]` or `//*[id=User]`.
+         *
+         * Children of an element are items of its content, key and value
+         * of a member and the element held by holder and enum elements.
+         */
+        class Path
+        {
+        public:
+            struct Predicate {
+                enum Kind
+                {
+                    Id,
+                    Class,
+                    Attribute
+                } kind;
+
+                std::string name;
+                std::string value;
+                bool hasValue;
+            };
+
+            struct Step {
+                bool descendants;
+                std::string name; ///< empty for any element
+                std::vector<Predicate> predicates;
+            };
+
+            /**
+             * \throw LogicError on syntax error
+             */
+            explicit Path(const std::string& expression);
+
+            /// elements matching path in document order
+            Elements select(const IElement& root) const;
+
+            /// elements matching path in document order, the first step is looked up in index if possible
+            Elements select(Index& index) const;
+
+            /// does element match step
+            static bool Matches(const IElement& e, const Step& step);
+
+        private:
+            std::vector<Step> steps;
+
+            Elements select(Elements context, std::vector<Step>::const_iterator step) const;
+        };
+    };
+
+}; // namespace refract
+
+#endif // #ifndef REFRACT_PATHQUERY_H
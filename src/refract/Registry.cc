@@ -8,29 +8,21 @@
 
 #include "Registry.h"
 #include "Element.h"
-#include "SerializeCompactVisitor.h"
 #include "TypeQueryVisitor.h"
 
 #include <algorithm>
+#include <vector>
 
 namespace refract
 {
 
     IElement* FindRootAncestor(const std::string& name, const Registry& registry)
     {
-        IElement* parent = registry.find(name);
-
-        while (parent && !isReserved(parent->element())) {
-            IElement* next = registry.find(parent->element());
-
-            if (!next || (next == parent)) {
-                return parent;
-            }
-
-            parent = next;
-        }
+        return registry.root(name);
+    }
 
-        return parent;
+    Registry::Registry() : generation(1)
+    {
     }
 
     std::string Registry::getElementId(IElement* element)
@@ -41,10 +33,6 @@ namespace refract
             throw LogicError("Element has no ID");
         }
 
-        // FIXME: remove dependecy on SosSerializeCompactVisitor
-        SosSerializeCompactVisitor v;
-        VisitBy(*(*it)->value.second, v);
-
         if (StringElement* s = TypeQueryVisitor::as<StringElement>((*it)->value.second)) {
             return s->value;
         }
@@ -52,7 +40,7 @@ namespace refract
         throw LogicError("Value of element meta 'id' is not StringElement");
     }
 
-    IElement* Registry::find(const std::string& name) const
+    const Registry::Entry* Registry::resolve(const ElementName& name) const
     {
         Map::const_iterator i = registrated.find(name);
 
@@ -60,57 +48,126 @@ namespace refract
             return NULL;
         }
 
-        return i->second;
+        if (i->second.generation.load(std::memory_order_acquire) == generation) {
+            return &i->second;
+        }
+
+        std::unique_lock<std::mutex> lock(ancestryMutex);
+
+        // resolved by another lookup meanwhile
+        if (i->second.generation.load(std::memory_order_relaxed) == generation) {
+            return &i->second;
+        }
+
+        // walk up to the first entry with known ancestry,
+        // an entry already in the chain ends it, so recursive inheritance stops as well
+        std::vector<const Entry*> chain(1, &i->second);
+
+        while (!isReserved(chain.back()->element->name())) {
+            Map::const_iterator next = registrated.find(chain.back()->element->name());
+
+            if (next == registrated.end() || std::find(chain.begin(), chain.end(), &next->second) != chain.end()) {
+                break;
+            }
+
+            chain.push_back(&next->second);
+
+            if (next->second.generation.load(std::memory_order_relaxed) == generation) {
+                break;
+            }
+        }
+
+        const Entry* last = chain.back();
+
+        if (last->generation.load(std::memory_order_relaxed) != generation) {
+            last->root = last->element;
+            last->depth = 0;
+            last->generation.store(generation, std::memory_order_release);
+        }
+
+        for (std::vector<const Entry*>::reverse_iterator it = chain.rbegin() + 1; it != chain.rend(); ++it) {
+            (*it)->root = last->root;
+            (*it)->depth = last->depth + 1;
+            (*it)->generation.store(generation, std::memory_order_release);
+            last = *it;
+        }
+
+        return &i->second;
     }
 
-    bool Registry::add(IElement* element)
+    IElement* Registry::find(const std::string& name) const
     {
-        IElement::MemberElementCollection::const_iterator it = element->meta.find("id");
+        return find(ElementName::Find(name));
+    }
 
-        if (it == element->meta.end()) {
-            throw LogicError("Element has no ID");
+    IElement* Registry::find(const ElementName& name) const
+    {
+        Map::const_iterator i = registrated.find(name);
+
+        if (i == registrated.end()) {
+            return NULL;
         }
 
-        std::string id = getElementId(element);
+        return i->second.element;
+    }
+
+    IElement* Registry::root(const std::string& name) const
+    {
+        return root(ElementName::Find(name));
+    }
 
-        if (isReserved(id)) {
+    IElement* Registry::root(const ElementName& name) const
+    {
+        const Entry* entry = resolve(name);
+        return entry ? entry->root : NULL;
+    }
+
+    size_t Registry::depth(const ElementName& name) const
+    {
+        const Entry* entry = resolve(name);
+        return entry ? entry->depth : 0;
+    }
+
+    bool Registry::add(IElement* element)
+    {
+        const ElementName id(getElementId(element));
+
+        if (id.reserved()) {
             throw LogicError("You can not register a basic element");
         }
 
-        if (find(id)) {
+        if (!registrated.emplace(id, Entry(element)).second) {
             // there is already already element with given name
             return false;
         }
 
-        registrated[id] = element;
+        ++generation;
         return true;
     }
 
     bool Registry::remove(const std::string& name)
     {
-        Map::iterator i = registrated.find(name);
+        Map::iterator i = registrated.find(ElementName::Find(name));
 
         if (i == registrated.end()) {
             return false;
         }
 
         registrated.erase(i);
+        ++generation;
         return true;
     }
 
-    template <typename T>
-    static void DeleteSecond(T& pair)
-    {
-        delete pair.second;
-    }
-
     void Registry::clearAll(bool releaseElements)
     {
         if (releaseElements) {
-            std::for_each(registrated.begin(), registrated.end(), DeleteSecond<Map::value_type>);
+            for (Map::iterator i = registrated.begin(); i != registrated.end(); ++i) {
+                delete i->second.element;
+            }
         }
 
         registrated.clear();
+        ++generation;
     }
 
 }; // namespace refract
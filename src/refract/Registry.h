@@ -8,8 +8,13 @@
 #ifndef REFRACT_REGISTRY_H
 #define REFRACT_REGISTRY_H
 
-#include <map>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+
+#include "ElementName.h"
 
 namespace refract
 {
@@ -19,16 +24,57 @@ namespace refract
 
     class Registry
     {
-        // FIXME: potentionally dangerous,
-        // if element is deleted and not removed from registry
-        // solution: std::shared_ptr<> || std::weak_ptr<>
-        typedef std::map<std::string, IElement*> Map;
+        struct Entry {
+            // FIXME: potentionally dangerous,
+            // if element is deleted and not removed from registry
+            // solution: std::shared_ptr<> || std::weak_ptr<>
+            IElement* element;
+
+            /// generation of registry the ancestry below was resolved in, 0 if not resolved yet,
+            /// stored after the ancestry so lookups of resolved entries need no lock
+            mutable std::atomic<size_t> generation;
+
+            /// the last registered element of inheritance chain, \see root()
+            mutable IElement* root;
+
+            /// number of registered ancestors, \see depth()
+            mutable size_t depth;
+
+            explicit Entry(IElement* element) : element(element), generation(0), root(NULL), depth(0)
+            {
+            }
+
+            Entry(const Entry& other)
+                : element(other.element), generation(other.generation.load()), root(other.root), depth(other.depth)
+            {
+            }
+        };
+
+        typedef std::unordered_map<ElementName, Entry, ElementName::Hash> Map;
         Map registrated;
 
+        /// bumped on every change of registrated elements, invalidates resolved ancestry of all entries
+        size_t generation;
+
+        /// guards resolving ancestry of entries,
+        /// elements are looked up concurrently while registration is done by a single thread
+        mutable std::mutex ancestryMutex;
+
         std::string getElementId(IElement* element);
+        const Entry* resolve(const ElementName& name) const;
 
     public:
+        Registry();
+
         IElement* find(const std::string& name) const;
+        IElement* find(const ElementName& name) const;
+
+        /// the last registered element of inheritance chain of `name`, \see FindRootAncestor
+        IElement* root(const std::string& name) const;
+        IElement* root(const ElementName& name) const;
+
+        /// number of registered ancestors of `name`, 0 if it inherits a base element directly or is not registered
+        size_t depth(const ElementName& name) const;
 
         bool add(IElement* element);
         bool remove(const std::string& name);
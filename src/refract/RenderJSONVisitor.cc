@@ -8,8 +8,9 @@
 
 #include "VisitorUtils.h"
 #include "sosJSON.h"
-#include <sstream>
+#include <ostream>
 #include "SerializeCompactVisitor.h"
+#include "Budget.h"
 
 #include "RenderJSONVisitor.h"
 
@@ -198,14 +199,17 @@ namespace refract
 
         if (result) {
             sos::SerializeJSON serializer;
-            std::stringstream ss;
+
+            // the budget is charged while the body is written
+            RenderBuffer buffer;
+            std::ostream os(&buffer);
+            os.exceptions(std::ios::badbit);
 
             // FIXME: remove SosSerializeCompactVisitor dependency
             SosSerializeCompactVisitor s;
             VisitBy(*result, s);
-            serializer.process(s.value(), ss);
-
-            return ss.str();
+            serializer.process(s.value(), os);
+            out = buffer.str();
         }
 
         return out;
@@ -0,0 +1,321 @@
+//
+//  refract/StructuralHash.cc
+//  librefract
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#include "StructuralHash.h"
+
+#include <functional>
+#include <string>
+
+#include "Element.h"
+#include "ComparableVisitor.h"
+#include "TypeQueryVisitor.h"
+#include "Visitor.h"
+
+namespace refract
+{
+
+    namespace
+    {
+
+        const std::string SourceMapKey = "sourceMap";
+
+        inline void Combine(size_t& seed, size_t hash)
+        {
+            seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+
+        bool IsSourceMap(const MemberElement& member)
+        {
+            if (!member.value.first) {
+                return false;
+            }
+
+            ComparableVisitor v(SourceMapKey);
+            VisitBy(*member.value.first, v);
+
+            return v.get();
+        }
+
+        TypeQueryVisitor::ElementType TypeOf(const IElement& e)
+        {
+            TypeQueryVisitor v;
+            VisitBy(e, v);
+
+            return v.get();
+        }
+
+        /**
+         * Hashes of values of the particular element types
+         */
+        struct ValueHash {
+            StructuralHash& hash;
+
+            explicit ValueHash(StructuralHash& hash) : hash(hash)
+            {
+            }
+
+            size_t operator()(const NullElementTrait::ValueType&) const
+            {
+                return 0;
+            }
+
+            size_t operator()(const std::string& value) const
+            {
+                return std::hash<std::string>()(value);
+            }
+
+            size_t operator()(double value) const
+            {
+                return std::hash<double>()(value);
+            }
+
+            size_t operator()(bool value) const
+            {
+                return std::hash<bool>()(value);
+            }
+
+            size_t operator()(const IElement* value) const
+            {
+                return hash(value);
+            }
+
+            size_t operator()(const MemberElementTrait::ValueType& value) const
+            {
+                size_t seed = hash(value.first);
+                Combine(seed, hash(value.second));
+                return seed;
+            }
+
+            template <typename T>
+            size_t operator()(const std::vector<T*>& values) const
+            {
+                size_t seed = values.size();
+
+                for (typename std::vector<T*>::const_iterator it = values.begin(); it != values.end(); ++it) {
+                    Combine(seed, hash(*it));
+                }
+
+                return seed;
+            }
+        };
+
+        /**
+         * Equality of values of the particular element types
+         */
+        struct ValueEqual {
+            StructuralHash& hash;
+
+            explicit ValueEqual(StructuralHash& hash) : hash(hash)
+            {
+            }
+
+            template <typename T>
+            bool operator()(const T& first, const T& second) const
+            {
+                return first == second;
+            }
+
+            bool operator()(const NullElementTrait::ValueType&, const NullElementTrait::ValueType&) const
+            {
+                return true;
+            }
+
+            bool operator()(const IElement* first, const IElement* second) const
+            {
+                return hash.equal(first, second);
+            }
+
+            bool operator()(
+                const MemberElementTrait::ValueType& first, const MemberElementTrait::ValueType& second) const
+            {
+                return hash.equal(first.first, second.first) && hash.equal(first.second, second.second);
+            }
+
+            template <typename T>
+            bool operator()(const std::vector<T*>& first, const std::vector<T*>& second) const
+            {
+                if (first.size() != second.size()) {
+                    return false;
+                }
+
+                for (size_t i = 0; i < first.size(); ++i) {
+                    if (!hash.equal(first[i], second[i])) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+        };
+
+        size_t CollectionHash(const IElement::MemberElementCollection& collection, StructuralHash& hash)
+        {
+            size_t seed = 0;
+
+            for (IElement::MemberElementCollection::const_iterator it = collection.begin(); it != collection.end();
+                 ++it) {
+                if (hash.ignoresSourceMaps() && IsSourceMap(**it)) {
+                    continue;
+                }
+
+                Combine(seed, hash(*it));
+            }
+
+            return seed;
+        }
+
+        bool CollectionEqual(const IElement::MemberElementCollection& first,
+            const IElement::MemberElementCollection& second,
+            StructuralHash& hash)
+        {
+            IElement::MemberElementCollection::const_iterator i = first.begin();
+            IElement::MemberElementCollection::const_iterator j = second.begin();
+
+            while (true) {
+                if (hash.ignoresSourceMaps()) {
+                    while (i != first.end() && IsSourceMap(**i)) {
+                        ++i;
+                    }
+
+                    while (j != second.end() && IsSourceMap(**j)) {
+                        ++j;
+                    }
+                }
+
+                if (i == first.end() || j == second.end()) {
+                    return i == first.end() && j == second.end();
+                }
+
+                if (!hash.equal(*i, *j)) {
+                    return false;
+                }
+
+                ++i;
+                ++j;
+            }
+        }
+
+        /**
+         * Computes hash of visited element, its children are hashed through `hash`
+         */
+        struct HashVisitor {
+            StructuralHash& hash;
+            size_t result;
+
+            explicit HashVisitor(StructuralHash& hash) : hash(hash), result(0)
+            {
+            }
+
+            void operator()(const IElement&)
+            {
+            }
+
+            template <typename T>
+            void operator()(const T& e)
+            {
+                result = std::hash<std::string>()(T::TraitType::element().str());
+                Combine(result, std::hash<std::string>()(e.element()));
+                Combine(result, e.empty());
+                Combine(result, CollectionHash(e.meta, hash));
+                Combine(result, CollectionHash(e.attributes, hash));
+                Combine(result, ValueHash(hash)(e.value));
+            }
+        };
+
+        /**
+         * Compares visited element with `other` of the same type
+         */
+        struct EqualVisitor {
+            StructuralHash& hash;
+            const IElement& other;
+            bool result;
+
+            EqualVisitor(StructuralHash& hash, const IElement& other) : hash(hash), other(other), result(false)
+            {
+            }
+
+            void operator()(const IElement&)
+            {
+            }
+
+            template <typename T>
+            void operator()(const T& e)
+            {
+                const T& o = static_cast<const T&>(other);
+
+                result = e.name() == o.name() && e.empty() == o.empty()
+                    && CollectionEqual(e.meta, o.meta, hash) && CollectionEqual(e.attributes, o.attributes, hash)
+                    && ValueEqual(hash)(e.value, o.value);
+            }
+        };
+    }
+
+    StructuralHash::StructuralHash(bool ignoreSourceMaps) : ignoreSourceMaps(ignoreSourceMaps)
+    {
+    }
+
+    size_t StructuralHash::operator()(const IElement* e)
+    {
+        if (!e) {
+            return 0;
+        }
+
+        return (*this)(*e);
+    }
+
+    size_t StructuralHash::operator()(const IElement& e)
+    {
+        std::unordered_map<const IElement*, size_t>::const_iterator found = hashes.find(&e);
+
+        if (found != hashes.end()) {
+            return found->second;
+        }
+
+        HashVisitor visitor(*this);
+        VisitBy(e, visitor);
+
+        hashes[&e] = visitor.result;
+
+        return visitor.result;
+    }
+
+    bool StructuralHash::equal(const IElement* first, const IElement* second)
+    {
+        if (first == second) {
+            return true;
+        }
+
+        if (!first || !second) {
+            return false;
+        }
+
+        if ((*this)(*first) != (*this)(*second)) {
+            return false;
+        }
+
+        if (TypeOf(*first) != TypeOf(*second)) {
+            return false;
+        }
+
+        EqualVisitor visitor(*this, *second);
+        VisitBy(*first, visitor);
+
+        return visitor.result;
+    }
+
+    void StructuralHash::clear()
+    {
+        hashes.clear();
+    }
+
+    bool StructurallyEqual(const IElement& first, const IElement& second, bool ignoreSourceMaps)
+    {
+        StructuralHash hash(ignoreSourceMaps);
+        return hash.equal(&first, &second);
+    }
+
+}; // namespace refract
@@ -0,0 +1,63 @@
+//
+//  refract/StructuralHash.h
+//  librefract
+//
+//  Created by Apiary Inc. on 19/10/26.
+//  Copyright (c) 2026 Apiary Inc. All rights reserved.
+//
+#ifndef REFRACT_STRUCTURALHASH_H
+#define REFRACT_STRUCTURALHASH_H
+
+#include <cstddef>
+#include <unordered_map>
+
+#include "ElementFwd.h"
+
+namespace refract
+{
+
+    /**
+     * Structural hash and deep equality of refract elements
+     *
+     * Hash of an element covers its type, name, meta, attributes and value
+     * and is computed bottom-up from hashes of its children. Hashes are
+     * memoized per element, so once a tree is hashed, hash of any of its
+     * subtrees costs a lookup. Memoized hashes are valid as long as the
+     * hashed elements are neither modified nor released, \see clear().
+     */
+    class StructuralHash
+    {
+    public:
+        /**
+         * \param ignoreSourceMaps Leave `sourceMap` attributes out of hashes and comparisons
+         */
+        explicit StructuralHash(bool ignoreSourceMaps = false);
+
+        /// hash of element, NULL has hash too
+        size_t operator()(const IElement* e);
+        size_t operator()(const IElement& e);
+
+        /// deep equality of elements, elements of different hash are not compared
+        bool equal(const IElement* first, const IElement* second);
+
+        /// forget memoized hashes
+        void clear();
+
+        bool ignoresSourceMaps() const
+        {
+            return ignoreSourceMaps;
+        }
+
+    private:
+        const bool ignoreSourceMaps;
+        std::unordered_map<const IElement*, size_t> hashes;
+    };
+
+    /**
+     * Deep equality of elements, using structural hash of their subtrees
+     */
+    bool StructurallyEqual(const IElement& first, const IElement& second, bool ignoreSourceMaps = false);
+
+}; // namespace refract
+
+#endif // #ifndef REFRACT_STRUCTURALHASH_H
@@ -12,12 +12,11 @@
 #include <iostream>
 
 #include "refract/Element.h"
-#include "refract/FilterVisitor.h"
-#include "refract/Query.h"
-#include "refract/Iterate.h"
+#include "refract/PathQuery.h"
 #include "refract/TypeQueryVisitor.h"
 
 #include "refract/VisitorUtils.h"
+#include "snowcrash.h"
 
 namespace sc = snowcrash;
 
@@ -89,6 +88,7 @@ void GetLinesEndIndex(const std::string& source, std::vector<size_t>& out)
 
 void PrintAnnotation(const std::string& prefix,
     const snowcrash::SourceAnnotation& annotation,
+    const mdp::CharactersRangeSet& location,
     const std::string& source,
     const bool useLineNumbers)
 {
@@ -109,10 +109,9 @@ void PrintAnnotation(const std::string& prefix,
         GetLinesEndIndex(source, linesEndIndex);
     }
 
-    if (!annotation.location.empty()) {
+    if (!location.empty()) {
 
-        for (mdp::CharactersRangeSet::const_iterator it = annotation.location.begin(); it != annotation.location.end();
-             ++it) {
+        for (mdp::CharactersRangeSet::const_iterator it = location.begin(); it != location.end(); ++it) {
 
             if (useLineNumbers) {
 
@@ -123,7 +122,7 @@ void PrintAnnotation(const std::string& prefix,
                 std::cerr << " - line " << annotationPosition.toLine << ", column " << annotationPosition.toColumn;
             } else {
 
-                std::cerr << ((it == annotation.location.begin()) ? " :" : ";");
+                std::cerr << ((it == location.begin()) ? " :" : ";");
                 std::cerr << it->location << ":" << it->length;
             }
         }
@@ -141,16 +140,19 @@ void PrintAnnotation(const std::string& prefix,
 void PrintReport(const snowcrash::Report& report, const std::string& source, const bool isUseLineNumbers)
 {
 
+    // annotations of the parser are located by bytes
+    const std::vector<mdp::CharactersRangeSet> locations = snowcrash::locateAnnotations(report, source);
+
     std::cerr << std::endl;
 
     if (report.error.code == sc::Error::OK) {
         std::cerr << "OK.\n";
     } else {
-        PrintAnnotation("error:", report.error, source, isUseLineNumbers);
+        PrintAnnotation("error:", report.error, locations[0], source, isUseLineNumbers);
     }
 
-    for (snowcrash::Warnings::const_iterator it = report.warnings.begin(); it != report.warnings.end(); ++it) {
-        PrintAnnotation("warning:", *it, source, isUseLineNumbers);
+    for (size_t i = 0; i < report.warnings.size(); ++i) {
+        PrintAnnotation("warning:", report.warnings[i], locations[i + 1], source, isUseLineNumbers);
     }
 }
 
@@ -238,22 +240,24 @@ struct AnnotationToString {
     }
 };
 
-void PrintReport(const drafter_result* result, const std::string& source, const bool useLineNumbers, const int error)
+void PrintReport(const drafter_result* result,
+    const std::string& source,
+    const bool useLineNumbers,
+    const int error,
+    std::ostream& stream)
 {
-    std::cerr << std::endl;
+    stream << std::endl;
 
-    refract::FilterVisitor filter(refract::query::Element("annotation"));
-    refract::Iterate<refract::Children> iterate(filter);
-    iterate(*result);
+    const refract::query::Elements annotations = refract::query::Path("annotation").select(*result);
 
     refract::RefractElements elements;
 
     if (error == sc::Error::OK) {
-        std::cerr << "OK.\n";
+        stream << "OK.\n";
     }
 
-    std::transform(filter.elements().begin(),
-        filter.elements().end(),
-        std::ostream_iterator<std::string>(std::cerr, "\n"),
+    std::transform(annotations.begin(),
+        annotations.end(),
+        std::ostream_iterator<std::string>(stream, "\n"),
         AnnotationToString(source, useLineNumbers));
 }
@@ -9,13 +9,15 @@
 #ifndef DRAFTER_REPORTING_H
 #define DRAFTER_REPORTING_H
 
+#include <iostream>
+
 #include "drafter.h"
 #include "SourceAnnotation.h"
 
 /**
  *  \brief Print parser report to stderr.
  *
- *  \param report A parser report to print
+ *  \param report A parser report to print, annotations located by bytes
  *  \param source Source data
  *  \param useLineNumbers True if the annotations needs to be printed by line and column number
  */
@@ -28,7 +30,12 @@ void PrintReport(const snowcrash::Report& report, const std::string& source, con
  *  \param source Source data
  *  \param useLineNumbers True if the annotations needs to be printed by line and column number
  *  \param error - code form parsing
+ *  \param stream Stream to print the report into
  */
-void PrintReport(const drafter_result*, const std::string& source, const bool useLineNumbers, const int error);
+void PrintReport(const drafter_result*,
+    const std::string& source,
+    const bool useLineNumbers,
+    const int error,
+    std::ostream& stream = std::cerr);
 
 #endif // #ifndef DRAFTER_REPORTING_H
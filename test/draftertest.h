@@ -38,6 +38,24 @@
             &FixtureHelper::parseAndSerialize, "test/fixtures/" category "/" name, drafter::WrapperOptions(true));     \
     }
 
+#define TEST_REFRACT_PARALLEL(category, name)                                                                          \
+    TEST_CASE("Testing parallel refract serialization for " category " " name,                                         \
+        "[refract_parallel][" category "][" name "]")                                                                  \
+    {                                                                                                                  \
+        FixtureHelper::handleResultJSON(&FixtureHelper::parseAndSerialize,                                             \
+            "test/fixtures/" category "/" name,                                                                        \
+            drafter::WrapperOptions(false, false, true));                                                              \
+    }
+
+#define TEST_REFRACT_SOURCE_MAP_PARALLEL(category, name)                                                               \
+    TEST_CASE("Testing parallel refract + source map serialization for " category " " name,                            \
+        "[refract_sourcemap_parallel][" category "][" name "]")                                                        \
+    {                                                                                                                  \
+        FixtureHelper::handleResultJSON(&FixtureHelper::parseAndSerialize,                                             \
+            "test/fixtures/" category "/" name,                                                                        \
+            drafter::WrapperOptions(true, false, true));                                                               \
+    }
+
 namespace draftertest
 {
     namespace ext
@@ -105,12 +123,13 @@ namespace draftertest
 
     struct FixtureHelper {
 
-        static sos::Object parseAndSerialize(
-            snowcrash::ParseResult<snowcrash::Blueprint>& blueprint, const drafter::WrapperOptions& options)
+        static sos::Object parseAndSerialize(snowcrash::ParseResult<snowcrash::Blueprint>& blueprint,
+            const mdp::ByteBuffer& source,
+            const drafter::WrapperOptions& options)
         {
             drafter::ConversionContext context(options);
 
-            refract::IElement* parseResult = WrapRefract(blueprint, context);
+            refract::IElement* parseResult = WrapRefract(blueprint, source, context);
             sos::Object result = SerializeRefract(parseResult, context);
 
             if (parseResult) {
@@ -159,8 +178,9 @@ namespace draftertest
             return ext::json;
         }
 
-        typedef sos::Object (*Wrapper)(
-            snowcrash::ParseResult<snowcrash::Blueprint>& blueprint, const drafter::WrapperOptions& options);
+        typedef sos::Object (*Wrapper)(snowcrash::ParseResult<snowcrash::Blueprint>& blueprint,
+            const mdp::ByteBuffer& source,
+            const drafter::WrapperOptions& options);
 
         static bool handleResultJSON(const Wrapper wrapper,
             const std::string& basepath,
@@ -171,12 +191,13 @@ namespace draftertest
 
             snowcrash::ParseResult<snowcrash::Blueprint> blueprint;
 
-            int result = snowcrash::parse(fixture.get(ext::apib), snowcrash::ExportSourcemapOption, blueprint);
+            const mdp::ByteBuffer source = fixture.get(ext::apib);
+            int result = snowcrash::parse(source, snowcrash::ExportSourcemapOption, blueprint);
 
             std::stringstream outStream;
             sos::SerializeJSON serializer;
 
-            serializer.process((*wrapper)(blueprint, options), outStream);
+            serializer.process((*wrapper)(blueprint, source, options), outStream);
             outStream << "\n";
 
             std::string actual = outStream.str();
@@ -0,0 +1,134 @@
+#include "catch.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include "Allocator.h"
+#include "Element.h"
+
+using namespace refract;
+
+namespace
+{
+    struct Counter {
+        size_t allocated;
+        size_t released;
+    };
+
+    void* CountedAllocate(size_t size, void* ctx)
+    {
+        static_cast<Counter*>(ctx)->allocated++;
+        return std::malloc(size);
+    }
+
+    void CountedDeallocate(void* ptr, void* ctx)
+    {
+        static_cast<Counter*>(ctx)->released++;
+        std::free(ptr);
+    }
+
+    Allocator CountingAllocator(Counter& counter)
+    {
+        Allocator allocator = { &CountedAllocate, NULL, &CountedDeallocate, &counter };
+        return allocator;
+    }
+}
+
+TEST_CASE("Elements are allocated by the current allocator", "[refract][Allocator]")
+{
+    Counter counter = { 0, 0 };
+    const Allocator allocator = CountingAllocator(counter);
+
+    std::unique_ptr<IElement> outside(IElement::Create("outside"));
+    std::unique_ptr<ObjectElement> object;
+
+    {
+        ScopedAllocator scoped(&allocator);
+
+        object.reset(new ObjectElement);
+        object->push_back(new MemberElement("key", IElement::Create("value")));
+    }
+
+    // object, member, its key and value
+    REQUIRE(counter.allocated == 4);
+    REQUIRE(counter.released == 0);
+    REQUIRE(object->hasHeader());
+    REQUIRE(AllocatorOf(*object).ctx == &counter);
+
+    // elements of the default allocator have no header
+    REQUIRE_FALSE(outside->hasHeader());
+    REQUIRE(IsDefault(AllocatorOf(*outside)));
+
+    // released by the allocator it was allocated by
+    object.reset();
+
+    REQUIRE(counter.released == 4);
+}
+
+TEST_CASE("Scoped allocators are nested", "[refract][Allocator]")
+{
+    Counter outer = { 0, 0 };
+    Counter inner = { 0, 0 };
+    const Allocator outerAllocator = CountingAllocator(outer);
+    const Allocator innerAllocator = CountingAllocator(inner);
+
+    ScopedAllocator scoped(&outerAllocator);
+
+    {
+        ScopedAllocator nested(&innerAllocator);
+        ScopedAllocator kept(NULL);
+
+        Deallocate(Allocate(8));
+    }
+
+    Deallocate(Allocate(8));
+
+    REQUIRE(inner.allocated == 1);
+    REQUIRE(inner.released == 1);
+    REQUIRE(outer.allocated == 1);
+    REQUIRE(outer.released == 1);
+}
+
+TEST_CASE("Memory is reallocated without reallocate of the allocator", "[refract][Allocator]")
+{
+    Counter counter = { 0, 0 };
+    const Allocator allocator = CountingAllocator(counter);
+
+    char* buffer = NULL;
+
+    {
+        ScopedAllocator scoped(&allocator);
+        buffer = static_cast<char*>(Allocate(4));
+    }
+
+    std::memcpy(buffer, "abc", 4);
+
+    buffer = static_cast<char*>(Reallocate(buffer, 1024));
+    REQUIRE(std::strcmp(buffer, "abc") == 0);
+
+    buffer = static_cast<char*>(Reallocate(buffer, 2));
+    REQUIRE(std::strncmp(buffer, "ab", 2) == 0);
+
+    Deallocate(buffer);
+
+    REQUIRE(counter.allocated == 3);
+    REQUIRE(counter.released == 3);
+}
+
+TEST_CASE("Global allocator is used without a scoped one", "[refract][Allocator]")
+{
+    Counter counter = { 0, 0 };
+    const Allocator allocator = CountingAllocator(counter);
+
+    SetGlobalAllocator(&allocator);
+    std::unique_ptr<IElement> element(IElement::Create("global"));
+    SetGlobalAllocator(NULL);
+
+    REQUIRE(IsDefault(CurrentAllocator()));
+    REQUIRE(element->hasHeader());
+    REQUIRE(counter.allocated == 1);
+
+    element.reset();
+    REQUIRE(counter.released == 1);
+}
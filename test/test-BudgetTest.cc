@@ -0,0 +1,303 @@
+#include "catch.hpp"
+
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "Budget.h"
+#include "Element.h"
+#include "ExpandVisitor.h"
+#include "MarkdownNode.h"
+#include "Registry.h"
+#include "SourceAnnotation.h"
+
+using namespace refract;
+
+namespace
+{
+    Limits MakeLimits(size_t elements, size_t expansionDepth, size_t outputSize, size_t time)
+    {
+        Limits limits = { elements, expansionDepth, outputSize, time };
+        return limits;
+    }
+
+    typedef std::vector<std::pair<ParseStage, unsigned> > Reports;
+
+    /// document of `count` top-level paragraphs, the first one with a nested paragraph
+    void MakeDocument(mdp::MarkdownNode& root, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            root.children().push_back(mdp::MarkdownNode(mdp::ParagraphMarkdownNodeType, &root));
+        }
+
+        mdp::MarkdownNode& first = root.children().front();
+        first.children().push_back(mdp::MarkdownNode(mdp::ParagraphMarkdownNodeType, &first));
+    }
+
+    /// allocate `count` elements into `elements`
+    void AllocateElements(std::vector<std::unique_ptr<IElement> >& elements, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            elements.emplace_back(new NumberElement(i));
+        }
+    }
+}
+
+TEST_CASE("Elements are counted by the current budget", "[refract][Budget]")
+{
+    Budget budget(MakeLimits(2, 0, 0, 0));
+
+    {
+        ScopedBudget scoped(&budget);
+        REQUIRE(CurrentBudget() == &budget);
+
+        std::vector<std::unique_ptr<IElement> > elements;
+        AllocateElements(elements, 2);
+        REQUIRE_NOTHROW(budget.poll(ConversionStage));
+
+        // exceeding the limit is reported by the next poll, not by the allocation
+        REQUIRE_NOTHROW(AllocateElements(elements, 1));
+        REQUIRE(elements.size() == 3);
+        REQUIRE_THROWS_AS(budget.poll(ConversionStage), LimitExceeded);
+        REQUIRE_THROWS_AS(budget.expand(1), LimitExceeded);
+    }
+
+    REQUIRE(CurrentBudget() == NULL);
+
+    std::unique_ptr<IElement> outside(new StringElement("outside"));
+    REQUIRE(outside.get() != NULL);
+}
+
+TEST_CASE("Budget without limits does not throw", "[refract][Budget]")
+{
+    Budget budget(MakeLimits(0, 0, 0, 0));
+
+    for (size_t i = 0; i < 1000; ++i) {
+        budget.allocate();
+    }
+
+    REQUIRE_NOTHROW(budget.expand(1000));
+    REQUIRE_NOTHROW(budget.render(1000000));
+
+    mdp::MarkdownNode root;
+    MakeDocument(root, 1);
+    REQUIRE_NOTHROW(budget.check(root.children().begin(), root.children()));
+}
+
+TEST_CASE("Budget limits expansion depth and rendered output", "[refract][Budget]")
+{
+    Budget budget(MakeLimits(0, 3, 10, 0));
+
+    REQUIRE_NOTHROW(budget.expand(3));
+    REQUIRE_THROWS_AS(budget.expand(4), LimitExceeded);
+
+    REQUIRE_NOTHROW(budget.render(6));
+    REQUIRE_THROWS_AS(budget.render(6), LimitExceeded);
+}
+
+TEST_CASE("Render is charged while it is written", "[refract][Budget]")
+{
+    Budget budget(MakeLimits(0, 0, 10000, 0));
+    ScopedBudget scoped(&budget);
+
+    {
+        RenderBuffer buffer;
+        std::ostream os(&buffer);
+        os.exceptions(std::ios::badbit);
+
+        os << std::string(6000, 'a');
+        REQUIRE(buffer.str() == std::string(6000, 'a'));
+    }
+
+    RenderBuffer buffer;
+    std::ostream os(&buffer);
+    os.exceptions(std::ios::badbit);
+
+    // the limit is exceeded before the whole output is written
+    REQUIRE_THROWS_AS(os << std::string(100000, 'b'), LimitExceeded);
+    REQUIRE(buffer.str().size() < 10000);
+}
+
+TEST_CASE("Exceeded time is reported to the parser as a limit error", "[refract][Budget]")
+{
+    Budget budget(MakeLimits(0, 0, 0, 1));
+
+    const std::chrono::steady_clock::time_point until = std::chrono::steady_clock::now() + std::chrono::milliseconds(5);
+    while (std::chrono::steady_clock::now() < until) {
+    }
+
+    REQUIRE_THROWS_AS(budget.checkTime(), LimitExceeded);
+
+    mdp::MarkdownNode root;
+    MakeDocument(root, 1);
+
+    try {
+        budget.check(root.children().begin(), root.children());
+        FAIL("time limit has not been reported");
+    } catch (const snowcrash::Error& e) {
+        REQUIRE(e.code == snowcrash::LimitError);
+    }
+}
+
+TEST_CASE("Cancelled parse stops at the next poll", "[refract][Budget]")
+{
+    std::atomic<bool> cancelled(false);
+    Budget budget(MakeLimits(0, 0, 0, 0), &cancelled);
+
+    REQUIRE_NOTHROW(budget.poll(ConversionStage));
+
+    cancelled = true;
+
+    REQUIRE_THROWS_AS(budget.poll(ConversionStage), ParseCancelled);
+    REQUIRE_THROWS_AS(budget.expand(1), ParseCancelled);
+    REQUIRE_THROWS_AS(budget.render(1), ParseCancelled);
+
+    ScopedBudget scoped(&budget);
+    std::vector<std::unique_ptr<IElement> > elements;
+
+    // allocations do not poll
+    REQUIRE_NOTHROW(AllocateElements(elements, 1000));
+}
+
+TEST_CASE("Cancelled parse is reported to the parser as a cancel error", "[refract][Budget]")
+{
+    std::atomic<bool> cancelled(true);
+    Budget budget(MakeLimits(0, 0, 0, 0), &cancelled);
+
+    mdp::MarkdownNode root;
+    MakeDocument(root, 1);
+
+    try {
+        budget.check(root.children().begin(), root.children());
+        FAIL("cancellation has not been reported");
+    } catch (const snowcrash::Error& e) {
+        REQUIRE(e.code == snowcrash::CancelledError);
+    }
+}
+
+TEST_CASE("Parser reports percent of top-level sections", "[refract][Budget]")
+{
+    Reports reports;
+    Budget budget(MakeLimits(0, 0, 0, 0), NULL, [&reports](ParseStage stage, unsigned percent) {
+        reports.push_back(std::make_pair(stage, percent));
+    });
+
+    mdp::MarkdownNode root;
+    MakeDocument(root, 4);
+
+    mdp::MarkdownNodes& sections = root.children();
+
+    budget.check(sections.begin(), sections);
+    budget.check(sections.front().children().begin(), sections.front().children());
+    budget.check(sections.begin() + 1, sections);
+    budget.check(sections.begin() + 3, sections);
+
+    Reports expected;
+    expected.push_back(std::make_pair(ParsingStage, 0u));
+    expected.push_back(std::make_pair(ParsingStage, 25u));
+    expected.push_back(std::make_pair(ParsingStage, 75u));
+
+    REQUIRE(reports == expected);
+}
+
+TEST_CASE("Progress of a stage is reported when its percent goes up", "[refract][Budget]")
+{
+    Reports reports;
+    Budget budget(MakeLimits(0, 0, 0, 0), NULL, [&reports](ParseStage stage, unsigned percent) {
+        reports.push_back(std::make_pair(stage, percent));
+    });
+
+    budget.poll(ParsingStage, 0, 4);
+    budget.poll(ParsingStage);
+    budget.poll(ParsingStage, 2, 4);
+    budget.poll(ParsingStage, 1, 4);
+    budget.poll(ConversionStage, 0, 2);
+    budget.poll(ConversionStage, 1, 2);
+    budget.expand(1);
+    budget.expand(2);
+    budget.render(10);
+    budget.poll(ConversionStage);
+    budget.expand(1);
+    budget.poll(ConversionStage, 2, 2);
+    budget.expand(1);
+
+    Reports expected;
+    expected.push_back(std::make_pair(ParsingStage, 0u));
+    expected.push_back(std::make_pair(ParsingStage, 50u));
+    expected.push_back(std::make_pair(ConversionStage, 0u));
+    expected.push_back(std::make_pair(ConversionStage, 50u));
+    expected.push_back(std::make_pair(ExpansionStage, 50u));
+    expected.push_back(std::make_pair(RenderingStage, 50u));
+    expected.push_back(std::make_pair(ConversionStage, 100u));
+    expected.push_back(std::make_pair(ExpansionStage, 100u));
+
+    REQUIRE(reports == expected);
+}
+
+TEST_CASE("Progress callback may poll the budget", "[refract][Budget]")
+{
+    Reports reports;
+    Budget* polled = NULL;
+    Budget budget(MakeLimits(0, 0, 0, 0), NULL, [&reports, &polled](ParseStage stage, unsigned percent) {
+        reports.push_back(std::make_pair(stage, percent));
+
+        if (stage == ConversionStage) {
+            polled->expand(1);
+        }
+    });
+    polled = &budget;
+
+    budget.poll(ConversionStage, 1, 4);
+
+    // the report of the nested poll is delivered after the one in progress
+    Reports expected;
+    expected.push_back(std::make_pair(ConversionStage, 25u));
+    expected.push_back(std::make_pair(ExpansionStage, 25u));
+
+    REQUIRE(reports == expected);
+}
+
+TEST_CASE("Expansion cancelled by the budget releases the partial tree", "[refract][Budget]")
+{
+    Registry registry;
+
+    ObjectElement* base = new ObjectElement;
+    base->element("object");
+    base->meta["id"] = IElement::Create("BudgetBase");
+    REQUIRE(registry.add(base));
+
+    ObjectElement root;
+
+    for (size_t i = 0; i < 3; ++i) {
+        ObjectElement* value = new ObjectElement;
+        value->element("BudgetBase");
+        root.push_back(new MemberElement("member", value));
+    }
+
+    {
+        ExpandVisitor expander(registry);
+        Visit(expander, root);
+
+        std::unique_ptr<IElement> expanded(expander.get());
+        REQUIRE(expanded.get() != NULL);
+    }
+
+    // the first member is expanded by the time the cancellation is polled,
+    // it is released with the rest of the partial tree (run under LeakSanitizer)
+    std::atomic<bool> cancelled(false);
+    Budget budget(MakeLimits(0, 0, 0, 0), &cancelled, [&cancelled](ParseStage stage, unsigned) {
+        if (stage == ExpansionStage) {
+            cancelled = true;
+        }
+    });
+
+    {
+        ScopedBudget scoped(&budget);
+        ExpandVisitor expander(registry);
+
+        REQUIRE_THROWS_AS(Visit(expander, root), ParseCancelled);
+    }
+
+    registry.clearAll(true);
+}
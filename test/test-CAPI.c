@@ -60,6 +60,201 @@ int test_parse_to_string() {
     return 0;
 };
 
+typedef struct {
+    char* data;
+    size_t size;
+    int chunks;
+} output_buffer;
+
+int write_output(const char* data, size_t size, void* ctx) {
+    output_buffer* out = (output_buffer*)ctx;
+
+    out->data = (char*)realloc(out->data, out->size + size + 1);
+    memcpy(out->data + out->size, data, size);
+    out->size += size;
+    out->data[out->size] = '\0';
+    out->chunks++;
+
+    return 0;
+}
+
+int fail_output(const char* data, size_t size, void* ctx) {
+    return 1;
+}
+
+int test_serialize_chunked() {
+    drafter_result* result = NULL;
+    drafter_parse_options parseOptions = {false};
+
+    int status = drafter_parse_blueprint(source, &result, parseOptions);
+    assert(status == 0);
+    assert(result);
+
+    drafter_serialize_options serializeOptions;
+    serializeOptions.sourcemap = true;
+    serializeOptions.format = DRAFTER_SERIALIZE_JSON;
+
+    char* expected_out = drafter_serialize(result, serializeOptions);
+    assert(expected_out);
+
+    output_buffer out = { NULL, 0, 0 };
+
+    assert(drafter_serialize_chunked(result, serializeOptions, write_output, &out) == DRAFTER_OK);
+    assert(out.data);
+    assert(out.chunks >= 1);
+    assert(strcmp(out.data, expected_out) == 0);
+
+    assert(drafter_serialize_chunked(result, serializeOptions, fail_output, NULL) == DRAFTER_EINVALID_OUTPUT);
+    assert(drafter_serialize_chunked(result, serializeOptions, NULL, NULL) == DRAFTER_EINVALID_OUTPUT);
+    assert(drafter_serialize_chunked(NULL, serializeOptions, write_output, &out) == DRAFTER_EINVALID_INPUT);
+
+    drafter_free_result(result);
+    free(expected_out);
+    free(out.data);
+
+    return 0;
+}
+
+typedef struct {
+    size_t allocated;
+    size_t released;
+} allocation_counter;
+
+void* counted_allocate(size_t size, void* ctx) {
+    ((allocation_counter*)ctx)->allocated++;
+    return malloc(size);
+}
+
+void* counted_reallocate(void* ptr, size_t size, void* ctx) {
+    return realloc(ptr, size);
+}
+
+void counted_deallocate(void* ptr, void* ctx) {
+    ((allocation_counter*)ctx)->released++;
+    free(ptr);
+}
+
+int test_allocator() {
+    allocation_counter counter = { 0, 0 };
+    drafter_allocator allocator = { counted_allocate, counted_reallocate, counted_deallocate, &counter };
+
+    drafter_parse_options parseOptions = {false};
+    parseOptions.allocator = &allocator;
+
+    drafter_result* result = NULL;
+
+    int status = drafter_parse_blueprint(source, &result, parseOptions);
+    assert(status == 0);
+    assert(result);
+    assert(counter.allocated > 0);
+
+    drafter_serialize_options serializeOptions;
+    serializeOptions.sourcemap = false;
+    serializeOptions.format = DRAFTER_SERIALIZE_YAML;
+
+    size_t elements = counter.allocated;
+
+    /* serialized output belongs to the allocator of the result */
+    char* out = drafter_serialize(result, serializeOptions);
+    assert(out);
+    assert(counter.allocated > elements);
+
+    size_t released = counter.released;
+
+    /* released by the deallocate of the allocator */
+    counted_deallocate(out, &counter);
+    assert(counter.released == released + 1);
+
+    drafter_free_result(result);
+
+    /* released by the allocator they were allocated by */
+    assert(counter.released > released + 1);
+
+    return 0;
+}
+
+int test_limits() {
+    drafter_parse_options parseOptions = {false};
+    drafter_result* result = NULL;
+
+    parseOptions.limits.elements = 10;
+
+    int status = drafter_parse_blueprint(source, &result, parseOptions);
+    assert(status == 5);
+    assert(result);
+
+    drafter_serialize_options options;
+    options.sourcemap = false;
+    options.format = DRAFTER_SERIALIZE_YAML;
+
+    char* out = drafter_serialize(result, options);
+    assert(out);
+
+    /* the conversion has been stopped by the limit */
+    assert(strstr(out, "exceeded the limit of 10 elements") != 0);
+
+    drafter_free_result(result);
+    free(out);
+    return 0;
+}
+
+int test_cancel() {
+    drafter_parse_options parseOptions = {false};
+    drafter_result* result = NULL;
+
+    parseOptions.cancel = drafter_new_cancel_token();
+    assert(parseOptions.cancel);
+
+    drafter_cancel(parseOptions.cancel);
+
+    int status = drafter_parse_blueprint(source, &result, parseOptions);
+    assert(status == 6);
+    assert(result);
+    drafter_free_result(result);
+
+    drafter_reset_cancel_token(parseOptions.cancel);
+
+    status = drafter_parse_blueprint(source, &result, parseOptions);
+    assert(status == 0);
+    drafter_free_result(result);
+
+    drafter_free_cancel_token(parseOptions.cancel);
+    return 0;
+}
+
+typedef struct {
+    int calls;
+    drafter_parse_stage stage;
+    unsigned int percent;
+} progress_state;
+
+void record_progress(drafter_parse_stage stage, unsigned int percent, void* ctx) {
+    progress_state* state = (progress_state*)ctx;
+    state->calls++;
+    state->stage = stage;
+    state->percent = percent;
+}
+
+int test_progress() {
+    progress_state state = { 0, DRAFTER_STAGE_PARSING, 0 };
+    drafter_parse_options parseOptions = {false};
+    drafter_result* result = NULL;
+
+    parseOptions.progress = record_progress;
+    parseOptions.progress_ctx = &state;
+
+    int status = drafter_parse_blueprint(source, &result, parseOptions);
+    assert(status == 0);
+
+    /* conversion of all top-level sections is reported last */
+    assert(state.calls > 1);
+    assert(state.stage == DRAFTER_STAGE_CONVERSION);
+    assert(state.percent == 100);
+
+    drafter_free_result(result);
+    return 0;
+}
+
 int test_version() {
     assert(drafter_version() != 0);
     assert(strcmp(drafter_version_string(), DRAFTER_VERSION_STRING) == 0);
@@ -97,6 +292,11 @@ int test_validation() {
 int main() {
     assert(test_parse_and_serialize() == 0);
     assert(test_parse_to_string() == 0);
+    assert(test_serialize_chunked() == 0);
+    assert(test_allocator() == 0);
+    assert(test_limits() == 0);
+    assert(test_cancel() == 0);
+    assert(test_progress() == 0);
     assert(test_version() == 0);
     assert(test_validation() == 0);
     return 0;
@@ -18,7 +18,7 @@ TEST_CASE("Create empty primitive element", "[ElementFactory]")
     REQUIRE(str->empty());
     REQUIRE(str->meta.empty());
     REQUIRE(str->attributes.empty());
-    REQUIRE(str->element() == StringElement::TraitType::element());
+    REQUIRE(str->element() == StringElement::TraitType::element().str());
 
     delete e;
 }
@@ -80,7 +80,7 @@ TEST_CASE("Create empty complex element", "[ElementFactory]")
     REQUIRE(enm->empty());
     REQUIRE(enm->meta.empty());
     REQUIRE(enm->attributes.empty());
-    REQUIRE(enm->element() == EnumElement::TraitType::element());
+    REQUIRE(enm->element() == EnumElement::TraitType::element().str());
 
     delete e;
 }
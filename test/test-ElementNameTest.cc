@@ -0,0 +1,127 @@
+#include "catch.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Element.h"
+#include "ElementName.h"
+
+using namespace refract;
+
+TEST_CASE("Equal element names are interned once", "[refract][ElementName]")
+{
+    ElementName name("ElementNameTest");
+    ElementName same(std::string("ElementName") + "Test");
+
+    REQUIRE(name == same);
+    REQUIRE(&name.str() == &same.str());
+    REQUIRE(name != ElementName("ElementNameTest2"));
+    REQUIRE(name.str() == "ElementNameTest");
+    REQUIRE_FALSE(name.reserved());
+}
+
+TEST_CASE("Base element names are reserved in advance", "[refract][ElementName]")
+{
+    REQUIRE(names::Object == ElementName("object"));
+    REQUIRE(names::Object.reserved());
+    REQUIRE(names::Generic.reserved());
+
+    REQUIRE(isReserved("ref"));
+    REQUIRE_FALSE(isReserved("annotation"));
+    REQUIRE_FALSE(isReserved(""));
+
+    REQUIRE(ElementName().empty());
+    REQUIRE(ElementName::Find("ElementNameTest never interned").empty());
+}
+
+TEST_CASE("Element name defaults to its base element", "[refract][ElementName]")
+{
+    std::unique_ptr<ObjectElement> object(new ObjectElement);
+
+    REQUIRE(object->name() == names::Object);
+    REQUIRE(object->element() == "object");
+
+    object->element("User");
+    REQUIRE(object->name() == ElementName("User"));
+    REQUIRE_FALSE(isReserved(object->name()));
+
+    std::unique_ptr<IElement> clone(object->clone());
+    REQUIRE(clone->name() == object->name());
+
+    clone->element(names::Array);
+    REQUIRE(clone->element() == "array");
+}
+
+TEST_CASE("Element names are interned concurrently", "[refract][ElementName]")
+{
+    const size_t count = 4;
+    std::vector<std::vector<ElementName> > interned(count);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < count; ++i) {
+        threads.push_back(std::thread([i, &interned]() {
+            for (int n = 0; n < 1000; ++n) {
+                interned[i].push_back(ElementName("ElementNameTest" + std::to_string(n)));
+            }
+        }));
+    }
+
+    for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it) {
+        it->join();
+    }
+
+    for (size_t i = 1; i < count; ++i) {
+        REQUIRE(interned[i] == interned[0]);
+    }
+}
+
+TEST_CASE("Element names are released with the last reference", "[refract][ElementName]")
+{
+    {
+        ElementName name("ElementNameTest released");
+        ElementName copy = name;
+
+        REQUIRE(ElementName::Find("ElementNameTest released") == name);
+    }
+
+    REQUIRE(ElementName::Find("ElementNameTest released").empty());
+
+    {
+        std::unique_ptr<StringElement> element(new StringElement);
+        element->element("ElementNameTest released");
+
+        std::unique_ptr<IElement> clone(element->clone());
+        element.reset();
+
+        REQUIRE(ElementName::Find("ElementNameTest released") == clone->name());
+    }
+
+    REQUIRE(ElementName::Find("ElementNameTest released").empty());
+    REQUIRE(ElementName::Find("object") == names::Object);
+}
+
+TEST_CASE("Element names are released concurrently", "[refract][ElementName]")
+{
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < 4; ++i) {
+        threads.push_back(std::thread([]() {
+            for (int n = 0; n < 1000; ++n) {
+                ElementName name("ElementNameTest" + std::to_string(n % 10));
+                ElementName copy = name;
+
+                if (copy != ElementName::Find(name.str())) {
+                    throw std::logic_error("released name in use");
+                }
+            }
+        }));
+    }
+
+    for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it) {
+        it->join();
+    }
+
+    REQUIRE(ElementName::Find("ElementNameTest0").empty());
+}
@@ -0,0 +1,181 @@
+#include "draftertest.h"
+
+#include "drafter.h"
+
+#include <cstdlib>
+#include <random>
+
+using namespace draftertest;
+
+namespace
+{
+    const drafter_parse_options parseOptions = { false, false, NULL, { 0, 0, 0, 0 }, NULL, NULL, NULL };
+    const drafter_serialize_options serializeOptions = { true, DRAFTER_SERIALIZE_JSON };
+
+    std::string SerializeAndFree(drafter_result* result)
+    {
+        REQUIRE(result);
+
+        char* out = drafter_serialize(result, serializeOptions);
+        std::string serialized(out);
+
+        free(out);
+        drafter_free_result(result);
+
+        return serialized;
+    }
+
+    std::string Parse(const std::string& source, drafter_error& status)
+    {
+        drafter_result* result = nullptr;
+        status = drafter_parse_blueprint(source.c_str(), &result, parseOptions);
+
+        return SerializeAndFree(result);
+    }
+
+    void RequireSameAsFullParse(const std::string& source, drafter_result* result, drafter_error status)
+    {
+        drafter_error expectedStatus;
+        const std::string expected = Parse(source, expectedStatus);
+
+        INFO("Source:\n" << source);
+        REQUIRE(status == expectedStatus);
+        REQUIRE(SerializeAndFree(result) == expected);
+    }
+
+    /** Apply random edits to a fixture, comparing every incremental parse with full one */
+    void RandomEdits(const std::string& fixture, unsigned seed)
+    {
+        std::string source = ITFixtureFiles("test/fixtures/" + fixture).get(ext::apib);
+
+        drafter_incremental_parser* parser = drafter_new_incremental_parser(parseOptions);
+        REQUIRE(parser);
+
+        drafter_result* result = nullptr;
+        drafter_error status = drafter_incremental_parse(parser, source.c_str(), &result);
+        RequireSameAsFullParse(source, result, status);
+
+        const std::string fragments[] = { "a",
+            " ",
+            "\n",
+            "\n\n",
+            "# Group B\n",
+            "# Data Structures\n",
+            "## C (object)\n",
+            "+ id: 42\n",
+            "## Note [/notes/{id}]\n",
+            "(string)" };
+        const size_t fragmentsCount = sizeof(fragments) / sizeof(fragments[0]);
+
+        std::mt19937 random(seed);
+
+        for (int i = 0; i < 50; ++i) {
+            const size_t offset = random() % (source.size() + 1);
+            const size_t length = std::min<size_t>(random() % 4, source.size() - offset);
+            const std::string& replacement = fragments[random() % fragmentsCount];
+
+            source.replace(offset, length, replacement);
+
+            result = nullptr;
+            status = drafter_incremental_edit(parser, offset, length, replacement.c_str(), &result);
+            RequireSameAsFullParse(source, result, status);
+        }
+
+        drafter_free_incremental_parser(parser);
+    }
+}
+
+TEST_CASE("Incremental parse is the same as full parse", "[incremental]")
+{
+    drafter_incremental_parser* parser = drafter_new_incremental_parser(parseOptions);
+    REQUIRE(parser);
+
+    const std::string fixtures[]
+        = { "api/resource-group", "api/data-structure", "api/attributes-references", "api/resource-attributes" };
+
+    for (size_t i = 0; i < sizeof(fixtures) / sizeof(fixtures[0]); ++i) {
+        const std::string source = ITFixtureFiles("test/fixtures/" + fixtures[i]).get(ext::apib);
+
+        drafter_result* result = nullptr;
+        drafter_error status = drafter_incremental_parse(parser, source.c_str(), &result);
+        RequireSameAsFullParse(source, result, status);
+    }
+
+    drafter_free_incremental_parser(parser);
+}
+
+TEST_CASE("Edit shifts source maps of following groups", "[incremental]")
+{
+    std::string source
+        = "# API\n\n"
+          "# Group A\n\n"
+          "## Resource [/a]\n\n"
+          "### Retrieve [GET]\n\n"
+          "+ Response 200\n\n"
+          "    + Attributes (B)\n\n"
+          "# Group C\n\n"
+          "## Resource [/c]\n\n"
+          "+ Attributes\n"
+          "    + id: 1 (number)\n\n"
+          "### Retrieve [GET]\n\n"
+          "+ Response 200\n\n"
+          "# Data Structures\n\n"
+          "## B (object)\n\n"
+          "+ name: b\n";
+
+    drafter_incremental_parser* parser = drafter_new_incremental_parser(parseOptions);
+    REQUIRE(parser);
+
+    drafter_result* result = nullptr;
+    drafter_error status = drafter_incremental_parse(parser, source.c_str(), &result);
+    RequireSameAsFullParse(source, result, status);
+
+    // grows the first group, the rest of the document only moves
+    const size_t offset = source.find("## Resource [/a]");
+    const std::string replacement = "Description of group A.\n\n";
+
+    source.insert(offset, replacement);
+
+    result = nullptr;
+    status = drafter_incremental_edit(parser, offset, 0, replacement.c_str(), &result);
+    RequireSameAsFullParse(source, result, status);
+
+    // changes the named type
+    const size_t name = source.find("name: b");
+
+    source.replace(name, 7, "title: b");
+
+    result = nullptr;
+    status = drafter_incremental_edit(parser, name, 7, "title: b", &result);
+    RequireSameAsFullParse(source, result, status);
+
+    drafter_free_incremental_parser(parser);
+}
+
+TEST_CASE("Random edits of incrementally parsed blueprint", "[incremental]")
+{
+    RandomEdits("api/resource-group", 1);
+    RandomEdits("api/data-structure", 2);
+    RandomEdits("api/attributes-references", 3);
+    RandomEdits("api/resource-attributes", 4);
+}
+
+TEST_CASE("Edit out of parsed blueprint is invalid input", "[incremental]")
+{
+    drafter_incremental_parser* parser = drafter_new_incremental_parser(parseOptions);
+    REQUIRE(parser);
+
+    drafter_result* result = nullptr;
+    REQUIRE(drafter_incremental_parse(parser, "# API\n", &result) == DRAFTER_OK);
+    drafter_free_result(result);
+
+    result = nullptr;
+    REQUIRE(drafter_incremental_edit(parser, 4, 3, "", &result) == DRAFTER_EINVALID_INPUT);
+    REQUIRE(drafter_incremental_edit(parser, 7, 0, "", &result) == DRAFTER_EINVALID_INPUT);
+    REQUIRE(result == nullptr);
+
+    REQUIRE(drafter_incremental_edit(parser, 6, 0, "Description\n", &result) == DRAFTER_OK);
+    drafter_free_result(result);
+
+    drafter_free_incremental_parser(parser);
+}
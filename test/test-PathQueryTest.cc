@@ -0,0 +1,178 @@
+#include "catch.hpp"
+
+#include <memory>
+
+#include "Element.h"
+#include "Exception.h"
+#include "PathQuery.h"
+
+using namespace refract;
+
+namespace
+{
+    IElement* Transaction(const std::string& method)
+    {
+        ArrayElement* transaction = new ArrayElement;
+        transaction->element("httpTransaction");
+
+        ObjectElement* request = new ObjectElement;
+        request->element("httpRequest");
+        request->attributes["method"] = IElement::Create(method);
+        transaction->push_back(request);
+
+        return transaction;
+    }
+
+    IElement* Annotation(const std::string& kind, const std::string& text)
+    {
+        StringElement* annotation = new StringElement(text);
+        annotation->element("annotation");
+
+        ArrayElement* classes = new ArrayElement;
+        classes->push_back(IElement::Create(kind));
+        annotation->meta["classes"] = classes;
+
+        return annotation;
+    }
+
+    /// parseResult > category > resource > transition > httpTransaction, data structure and annotations
+    IElement* ParseResult()
+    {
+        ArrayElement* transition = new ArrayElement;
+        transition->element("transition");
+        transition->push_back(Transaction("GET"));
+        transition->push_back(Transaction("POST"));
+
+        ArrayElement* resource = new ArrayElement;
+        resource->element("resource");
+        resource->attributes["href"] = IElement::Create("/notes");
+        resource->push_back(transition);
+
+        ObjectElement* user = new ObjectElement;
+        user->meta["id"] = IElement::Create("User");
+        user->push_back(new MemberElement("name", IElement::Create("Anna")));
+
+        HolderElement* dataStructure = new HolderElement;
+        dataStructure->element("dataStructure");
+        dataStructure->set(user);
+
+        ArrayElement* category = new ArrayElement;
+        category->element("category");
+        category->push_back(resource);
+        category->push_back(dataStructure);
+
+        ArrayElement* parseResult = new ArrayElement;
+        parseResult->element("parseResult");
+        parseResult->push_back(category);
+        parseResult->push_back(Annotation("warning", "first"));
+        parseResult->push_back(Annotation("error", "second"));
+
+        return parseResult;
+    }
+
+    std::string Method(const IElement* transaction)
+    {
+        const ArrayElement* array = static_cast<const ArrayElement*>(transaction);
+        const IElement* method = (*array->value.front()->attributes.find("method"))->value.second;
+        return static_cast<const StringElement*>(method)->value;
+    }
+}
+
+TEST_CASE("Path matches children of root", "[PathQuery]")
+{
+    std::unique_ptr<IElement> result(ParseResult());
+
+    REQUIRE(query::Path("annotation").select(*result).size() == 2);
+    REQUIRE(query::Path("/category").select(*result).size() == 1);
+    REQUIRE(query::Path("resource").select(*result).empty());
+    REQUIRE(query::Path("category/resource/transition/httpTransaction").select(*result).size() == 2);
+}
+
+TEST_CASE("Path matches descendants in document order", "[PathQuery]")
+{
+    std::unique_ptr<IElement> result(ParseResult());
+
+    query::Elements transactions = query::Path("//httpTransaction").select(*result);
+
+    REQUIRE(transactions.size() == 2);
+    REQUIRE(Method(transactions[0]) == "GET");
+    REQUIRE(Method(transactions[1]) == "POST");
+
+    REQUIRE(query::Path("category//httpRequest").select(*result).size() == 2);
+    REQUIRE(query::Path("//*").select(*result).size() == 14);
+}
+
+TEST_CASE("Path predicates match meta and attributes", "[PathQuery]")
+{
+    std::unique_ptr<IElement> result(ParseResult());
+
+    query::Elements warnings = query::Path("annotation[class=warning]").select(*result);
+    REQUIRE(warnings.size() == 1);
+    REQUIRE(static_cast<const StringElement*>(warnings.front())->value == "first");
+
+    REQUIRE(query::Path("//*[id=User]").select(*result).size() == 1);
+    REQUIRE(query::Path("//*[id='Nobody']").select(*result).empty());
+    REQUIRE(query::Path("//resource[@href]").select(*result).size() == 1);
+    REQUIRE(query::Path("//resource[@href=\"/notes\"]").select(*result).size() == 1);
+    REQUIRE(query::Path("//httpRequest[@method=POST]").select(*result).size() == 1);
+    REQUIRE(query::Path("//resource[@title]").select(*result).empty());
+}
+
+TEST_CASE("Descendant steps do not repeat elements", "[PathQuery]")
+{
+    std::unique_ptr<IElement> result(ParseResult());
+
+    REQUIRE(query::Path("//*//httpRequest").select(*result).size() == 2);
+}
+
+TEST_CASE("Indexed lookup gives the same results", "[PathQuery]")
+{
+    std::unique_ptr<IElement> result(ParseResult());
+    query::Index index(*result);
+
+    const char* paths[] = { "annotation",
+        "//httpTransaction",
+        "//httpTransaction/httpRequest[@method=GET]",
+        "//*[id=User]",
+        "//*",
+        "//dataStructure//member" };
+
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i) {
+        INFO(paths[i]);
+        query::Path path(paths[i]);
+        REQUIRE(path.select(index) == path.select(*result));
+    }
+
+    REQUIRE(index.byName("httpTransaction").size() == 2);
+    REQUIRE(index.byName("nothing").empty());
+    REQUIRE(index.byId("User").size() == 1);
+    REQUIRE(index.byId("Nobody").empty());
+}
+
+TEST_CASE("Indexed lookup gives every element of a repeated id", "[PathQuery]")
+{
+    ArrayElement root;
+
+    for (size_t i = 0; i < 3; ++i) {
+        StringElement* element = new StringElement("duplicate");
+        element->meta["id"] = IElement::Create("Same");
+        root.push_back(element);
+    }
+
+    query::Index index(root);
+    query::Path path("//*[id=Same]");
+
+    REQUIRE(index.byId("Same").size() == 3);
+    REQUIRE(path.select(index).size() == 3);
+    REQUIRE(path.select(index) == path.select(root));
+}
+
+TEST_CASE("Invalid path is rejected", "[PathQuery]")
+{
+    const char* invalid[] = { "", "/", "a//", "a[", "a[id]", "a[name=b]", "a[class='b]", "a b" };
+
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        INFO(invalid[i]);
+        REQUIRE_THROWS_AS(query::Path(invalid[i]), LogicError);
+    }
+}
@@ -1,5 +1,10 @@
 #include "draftertest.h"
 
+#include "drafter.h"
+
+#include <cstdlib>
+#include <sstream>
+
 using namespace draftertest;
 
 TEST_REFRACT("api", "description");
@@ -35,3 +40,70 @@ TEST_REFRACT("api", "attributes-named-type-mixin");
 TEST_REFRACT("api", "attributes-named-type-enum-reference");
 
 TEST_REFRACT("api", "mixin-inheritance");
+
+// parallel conversion has to give the same result as the serial one
+TEST_REFRACT_PARALLEL("api", "resource-group");
+TEST_REFRACT_PARALLEL("api", "data-structure");
+TEST_REFRACT_PARALLEL("api", "advanced-action");
+TEST_REFRACT_PARALLEL("api", "attributes-references");
+TEST_REFRACT_SOURCE_MAP_PARALLEL("api", "resource-group");
+TEST_REFRACT_SOURCE_MAP_PARALLEL("api", "mson");
+
+namespace
+{
+    /** Blueprint of a long chain of inheriting named types, used by many resources */
+    std::string InheritanceChain(int types, int resources)
+    {
+        std::stringstream source;
+        source << "# API\n\n";
+
+        for (int i = 0; i < resources; ++i) {
+            source << "## R" << i << " [/r" << i << "]\n\n"
+                   << "+ Attributes (T" << (types - 1 - i % types) << ")\n"
+                   << "    + own" << i << ": " << i << "\n\n"
+                   << "### Retrieve [GET]\n\n"
+                   << "+ Response 200 (application/json)\n\n"
+                   << "    + Attributes (T" << (i * 7 % types) << ")\n\n";
+        }
+
+        source << "# Data Structures\n\n"
+               << "## T0 (object)\n\n"
+               << "+ value0: 0 (number)\n\n";
+
+        for (int i = 1; i < types; ++i) {
+            source << "## T" << i << " (T" << (i - 1) << ")\n\n"
+                   << "+ value" << i << ": " << i << " (number)\n"
+                   << "+ Include T" << (i - 1) / 2 << "\n\n";
+        }
+
+        return source.str();
+    }
+
+    std::string ParseAndSerialize(const std::string& source, bool parallel)
+    {
+        drafter_parse_options parseOptions = { false, parallel, NULL, { 0, 0, 0, 0 }, NULL, NULL, NULL };
+        drafter_serialize_options serializeOptions = { true, DRAFTER_SERIALIZE_JSON };
+
+        drafter_result* result = nullptr;
+        drafter_parse_blueprint(source.c_str(), &result, parseOptions);
+        REQUIRE(result);
+
+        char* out = drafter_serialize(result, serializeOptions);
+        std::string serialized(out);
+
+        free(out);
+        drafter_free_result(result);
+
+        return serialized;
+    }
+}
+
+TEST_CASE("Parallel conversion of inheritance chain is the same as the serial one", "[refract_parallel]")
+{
+    const std::string source = InheritanceChain(40, 32);
+    const std::string serial = ParseAndSerialize(source, false);
+
+    for (int i = 0; i < 5; ++i) {
+        REQUIRE(ParseAndSerialize(source, true) == serial);
+    }
+}
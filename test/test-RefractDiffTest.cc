@@ -0,0 +1,120 @@
+#include "draftertest.h"
+
+#include "drafter.h"
+#include "refract/Element.h"
+#include "refract/TypeQueryVisitor.h"
+
+using namespace draftertest;
+
+namespace
+{
+    const drafter_parse_options parseOptions = { false, false, NULL, { 0, 0, 0, 0 }, NULL, NULL, NULL };
+
+    drafter_result* Parse(const std::string& source)
+    {
+        drafter_result* result = nullptr;
+        drafter_parse_blueprint(source.c_str(), &result, parseOptions);
+        REQUIRE(result);
+
+        return result;
+    }
+
+    /** Classes and paths of changes, e.g. "changed /users GET" */
+    std::vector<std::string> Changes(const std::string& base, const std::string& head)
+    {
+        drafter_result* baseResult = Parse(base);
+        drafter_result* headResult = Parse(head);
+        drafter_result* diff = nullptr;
+
+        REQUIRE(drafter_diff(baseResult, headResult, &diff) == DRAFTER_OK);
+        REQUIRE(diff);
+        REQUIRE(diff->element() == "diff");
+
+        std::vector<std::string> changes;
+
+        for (refract::IElement* e : refract::TypeQueryVisitor::as<refract::ArrayElement>(diff)->value) {
+            refract::ObjectElement* change = refract::TypeQueryVisitor::as<refract::ObjectElement>(e);
+            REQUIRE(change);
+
+            refract::ArrayElement* classes
+                = refract::TypeQueryVisitor::as<refract::ArrayElement>((*change->meta.find("classes"))->value.second);
+            std::string description
+                = refract::TypeQueryVisitor::as<refract::StringElement>(classes->value.front())->value;
+
+            refract::MemberElement* path = refract::TypeQueryVisitor::as<refract::MemberElement>(change->value.front());
+            refract::ArrayElement* segments = refract::TypeQueryVisitor::as<refract::ArrayElement>(path->value.second);
+
+            for (refract::IElement* segment : segments->value) {
+                description += " " + refract::TypeQueryVisitor::as<refract::StringElement>(segment)->value;
+            }
+
+            changes.push_back(description);
+        }
+
+        drafter_free_result(diff);
+        drafter_free_result(headResult);
+        drafter_free_result(baseResult);
+
+        return changes;
+    }
+
+    const std::string Base
+        = "# API\n\n"
+          "# Group Users\n\n"
+          "## Users [/users]\n\n"
+          "### List [GET]\n\n"
+          "+ Response 200 (application/json)\n\n"
+          "    + Attributes (array[User])\n\n"
+          "### Create [POST]\n\n"
+          "+ Response 201\n\n"
+          "# Data Structures\n\n"
+          "## User (object)\n\n"
+          "+ id: 1 (number)\n";
+}
+
+TEST_CASE("Identical parse results have no difference", "[diff]")
+{
+    REQUIRE(Changes(Base, Base).empty());
+}
+
+TEST_CASE("Moved source maps are not a difference", "[diff]")
+{
+    REQUIRE(Changes(Base, "\n\n" + Base).empty());
+}
+
+TEST_CASE("Added and removed actions are matched by method", "[diff]")
+{
+    std::string head = Base;
+    head.replace(head.find("### Create [POST]"), 17, "### Delete [DELETE]");
+    head.replace(head.find("+ Response 201"), 14, "+ Response 204");
+
+    const std::vector<std::string> changes = Changes(Base, head);
+
+    REQUIRE(changes.size() == 2);
+    REQUIRE(changes[0] == "removed API Users /users POST");
+    REQUIRE(changes[1] == "added API Users /users DELETE");
+}
+
+TEST_CASE("Changed data structure is matched by name", "[diff]")
+{
+    std::string head = Base;
+    head.replace(head.find("+ id: 1 (number)"), 16, "+ id: 1 (string)");
+
+    const std::vector<std::string> changes = Changes(Base, head);
+
+    REQUIRE_FALSE(changes.empty());
+    REQUIRE(std::find(changes.begin(), changes.end(), "changed API dataStructures User") != changes.end());
+}
+
+TEST_CASE("Diff of NULL result is invalid input", "[diff]")
+{
+    drafter_result* result = Parse(Base);
+    drafter_result* diff = nullptr;
+
+    REQUIRE(drafter_diff(result, nullptr, &diff) == DRAFTER_EINVALID_INPUT);
+    REQUIRE(drafter_diff(nullptr, result, &diff) == DRAFTER_EINVALID_INPUT);
+    REQUIRE(drafter_diff(result, result, nullptr) == DRAFTER_EINVALID_OUTPUT);
+    REQUIRE(diff == nullptr);
+
+    drafter_free_result(result);
+}
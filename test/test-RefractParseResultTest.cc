@@ -18,4 +18,7 @@ TEST_REFRACT("parse-result", "blueprint");
 TEST_REFRACT("parse-result", "mson");
 
 TEST_REFRACT("mson", "type-attributes");
-TEST_REFRACT("mson", "type-attributes-payload");
\ No newline at end of file
+TEST_REFRACT("mson", "type-attributes-payload");
+TEST_REFRACT_PARALLEL("parse-result", "warnings");
+TEST_REFRACT_PARALLEL("parse-result", "error-warning");
+TEST_REFRACT_PARALLEL("parse-result", "blueprint");
@@ -0,0 +1,124 @@
+#include "catch.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Element.h"
+#include "Registry.h"
+
+using namespace refract;
+
+namespace
+{
+    IElement* NamedType(const std::string& id, const std::string& base)
+    {
+        ObjectElement* e = new ObjectElement;
+        e->element(base);
+        e->meta["id"] = IElement::Create(id);
+        return e;
+    }
+}
+
+TEST_CASE("Registry resolves root ancestor and depth", "[refract][Registry]")
+{
+    Registry registry;
+
+    IElement* a = NamedType("RegistryA", "object");
+    IElement* b = NamedType("RegistryB", "RegistryA");
+    IElement* c = NamedType("RegistryC", "RegistryB");
+
+    REQUIRE(registry.add(c));
+    REQUIRE(registry.add(b));
+
+    REQUIRE(registry.root("RegistryC") == b);
+    REQUIRE(registry.depth(ElementName("RegistryC")) == 1);
+
+    REQUIRE(registry.add(a));
+    REQUIRE_FALSE(registry.add(a));
+
+    REQUIRE(registry.find("RegistryB") == b);
+    REQUIRE(registry.root("RegistryC") == a);
+    REQUIRE(registry.root(ElementName("RegistryB")) == a);
+    REQUIRE(registry.depth(ElementName("RegistryC")) == 2);
+    REQUIRE(registry.depth(ElementName("RegistryA")) == 0);
+
+    REQUIRE(registry.remove("RegistryA"));
+    REQUIRE(registry.root("RegistryC") == b);
+    REQUIRE(registry.root("RegistryA") == NULL);
+    REQUIRE(registry.find("Registry never interned") == NULL);
+
+    delete a;
+    registry.clearAll(true);
+    REQUIRE(registry.find("RegistryB") == NULL);
+}
+
+TEST_CASE("Registry stops on recursive inheritance", "[refract][Registry]")
+{
+    Registry registry;
+
+    IElement* a = NamedType("RegistryCycleA", "RegistryCycleB");
+    IElement* b = NamedType("RegistryCycleB", "RegistryCycleA");
+    IElement* self = NamedType("RegistrySelf", "RegistrySelf");
+
+    REQUIRE(registry.add(a));
+    REQUIRE(registry.add(b));
+    REQUIRE(registry.add(self));
+
+    REQUIRE(registry.root("RegistryCycleA") == b);
+    REQUIRE(registry.depth(ElementName("RegistryCycleA")) == 1);
+    REQUIRE(registry.root("RegistrySelf") == self);
+    REQUIRE(registry.depth(ElementName("RegistrySelf")) == 0);
+
+    registry.clearAll(true);
+}
+
+TEST_CASE("Registry refuses base elements and elements without ID", "[refract][Registry]")
+{
+    Registry registry;
+
+    std::unique_ptr<IElement> base(NamedType("object", "object"));
+    std::unique_ptr<IElement> anonymous(new ObjectElement);
+
+    REQUIRE_THROWS_AS(registry.add(base.get()), LogicError);
+    REQUIRE_THROWS_AS(registry.add(anonymous.get()), LogicError);
+}
+
+TEST_CASE("Registry resolves ancestors looked up concurrently", "[refract][Registry]")
+{
+    Registry registry;
+
+    REQUIRE(registry.add(NamedType("RegistryConcurrent0", "object")));
+
+    for (int i = 1; i < 50; ++i) {
+        REQUIRE(registry.add(
+            NamedType("RegistryConcurrent" + std::to_string(i), "RegistryConcurrent" + std::to_string(i - 1))));
+    }
+
+    IElement* root = registry.find("RegistryConcurrent0");
+    std::vector<std::thread> threads;
+    std::atomic<int> mismatches(0);
+
+    for (int t = 0; t < 4; ++t) {
+        threads.push_back(std::thread([&registry, &mismatches, root, t]() {
+            for (int n = 0; n < 200; ++n) {
+                const int i = (n * 7 + t * 13) % 50;
+                const ElementName name("RegistryConcurrent" + std::to_string(i));
+
+                if (registry.root(name) != root || registry.depth(name) != static_cast<size_t>(i)) {
+                    ++mismatches;
+                }
+            }
+        }));
+    }
+
+    for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it) {
+        it->join();
+    }
+
+    REQUIRE(mismatches == 0);
+
+    registry.clearAll(true);
+}
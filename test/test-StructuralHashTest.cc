@@ -0,0 +1,121 @@
+#include "catch.hpp"
+
+#include <memory>
+
+#include "Element.h"
+#include "StructuralHash.h"
+
+using namespace refract;
+
+namespace
+{
+    ObjectElement* Person(const std::string& name, double age)
+    {
+        ObjectElement* person = new ObjectElement;
+        person->element("Person");
+        person->meta["id"] = IElement::Create("person");
+        person->push_back(new MemberElement("name", IElement::Create(name)));
+        person->push_back(new MemberElement("age", IElement::Create(age)));
+        return person;
+    }
+
+    void AddSourceMap(IElement& e, double offset)
+    {
+        ArrayElement* sourceMap = new ArrayElement;
+        sourceMap->push_back(IElement::Create(offset));
+        e.attributes["sourceMap"] = sourceMap;
+    }
+}
+
+TEST_CASE("Identical trees have the same hash and are equal", "[StructuralHash]")
+{
+    std::unique_ptr<IElement> first(Person("Anna", 42));
+    std::unique_ptr<IElement> second(Person("Anna", 42));
+
+    StructuralHash hash;
+
+    REQUIRE(hash(*first) == hash(*second));
+    REQUIRE(hash.equal(first.get(), second.get()));
+    REQUIRE(StructurallyEqual(*first, *second));
+}
+
+TEST_CASE("Trees differing in a nested value are not equal", "[StructuralHash]")
+{
+    std::unique_ptr<IElement> first(Person("Anna", 42));
+    std::unique_ptr<IElement> second(Person("Anna", 43));
+
+    REQUIRE_FALSE(StructurallyEqual(*first, *second));
+}
+
+TEST_CASE("Elements of different types are not equal", "[StructuralHash]")
+{
+    StringElement string("42");
+    RefElement ref("42");
+
+    REQUIRE_FALSE(StructurallyEqual(string, ref));
+
+    NumberElement number(1);
+    NumberElement named(1);
+    named.element("Count");
+
+    REQUIRE_FALSE(StructurallyEqual(number, named));
+
+    StringElement empty;
+    StringElement emptyValue("");
+
+    REQUIRE_FALSE(StructurallyEqual(empty, emptyValue));
+}
+
+TEST_CASE("Order of members matters", "[StructuralHash]")
+{
+    ObjectElement first;
+    first.push_back(new MemberElement("a", IElement::Create(1)));
+    first.push_back(new MemberElement("b", IElement::Create(2)));
+
+    ObjectElement second;
+    second.push_back(new MemberElement("b", IElement::Create(2)));
+    second.push_back(new MemberElement("a", IElement::Create(1)));
+
+    REQUIRE_FALSE(StructurallyEqual(first, second));
+}
+
+TEST_CASE("Source maps are ignored on request", "[StructuralHash]")
+{
+    std::unique_ptr<IElement> first(Person("Anna", 42));
+    std::unique_ptr<IElement> second(Person("Anna", 42));
+
+    AddSourceMap(*first, 10);
+    AddSourceMap(*second, 20);
+
+    REQUIRE_FALSE(StructurallyEqual(*first, *second));
+    REQUIRE(StructurallyEqual(*first, *second, true));
+
+    StructuralHash hash(true);
+    REQUIRE(hash(*first) == hash(*second));
+
+    // a source map on one side only
+    std::unique_ptr<IElement> third(Person("Anna", 42));
+    REQUIRE(StructurallyEqual(*first, *third, true));
+    REQUIRE(StructurallyEqual(*third, *first, true));
+}
+
+TEST_CASE("Hashes of subtrees are memoized", "[StructuralHash]")
+{
+    std::unique_ptr<ObjectElement> person(Person("Anna", 42));
+
+    StructuralHash hash;
+    const size_t before = hash(*person->value.front());
+
+    hash(*person);
+
+    REQUIRE(hash(*person->value.front()) == before);
+
+    // modified element keeps its memoized hash until cleared
+    MemberElement* name = static_cast<MemberElement*>(person->value.front());
+    *name = IElement::Create("Bob");
+
+    REQUIRE(hash(*name) == before);
+
+    hash.clear();
+    REQUIRE(hash(*name) != before);
+}
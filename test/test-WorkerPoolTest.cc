@@ -0,0 +1,88 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include "WorkerPool.h"
+
+using namespace drafter;
+
+namespace
+{
+    struct RecordTask {
+        std::vector<int>& calls;
+
+        RecordTask(std::vector<int>& calls) : calls(calls)
+        {
+        }
+
+        void operator()(size_t i) const
+        {
+            ++calls[i];
+        }
+    };
+
+    struct OrderTask {
+        std::vector<size_t>& order;
+
+        OrderTask(std::vector<size_t>& order) : order(order)
+        {
+        }
+
+        void operator()(size_t i) const
+        {
+            order.push_back(i);
+        }
+    };
+}
+
+TEST_CASE("Worker pool runs every task exactly once", "[WorkerPool]")
+{
+    WorkerPool pool(3);
+    REQUIRE(pool.size() == 3);
+
+    for (size_t count = 0; count < 50; count += 7) {
+        std::vector<int> calls(count, 0);
+        pool.run(count, RecordTask(calls));
+
+        REQUIRE(std::count(calls.begin(), calls.end(), 1) == static_cast<int>(count));
+    }
+}
+
+TEST_CASE("Worker pool without workers runs tasks in order", "[WorkerPool]")
+{
+    WorkerPool pool(0);
+    std::vector<size_t> order;
+
+    pool.run(5, OrderTask(order));
+
+    REQUIRE(order.size() == 5);
+    for (size_t i = 0; i < order.size(); ++i) {
+        REQUIRE(order[i] == i);
+    }
+}
+
+TEST_CASE("Workers are started only for independent tasks", "[WorkerPool]")
+{
+    REQUIRE(WorkerPool::WorkersFor(0) == 0);
+    REQUIRE(WorkerPool::WorkersFor(1) == 0);
+    REQUIRE(WorkerPool::WorkersFor(2) <= 1);
+}
+
+TEST_CASE("Workers of alive pools are not started again", "[WorkerPool]")
+{
+    const size_t hardware = std::thread::hardware_concurrency();
+    WorkerPool busy(hardware > 1 ? hardware - 1 : 0);
+
+    REQUIRE(WorkerPool::WorkersFor(100) == 0);
+}
+
+TEST_CASE("Worker pool runner runs every task exactly once", "[WorkerPool]")
+{
+    WorkerPoolRunner runner;
+    std::vector<int> calls(20, 0);
+
+    runner.run(calls.size(), RecordTask(calls));
+
+    REQUIRE(std::count(calls.begin(), calls.end(), 1) == static_cast<int>(calls.size()));
+}
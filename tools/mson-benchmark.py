@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+DESCRIPTION = """
+Measure expansion of named types by drafter on generated blueprints: a
+deep chain of inheriting types with nested members, and a type including
+many mixins. Times are printed for growing sizes, so super-linear growth
+shows as a growing time per type.
+"""
+
+
+def deep_inheritance(size):
+    lines = ['# API', '', '## Leaf [/leaf]', '',
+             '+ Attributes (Type%d)' % (size - 1), '',
+             '# Data Structures', '', '## Type0 (object)',
+             '+ value0 (object)', '    + nested: 0', '']
+    for i in range(1, size):
+        lines += ['## Type%d (Type%d)' % (i, i - 1),
+                  '+ value%d (object)' % i,
+                  '    + nested (Type0)', '']
+    return '\n'.join(lines)
+
+
+def wide_mixins(size):
+    lines = ['# API', '', '## Leaf [/leaf]', '', '+ Attributes (Wide)', '',
+             '# Data Structures', '']
+    for i in range(size):
+        lines += ['## Mixin%d (object)' % i,
+                  '+ field%d (object)' % i,
+                  '    + nested: %d' % i, '']
+    lines += ['## Wide (object)']
+    lines += ['+ Include Mixin%d' % i for i in range(size)]
+    lines += ['']
+    return '\n'.join(lines)
+
+
+def measure(drafter, label, blueprint, size, repeat):
+    handle, name = tempfile.mkstemp(suffix='.apib')
+    try:
+        with os.fdopen(handle, 'w') as source:
+            source.write(blueprint)
+
+        best = None
+        for _ in range(repeat):
+            with open(os.devnull, 'wb') as devnull:
+                start = time.time()
+                status = subprocess.call([drafter, name],
+                                         stdout=devnull, stderr=devnull)
+                elapsed = time.time() - start
+            best = elapsed if best is None else min(best, elapsed)
+    finally:
+        os.remove(name)
+
+    print('%-16s %6d types %8.3f s %8.3f ms/type  exit %d' %
+          (label, size, best, 1000 * best / size, status))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=DESCRIPTION)
+    parser.add_argument('--drafter', default='bin/drafter',
+                        help='path to drafter (default: bin/drafter)')
+    parser.add_argument('-s', '--sizes', default='50,100,200,400',
+                        help='comma separated numbers of types')
+    parser.add_argument('-n', '--repeat', type=int, default=3,
+                        help='best of this many runs (default: 3)')
+    args = parser.parse_args()
+
+    sizes = [int(size) for size in args.sizes.split(',')]
+
+    for size in sizes:
+        measure(args.drafter, 'deep inheritance', deep_inheritance(size),
+                size, args.repeat)
+
+    for size in sizes:
+        measure(args.drafter, 'wide mixins', wide_mixins(size),
+                size, args.repeat)
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
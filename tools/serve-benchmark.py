@@ -0,0 +1,100 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+import argparse
+import glob
+import os
+import subprocess
+import sys
+import threading
+import time
+
+DESCRIPTION = """
+Compare parsing blueprints by one drafter process per file with
+sending them to a single `drafter --serve` process.
+"""
+
+
+def read_response(stream):
+    header = stream.readline().split()
+    status, output, report = int(header[0]), int(header[1]), int(header[2])
+    stream.read(output + report)
+    return status
+
+
+def run_processes(drafter, files, options):
+    statuses = []
+    for name in files:
+        with open(os.devnull, 'wb') as devnull:
+            statuses.append(subprocess.call([drafter] + options + [name],
+                                            stdout=devnull, stderr=devnull))
+    return statuses
+
+
+def run_server(drafter, files, options, jobs):
+    server = subprocess.Popen([drafter, '--serve', '-j', str(jobs)] + options,
+                              stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+
+    def send():
+        for name in files:
+            with open(name, 'rb') as source:
+                blueprint = source.read()
+            server.stdin.write(('%d\n' % len(blueprint)).encode('ascii'))
+            server.stdin.write(blueprint)
+        server.stdin.close()
+
+    sender = threading.Thread(target=send)
+    sender.start()
+
+    statuses = [read_response(server.stdout) for _ in files]
+
+    sender.join()
+    server.wait()
+    return statuses
+
+
+def measure(label, function, *args):
+    start = time.time()
+    statuses = function(*args)
+    elapsed = time.time() - start
+    print('%-10s %8.3f s %8.2f ms/file' %
+          (label, elapsed, 1000 * elapsed / len(statuses)))
+    return statuses
+
+
+def main():
+    parser = argparse.ArgumentParser(description=DESCRIPTION)
+    parser.add_argument('files', nargs='+',
+                        help='blueprints or glob patterns of them')
+    parser.add_argument('--drafter', default='bin/drafter',
+                        help='path to drafter (default: bin/drafter)')
+    parser.add_argument('-j', '--jobs', type=int, default=0,
+                        help='workers of the server (default: cores)')
+    parser.add_argument('-n', '--repeat', type=int, default=1,
+                        help='send every file this many times')
+    parser.add_argument('-f', '--format', default='json',
+                        choices=['json', 'yaml'])
+    args = parser.parse_args()
+
+    files = []
+    for pattern in args.files:
+        files.extend(sorted(glob.glob(pattern)) or [pattern])
+    files = files * args.repeat
+
+    options = ['-f', args.format]
+
+    print('%d blueprints' % len(files))
+    processes = measure('processes', run_processes,
+                        args.drafter, files, options)
+    served = measure('serve', run_server,
+                     args.drafter, files, options, args.jobs)
+
+    if processes != served:
+        print('exit codes differ', file=sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())